@@ -0,0 +1,42 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <stdint.h>
+
+namespace Benchmark
+{
+    /// @brief Wall-clock stopwatch
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+        /// @brief Restart measurement
+        void reset() {
+            m_start = std::chrono::steady_clock::now();
+        }
+
+        /// @return nanoseconds elapsed since construction or last reset
+        double elapsed_ns() const {
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    /// @brief Prevent compiler from optimizing out computation of value
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+}
+
+#endif //BENCHMARK_HPP
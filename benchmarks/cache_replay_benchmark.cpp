@@ -0,0 +1,120 @@
+#include "benchmark.hpp"
+
+#include "cache.hpp"
+#include "lru_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <vector>
+
+/// Replays key trace against caches and reports hit ratio and time per access.
+///
+/// Usage: CacheReplayBenchmark [capacity] [trace_file]
+/// Trace file contains unsigned integer keys separated by whitespace. Without trace
+/// file synthetic trace is generated: skewed accesses to a hot set, periodically
+/// interrupted by a long sequential scan of never repeated keys.
+
+static std::vector<uint64_t> read_trace(const char* path)
+{
+    std::vector<uint64_t> trace;
+    std::ifstream file(path);
+    uint64_t key;
+    while (file >> key)
+        trace.push_back(key);
+    return trace;
+}
+
+static std::vector<uint64_t> generate_trace(size_t capacity)
+{
+    const size_t operations = 2000000;
+    const size_t scan_period = 200000;
+    const size_t scan_length = capacity * 2;
+    const size_t hot_set = capacity / 2 + 1;
+
+    std::vector<uint64_t> trace;
+    trace.reserve(operations + operations / scan_period * scan_length);
+
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    uint64_t scan_key = hot_set * 4;
+
+    for (size_t i = 0; i < operations; i++)
+    {
+        double skew = uniform(random);
+        trace.push_back(static_cast<uint64_t>(skew * skew * skew * hot_set * 2));
+
+        if (i % scan_period == scan_period - 1)
+        {
+            for (size_t j = 0; j < scan_length; j++)
+                trace.push_back(scan_key++);
+        }
+    }
+    return trace;
+}
+
+template<typename CacheType>
+static void replay(const char* name, CacheType& cache, const std::vector<uint64_t>& trace)
+{
+    size_t hits = 0;
+    Benchmark::Stopwatch stopwatch;
+    for (uint64_t key : trace)
+    {
+        auto value = cache.get(key);
+        if (value != nullptr)
+        {
+            hits++;
+            Benchmark::do_not_optimize(*value);
+        }
+        else
+        {
+            cache.put(key, key);
+        }
+    }
+    double elapsed = stopwatch.elapsed_ns();
+
+    std::printf("%-10s hit ratio %6.2f%%  %8.1f ns/op\n",
+                name, 100.0 * hits / trace.size(), elapsed / trace.size());
+}
+
+int main(int argc, char** argv)
+{
+    size_t capacity = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    if (capacity == 0)
+    {
+        std::fprintf(stderr, "Usage: %s [capacity] [trace_file]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<uint64_t> trace = (argc > 2) ? read_trace(argv[2]) : generate_trace(capacity);
+    if (trace.empty())
+    {
+        std::fprintf(stderr, "Trace is empty\n");
+        return 1;
+    }
+    std::printf("capacity %zu, trace length %zu\n", capacity, trace.size());
+
+    {
+        CppADS::LruCache<uint64_t, uint64_t> cache(capacity);
+        replay("LruCache", cache, trace);
+    }
+    {
+        CppADS::LruPolicyCache<uint64_t, uint64_t> cache(capacity);
+        replay("LRU", cache, trace);
+    }
+    {
+        CppADS::ClockCache<uint64_t, uint64_t> cache(capacity);
+        replay("CLOCK", cache, trace);
+    }
+    {
+        CppADS::TwoQueueCache<uint64_t, uint64_t> cache(capacity);
+        replay("2Q", cache, trace);
+    }
+    {
+        CppADS::ArcCache<uint64_t, uint64_t> cache(capacity);
+        replay("ARC", cache, trace);
+    }
+
+    return 0;
+}
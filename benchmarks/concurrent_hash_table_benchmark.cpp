@@ -0,0 +1,101 @@
+#include "benchmark.hpp"
+
+#include "concurrent_hash_table.hpp"
+#include "hash_table.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/// Mixed lookups and updates from 1 to 64 threads: ConcurrentHashTable against one
+/// HashTable guarded by a single shared mutex (readers share the lock, writers take it
+/// exclusively).
+///
+/// Usage: ConcurrentHashTableBenchmark [operations] [write_percent] [keys]
+
+/// HashTable guarded by one reader-writer lock with the same interface as ConcurrentHashTable
+class SharedMutexTable
+{
+public:
+    bool find(uint64_t key, uint64_t& value) const {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        const auto& table = m_table;
+        auto found = table.find(key);
+        if (found == table.cend())
+            return false;
+        value = found->second;
+        return true;
+    }
+
+    bool insert_or_assign(uint64_t key, uint64_t value) {
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        return m_table.insert_or_assign(key, value).second;
+    }
+
+private:
+    mutable std::shared_timed_mutex m_mutex;
+    CppADS::HashTable<uint64_t, uint64_t> m_table;
+};
+
+template<typename Table>
+static double run(size_t threads_count, size_t operations, unsigned write_percent, uint64_t keys)
+{
+    Table table;
+    for (uint64_t key = 0; key < keys; key++)
+        table.insert_or_assign(key, key);
+
+    std::vector<std::thread> threads;
+    size_t per_thread = operations / threads_count;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t t = 0; t < threads_count; t++)
+    {
+        threads.emplace_back([&table, per_thread, write_percent, keys, t]() {
+            std::mt19937_64 random(t + 1);
+            uint64_t sum = 0;
+            for (size_t i = 0; i < per_thread; i++)
+            {
+                uint64_t key = random() % keys;
+                if (random() % 100 < write_percent)
+                {
+                    table.insert_or_assign(key, i);
+                }
+                else
+                {
+                    uint64_t value = 0;
+                    table.find(key, value);
+                    sum += value;
+                }
+                // More threads than cores: give others a chance to run between bursts
+                if (i % 1024 == 0)
+                    std::this_thread::yield();
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    return per_thread * threads_count * 1e3 / stopwatch.elapsed_ns();
+}
+
+int main(int argc, char** argv)
+{
+    size_t operations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    unsigned write_percent = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 10;
+    uint64_t keys = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 100000;
+
+    std::printf("%zu operations on %llu keys, %u%% writes (Mops/s), %u hardware threads\n",
+                operations, static_cast<unsigned long long>(keys), write_percent, std::thread::hardware_concurrency());
+    std::printf("  %8s %20s %16s\n", "threads", "ConcurrentHashTable", "SharedMutex");
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        double sharded = run<CppADS::ConcurrentHashTable<uint64_t, uint64_t>>(threads, operations, write_percent, keys);
+        double locked = run<SharedMutexTable>(threads, operations, write_percent, keys);
+        std::printf("  %8zu %20.2f %16.2f\n", threads, sharded, locked);
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "benchmark.hpp"
+
+#include "concurrent_queue.hpp"
+#include "queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Bursty producers feeding consumers through ConcurrentQueue and through
+/// unbounded Queue guarded by one mutex.
+///
+/// Usage: ConcurrentQueueBenchmark [count] [burst]
+
+/// Unbounded Queue guarded by mutex with the same interface as ConcurrentQueue
+template<typename T>
+class MutexQueue
+{
+public:
+    class Producer
+    {
+    public:
+        explicit Producer(MutexQueue& queue) : m_queue(queue) {}
+
+        template<typename InputIt>
+        void enqueue_bulk(InputIt first, InputIt last) {
+            std::lock_guard<std::mutex> lock(m_queue.m_mutex);
+            m_queue.m_queue.enqueue_bulk(first, last);
+        }
+
+        void enqueue(const T& value) {
+            std::lock_guard<std::mutex> lock(m_queue.m_mutex);
+            m_queue.m_queue.enqueue(value);
+        }
+
+    private:
+        MutexQueue& m_queue;
+    };
+
+    Producer make_producer() {
+        return Producer(*this);
+    }
+
+    template<typename OutputIt>
+    size_t try_dequeue_bulk(OutputIt out, size_t count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.dequeue_bulk(out, count);
+    }
+
+private:
+    std::mutex m_mutex;
+    CppADS::Queue<T> m_queue;
+};
+
+template<typename Q>
+static double run(size_t producers, size_t consumers, size_t per_producer, size_t burst, bool bulk)
+{
+    Q queue;
+    std::atomic<size_t> remaining { producers * per_producer };
+    std::vector<std::thread> threads;
+    Benchmark::Stopwatch stopwatch;
+
+    for (size_t p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue, per_producer, burst, bulk]() {
+            auto producer = queue.make_producer();
+            std::vector<size_t> batch(burst);
+            for (size_t next = 0; next < per_producer; next += burst)
+            {
+                size_t size = std::min(burst, per_producer - next);
+                for (size_t i = 0; i < size; i++)
+                    batch[i] = next + i;
+                if (bulk)
+                {
+                    producer.enqueue_bulk(batch.begin(), batch.begin() + size);
+                }
+                else
+                {
+                    for (size_t i = 0; i < size; i++)
+                        producer.enqueue(batch[i]);
+                }
+                // Pause between bursts
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&queue, &remaining]() {
+            size_t batch[64];
+            size_t sum = 0;
+            while (remaining.load(std::memory_order_relaxed) != 0)
+            {
+                size_t popped = queue.try_dequeue_bulk(batch, 64);
+                if (popped == 0)
+                    std::this_thread::yield();
+                for (size_t i = 0; i < popped; i++)
+                    sum += batch[i];
+                remaining.fetch_sub(popped, std::memory_order_relaxed);
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+    return stopwatch.elapsed_ns();
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t burst = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+    for (bool bulk : {false, true})
+    {
+        std::printf("%zu values in bursts of %zu, %s enqueue (Mops/s)\n", count, burst, bulk ? "bulk" : "single");
+        std::printf("  %10s %10s %16s %12s\n", "producers", "consumers", "ConcurrentQueue", "MutexQueue");
+        for (size_t threads = 1; threads <= 8; threads *= 2)
+        {
+            size_t per_producer = count / threads;
+            double lock_free = run<CppADS::ConcurrentQueue<size_t>>(threads, threads, per_producer, burst, bulk);
+            double locked = run<MutexQueue<size_t>>(threads, threads, per_producer, burst, bulk);
+            size_t total = per_producer * threads;
+            std::printf("  %10zu %10zu %16.2f %12.2f\n", threads, threads, total * 1e3 / lock_free, total * 1e3 / locked);
+        }
+    }
+
+    return 0;
+}
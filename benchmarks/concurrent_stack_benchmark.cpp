@@ -0,0 +1,87 @@
+#include "benchmark.hpp"
+
+#include "concurrent_stack.hpp"
+#include "stack.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Contention on ConcurrentStack and on Stack guarded by mutex: every thread
+/// takes an object from a shared free list and puts it back.
+///
+/// Usage: ConcurrentStackBenchmark [operations_per_thread] [max_threads]
+
+/// Stack guarded by mutex with the same interface as ConcurrentStack
+template<typename T>
+class MutexStack
+{
+public:
+    void push(const T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stack.push(value);
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stack.size() == 0)
+            return false;
+        value = std::move(m_stack.top());
+        m_stack.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    CppADS::Stack<T> m_stack;
+};
+
+template<typename S>
+static double run(size_t threads_count, size_t operations)
+{
+    S stack;
+    for (size_t i = 0; i < 64 * threads_count; i++)
+        stack.push(i);
+
+    std::vector<std::thread> threads;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t t = 0; t < threads_count; t++)
+    {
+        threads.emplace_back([&stack, operations]() {
+            size_t value = 0;
+            size_t sum = 0;
+            for (size_t i = 0; i < operations; i++)
+            {
+                if (stack.try_pop(value))
+                {
+                    sum += value;
+                    stack.push(value);
+                }
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    return stopwatch.elapsed_ns();
+}
+
+int main(int argc, char** argv)
+{
+    size_t operations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 16;
+
+    std::printf("pop + push pairs, %zu per thread (Mpairs/s)\n", operations);
+    std::printf("  %8s %16s %12s\n", "threads", "ConcurrentStack", "MutexStack");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        double lock_free = run<CppADS::ConcurrentStack<size_t>>(threads, operations);
+        double locked = run<MutexStack<size_t>>(threads, operations);
+        size_t total = operations * threads;
+        std::printf("  %8zu %16.2f %12.2f\n", threads, total * 1e3 / lock_free, total * 1e3 / locked);
+    }
+
+    return 0;
+}
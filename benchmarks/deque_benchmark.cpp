@@ -0,0 +1,124 @@
+#include "benchmark.hpp"
+
+#include "deque.hpp"
+#include "list.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+/// Compares block-based Deque with List (former Deque backend) and std::deque.
+///
+/// Usage: DequeBenchmark [count]
+
+template<typename Container>
+static void bench_push_back_pop_front(const char* name, size_t count)
+{
+    Container container;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < count; i++)
+        container.push_back(static_cast<int>(i));
+    while (container.size() != 0)
+    {
+        Benchmark::do_not_optimize(container.front());
+        container.pop_front();
+    }
+    std::printf("  %-12s %8.2f ns/op\n", name, stopwatch.elapsed_ns() / (2 * count));
+}
+
+template<typename Container>
+static void bench_push_front_pop_back(const char* name, size_t count)
+{
+    Container container;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < count; i++)
+        container.push_front(static_cast<int>(i));
+    while (container.size() != 0)
+    {
+        Benchmark::do_not_optimize(container.back());
+        container.pop_back();
+    }
+    std::printf("  %-12s %8.2f ns/op\n", name, stopwatch.elapsed_ns() / (2 * count));
+}
+
+template<typename Container>
+static void bench_fifo_churn(const char* name, size_t count)
+{
+    Container container;
+    for (int i = 0; i < 1024; i++)
+        container.push_back(i);
+
+    Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < count; i++)
+    {
+        container.push_back(static_cast<int>(i));
+        container.pop_front();
+    }
+    Benchmark::do_not_optimize(container.front());
+    std::printf("  %-12s %8.2f ns/op\n", name, stopwatch.elapsed_ns() / count);
+}
+
+template<typename Container>
+static void bench_iterate(const char* name, size_t count)
+{
+    Container container;
+    for (size_t i = 0; i < count; i++)
+        container.push_back(static_cast<int>(i));
+
+    Benchmark::Stopwatch stopwatch;
+    long long sum = 0;
+    for (auto it = container.begin(); it != container.end(); ++it)
+        sum += *it;
+    Benchmark::do_not_optimize(sum);
+    std::printf("  %-12s %8.2f ns/op\n", name, stopwatch.elapsed_ns() / count);
+}
+
+template<typename Container>
+static void bench_random_access(const char* name, size_t count)
+{
+    Container container;
+    for (size_t i = 0; i < count; i++)
+        container.push_back(static_cast<int>(i));
+
+    Benchmark::Stopwatch stopwatch;
+    long long sum = 0;
+    size_t index = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        index = (index + 7919) % count;
+        sum += container[index];
+    }
+    Benchmark::do_not_optimize(sum);
+    std::printf("  %-12s %8.2f ns/op\n", name, stopwatch.elapsed_ns() / count);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    std::printf("push_back + pop_front, %zu elements\n", count);
+    bench_push_back_pop_front<CppADS::Deque<int>>("Deque", count);
+    bench_push_back_pop_front<CppADS::List<int>>("List", count);
+    bench_push_back_pop_front<std::deque<int>>("std::deque", count);
+
+    std::printf("push_front + pop_back, %zu elements\n", count);
+    bench_push_front_pop_back<CppADS::Deque<int>>("Deque", count);
+    bench_push_front_pop_back<CppADS::List<int>>("List", count);
+    bench_push_front_pop_back<std::deque<int>>("std::deque", count);
+
+    std::printf("FIFO churn of 1024 elements, %zu operations\n", count);
+    bench_fifo_churn<CppADS::Deque<int>>("Deque", count);
+    bench_fifo_churn<CppADS::List<int>>("List", count);
+    bench_fifo_churn<std::deque<int>>("std::deque", count);
+
+    std::printf("iteration, %zu elements\n", count);
+    bench_iterate<CppADS::Deque<int>>("Deque", count);
+    bench_iterate<CppADS::List<int>>("List", count);
+    bench_iterate<std::deque<int>>("std::deque", count);
+
+    std::printf("random access, %zu elements (List::operator[] is O(n), skipped)\n", count);
+    bench_random_access<CppADS::Deque<int>>("Deque", count);
+    bench_random_access<std::deque<int>>("std::deque", count);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "benchmark.hpp"
+
+#include "indexed_heap.hpp"
+#include "pairing_heap.hpp"
+#include "priority_queue.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// Dijkstra's shortest paths on a random graph with addressable heaps (decrease_key)
+/// and with PriorityQueue which pushes duplicates and skips outdated entries.
+///
+/// Usage: DijkstraBenchmark [vertices] [edges]
+
+using Distance = uint64_t;
+using Item = std::pair<Distance, uint32_t>;
+static const Distance Infinity = std::numeric_limits<Distance>::max();
+
+/// Graph in compressed sparse row form
+struct Graph
+{
+    std::vector<size_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint32_t> weights;
+};
+
+static Graph make_graph(size_t vertices, size_t edges)
+{
+    std::mt19937_64 random(1);
+    std::vector<size_t> degrees(vertices, 0);
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(edges);
+    for (size_t i = 0; i < edges; i++)
+    {
+        // A ring keeps every vertex reachable
+        uint32_t from = static_cast<uint32_t>(i < vertices ? i : random() % vertices);
+        uint32_t to = static_cast<uint32_t>(i < vertices ? (i + 1) % vertices : random() % vertices);
+        pairs[i] = std::make_pair(from, to);
+        degrees[from]++;
+    }
+
+    Graph graph;
+    graph.offsets.assign(vertices + 1, 0);
+    for (size_t v = 0; v < vertices; v++)
+        graph.offsets[v + 1] = graph.offsets[v] + degrees[v];
+    graph.targets.resize(edges);
+    graph.weights.resize(edges);
+    std::vector<size_t> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto& pair : pairs)
+    {
+        size_t slot = fill[pair.first]++;
+        graph.targets[slot] = pair.second;
+        graph.weights[slot] = 1 + random() % 1000;
+    }
+    return graph;
+}
+
+static std::vector<Distance> lazy_dijkstra(const Graph& graph)
+{
+    std::vector<Distance> distance(graph.offsets.size() - 1, Infinity);
+    CppADS::PriorityQueue<Item, std::greater<Item>, 4> queue;
+    distance[0] = 0;
+    queue.push(Item(0, 0));
+    while (!queue.empty())
+    {
+        Item item = queue.top();
+        queue.pop();
+        if (item.first != distance[item.second])
+            continue;
+        for (size_t e = graph.offsets[item.second]; e < graph.offsets[item.second + 1]; e++)
+        {
+            Distance candidate = item.first + graph.weights[e];
+            if (candidate < distance[graph.targets[e]])
+            {
+                distance[graph.targets[e]] = candidate;
+                queue.push(Item(candidate, graph.targets[e]));
+            }
+        }
+    }
+    return distance;
+}
+
+template<typename Heap>
+static std::vector<Distance> addressable_dijkstra(const Graph& graph)
+{
+    size_t vertices = graph.offsets.size() - 1;
+    std::vector<Distance> distance(vertices, Infinity);
+    std::vector<typename Heap::handle_type> handles(vertices);
+    std::vector<bool> queued(vertices, false);
+    Heap heap;
+    distance[0] = 0;
+    handles[0] = heap.push(Item(0, 0));
+    queued[0] = true;
+    while (!heap.empty())
+    {
+        Item item = heap.top();
+        heap.pop();
+        queued[item.second] = false;
+        for (size_t e = graph.offsets[item.second]; e < graph.offsets[item.second + 1]; e++)
+        {
+            uint32_t target = graph.targets[e];
+            Distance candidate = item.first + graph.weights[e];
+            if (candidate >= distance[target])
+                continue;
+            distance[target] = candidate;
+            if (queued[target])
+            {
+                heap.decrease_key(handles[target], Item(candidate, target));
+            }
+            else
+            {
+                handles[target] = heap.push(Item(candidate, target));
+                queued[target] = true;
+            }
+        }
+    }
+    return distance;
+}
+
+template<typename Function>
+static void run(const char* name, Function function, const std::vector<Distance>& expected)
+{
+    Benchmark::Stopwatch stopwatch;
+    std::vector<Distance> distance = function();
+    double elapsed = stopwatch.elapsed_ns();
+    std::printf("  %-28s %10.1f ms %s\n", name, elapsed / 1e6, distance == expected ? "" : "(WRONG RESULT)");
+}
+
+int main(int argc, char** argv)
+{
+    size_t vertices = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t edges = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+    if (edges < vertices)
+        edges = vertices;
+
+    Graph graph = make_graph(vertices, edges);
+    std::vector<Distance> expected = lazy_dijkstra(graph);
+
+    std::printf("Dijkstra, %zu vertices, %zu edges\n", vertices, edges);
+    run("PriorityQueue<4> (lazy)", [&graph]() { return lazy_dijkstra(graph); }, expected);
+    run("IndexedHeap<2>", [&graph]() {
+        return addressable_dijkstra<CppADS::IndexedHeap<Item>>(graph);
+    }, expected);
+    run("IndexedHeap<4>", [&graph]() {
+        return addressable_dijkstra<CppADS::IndexedHeap<Item, std::less<Item>, 4>>(graph);
+    }, expected);
+    run("PairingHeap", [&graph]() {
+        return addressable_dijkstra<CppADS::PairingHeap<Item>>(graph);
+    }, expected);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "benchmark.hpp"
+
+#include "flat_hash_map.hpp"
+#include "hash_table.hpp"
+#include "robin_hood_hash_table.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Large map with string keys: FlatHashMap against RobinHoodHashTable and the chained
+/// HashTable. Every lookup is timed separately to report tail latency of hits and misses,
+/// misses share long prefixes with the stored keys.
+///
+/// Usage: FlatHashMapBenchmark [keys]
+
+struct Result
+{
+    double insert;
+    double hit_mean;
+    double hit_p99;
+    double miss_mean;
+    double miss_p99;
+};
+
+static void percentiles(std::vector<uint64_t>& samples, double& mean, double& p99)
+{
+    uint64_t total = 0;
+    for (uint64_t sample : samples)
+        total += sample;
+    mean = static_cast<double>(total) / samples.size();
+    size_t rank = samples.size() * 99 / 100;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    p99 = static_cast<double>(samples[rank]);
+}
+
+template<typename Table>
+static Result run(const std::vector<std::string>& keys, const std::vector<std::string>& missing, const std::vector<size_t>& order)
+{
+    Result result;
+    Table table;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < keys.size(); i++)
+        table.insert({keys[i], i});
+    result.insert = stopwatch.elapsed_ns() / keys.size();
+
+    std::vector<uint64_t> samples(order.size());
+    size_t sum = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        stopwatch.reset();
+        sum += table.find(keys[order[i]])->second;
+        samples[i] = stopwatch.elapsed_ns();
+    }
+    percentiles(samples, result.hit_mean, result.hit_p99);
+
+    size_t found = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        stopwatch.reset();
+        found += table.find(missing[order[i]]) != table.end();
+        samples[i] = stopwatch.elapsed_ns();
+    }
+    percentiles(samples, result.miss_mean, result.miss_p99);
+
+    Benchmark::do_not_optimize(sum);
+    Benchmark::do_not_optimize(found);
+    return result;
+}
+
+static void print(const char* name, const Result& result)
+{
+    std::printf("  %-12s %8.1f %8.1f %8.1f %8.1f %8.1f\n", name, result.insert,
+                result.hit_mean, result.hit_p99, result.miss_mean, result.miss_p99);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    std::mt19937_64 random(23);
+    std::vector<std::string> keys(count);
+    std::vector<std::string> missing(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        std::string id = std::to_string(random());
+        keys[i] = "tenant/" + std::to_string(i % 64) + "/object/" + id;
+        missing[i] = "tenant/" + std::to_string(i % 64) + "/object/" + id + "x";
+    }
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++)
+        order[i] = random() % count;
+
+    std::printf("%zu string keys (ns per operation, lookups timed one by one)\n", count);
+    std::printf("  %-12s %8s %8s %8s %8s %8s\n", "table", "insert", "hit", "hit p99", "miss", "miss p99");
+    print("FlatHashMap", run<CppADS::FlatHashMap<std::string, size_t>>(keys, missing, order));
+    print("RobinHood", run<CppADS::RobinHoodHashTable<std::string, size_t>>(keys, missing, order));
+    print("Chained", run<CppADS::HashTable<std::string, size_t>>(keys, missing, order));
+
+    return 0;
+}
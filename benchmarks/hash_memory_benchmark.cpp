@@ -0,0 +1,128 @@
+#include "benchmark.hpp"
+
+#include "hash_multi_map.hpp"
+#include "hash_set.hpp"
+#include "hash_table.hpp"
+#include "list.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+
+/// Heap memory per entry and insert time of the set and multimap companions against
+/// the HashTable encodings they replace: HashTable<Key, bool> as a set and
+/// HashTable<Key, List<T>> as a multimap. Memory is counted by replaced global
+/// operator new, so it is the requested size without allocator overhead.
+///
+/// Usage: HashMemoryBenchmark [keys] [values per key]
+
+static size_t g_live_bytes = 0;
+static size_t g_live_blocks = 0;
+
+/// Every block starts with its requested size
+static const size_t HeaderSize = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    void* block = std::malloc(size + HeaderSize);
+    if (block == nullptr)
+        throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    g_live_bytes += size;
+    g_live_blocks++;
+    return static_cast<char*>(block) + HeaderSize;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr)
+        return;
+    void* block = static_cast<char*>(pointer) - HeaderSize;
+    g_live_bytes -= *static_cast<size_t*>(block);
+    g_live_blocks--;
+    std::free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+template<typename Fill>
+static void run(const char* name, size_t entries, Fill fill)
+{
+    size_t bytes = g_live_bytes;
+    size_t blocks = g_live_blocks;
+    Benchmark::Stopwatch stopwatch;
+    {
+        auto container = fill();
+        double elapsed = stopwatch.elapsed_ns();
+        Benchmark::do_not_optimize(container.size());
+        std::printf("  %-34s %8.1f bytes/entry %6.2f allocations/entry %8.1f ns/entry\n", name,
+                    static_cast<double>(g_live_bytes - bytes) / entries,
+                    static_cast<double>(g_live_blocks - blocks) / entries,
+                    elapsed / entries);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t keys = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    uint64_t per_key = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4;
+
+    std::printf("Set of %llu uint64_t keys\n", static_cast<unsigned long long>(keys));
+    run("HashTable<uint64_t, bool>", keys, [keys]() {
+        CppADS::HashTable<uint64_t, bool> table;
+        for (uint64_t key = 0; key < keys; key++)
+            table.insert({key * 2654435761ULL, true});
+        return table;
+    });
+    run("HashSet<uint64_t>", keys, [keys]() {
+        CppADS::HashSet<uint64_t> set;
+        for (uint64_t key = 0; key < keys; key++)
+            set.insert(key * 2654435761ULL);
+        return set;
+    });
+    run("std::unordered_set<uint64_t>", keys, [keys]() {
+        std::unordered_set<uint64_t> set;
+        for (uint64_t key = 0; key < keys; key++)
+            set.insert(key * 2654435761ULL);
+        return set;
+    });
+
+    uint64_t groups = keys / per_key;
+    std::printf("Multimap of %llu keys with %llu uint64_t values each\n",
+                static_cast<unsigned long long>(groups), static_cast<unsigned long long>(per_key));
+    run("HashTable<uint64_t, List<uint64_t>>", groups * per_key, [groups, per_key]() {
+        CppADS::HashTable<uint64_t, CppADS::List<uint64_t>> table;
+        for (uint64_t value = 0; value < per_key; value++)
+        {
+            for (uint64_t key = 0; key < groups; key++)
+                table[key * 2654435761ULL].push_back(value);
+        }
+        return table;
+    });
+    run("HashMultiMap<uint64_t, uint64_t>", groups * per_key, [groups, per_key]() {
+        CppADS::HashMultiMap<uint64_t, uint64_t> map;
+        for (uint64_t value = 0; value < per_key; value++)
+        {
+            for (uint64_t key = 0; key < groups; key++)
+                map.insert({key * 2654435761ULL, value});
+        }
+        return map;
+    });
+    run("std::unordered_multimap", groups * per_key, [groups, per_key]() {
+        std::unordered_multimap<uint64_t, uint64_t> map;
+        for (uint64_t value = 0; value < per_key; value++)
+        {
+            for (uint64_t key = 0; key < groups; key++)
+                map.insert({key * 2654435761ULL, value});
+        }
+        return map;
+    });
+
+    return 0;
+}
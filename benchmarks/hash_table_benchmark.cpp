@@ -0,0 +1,96 @@
+#include "benchmark.hpp"
+
+#include "hash_table.hpp"
+#include "robin_hood_hash_table.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/// Open addressing (RobinHoodHashTable) against separate chaining (HashTable): insert,
+/// lookup of present and missing keys and erase at fixed load factors of the open table.
+/// Both tables get the same keys.
+///
+/// Usage: HashTableBenchmark [log2_slots]
+
+struct Result
+{
+    double insert;
+    double hit;
+    double miss;
+    double erase;
+};
+
+template<typename Table>
+static Result run(Table& table, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& missing)
+{
+    Result result;
+    size_t count = keys.size();
+    Benchmark::Stopwatch stopwatch;
+    for (uint64_t key : keys)
+        table.insert({key, key});
+    result.insert = stopwatch.elapsed_ns() / count;
+
+    stopwatch.reset();
+    uint64_t sum = 0;
+    for (uint64_t key : keys)
+        sum += table.find(key)->second;
+    result.hit = stopwatch.elapsed_ns() / count;
+
+    stopwatch.reset();
+    size_t found = 0;
+    for (uint64_t key : missing)
+        found += table.find(key) != table.end();
+    result.miss = stopwatch.elapsed_ns() / count;
+
+    stopwatch.reset();
+    for (size_t i = 0; i < count; i += 2)
+        table.remove(keys[i]);
+    result.erase = stopwatch.elapsed_ns() / ((count + 1) / 2);
+
+    Benchmark::do_not_optimize(sum);
+    Benchmark::do_not_optimize(found);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    size_t log2_slots = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 20;
+    size_t slots = size_t(1) << log2_slots;
+
+    std::printf("%zu slots of RobinHoodHashTable, uint64_t keys (ns per operation)\n", slots);
+    std::printf("  %5s  %-12s %8s %8s %8s %8s\n", "load", "table", "insert", "hit", "miss", "erase");
+
+    std::mt19937_64 random(17);
+    const float load_factors[] = {0.5f, 0.6f, 0.7f, 0.8f, 0.9f};
+    for (float load_factor : load_factors)
+    {
+        size_t count = static_cast<size_t>(slots * load_factor);
+        std::vector<uint64_t> keys(count);
+        std::vector<uint64_t> missing(count);
+        for (auto& key : keys)
+            key = random() | 1;
+        for (auto& key : missing)
+            key = random() & ~uint64_t(1);
+
+        // Limit above the measured load keeps the slot count fixed
+        CppADS::RobinHoodHashTable<uint64_t, uint64_t> open;
+        open.set_load_factor(0.95f);
+        open.reserve(static_cast<size_t>(slots * 0.9f));
+        Result open_result = run(open, keys, missing);
+
+        // Same number of buckets as slots and the same limit
+        CppADS::HashTable<uint64_t, uint64_t> chained;
+        chained.set_load_factor(0.95f);
+        chained.reserve(static_cast<size_t>(slots * 0.9f));
+        Result chained_result = run(chained, keys, missing);
+
+        std::printf("  %5.2f  %-12s %8.1f %8.1f %8.1f %8.1f\n", load_factor, "RobinHood",
+                    open_result.insert, open_result.hit, open_result.miss, open_result.erase);
+        std::printf("  %5s  %-12s %8.1f %8.1f %8.1f %8.1f\n", "", "Chained",
+                    chained_result.insert, chained_result.hit, chained_result.miss, chained_result.erase);
+    }
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "benchmark.hpp"
+
+#include "hash_table.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// Total time of loading a HashTable with known data: inserts into a growing table,
+/// reserve() before the inserts and a single range insert. Best of several runs is
+/// reported, the first runs also pay for page faults of fresh memory.
+///
+/// Usage: HashTableBulkLoadBenchmark [keys]
+
+using Table = CppADS::HashTable<uint64_t, uint64_t>;
+using Items = std::vector<std::pair<uint64_t, uint64_t>>;
+
+static const size_t Runs = 3;
+
+template<typename Load>
+static void run(const char* name, const Items& items, Load load)
+{
+    double best = 0.0;
+    size_t buckets = 0;
+    for (size_t run = 0; run < Runs; run++)
+    {
+        Table table;
+        Benchmark::Stopwatch stopwatch;
+        load(table);
+        double elapsed = stopwatch.elapsed_ns();
+        Benchmark::do_not_optimize(table.size());
+        if (run == 0 || elapsed < best)
+            best = elapsed;
+        buckets = table.bucket_count();
+    }
+
+    std::printf("  %-14s %10.1f ms %8.1f ns/key  (%zu buckets)\n",
+                name, best / 1e6, best / items.size(), buckets);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937_64 random(37);
+    Items items(count);
+    for (size_t i = 0; i < count; i++)
+        items[i] = {random(), i};
+
+    std::printf("Loading %zu uint64_t keys\n", count);
+    run("growing", items, [&items](Table& table) {
+        for (const auto& item : items)
+            table.insert(item);
+    });
+    run("reserve", items, [&items](Table& table) {
+        table.reserve(items.size());
+        for (const auto& item : items)
+            table.insert(item);
+    });
+    run("range insert", items, [&items](Table& table) {
+        table.insert(items.begin(), items.end());
+    });
+
+    return 0;
+}
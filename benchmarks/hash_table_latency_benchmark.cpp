@@ -0,0 +1,77 @@
+#include "benchmark.hpp"
+
+#include "hash_table.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/// Latency of single inserts into a growing HashTable: rehashing at once against
+/// incremental rehashing which moves a few buckets per operation. Every insert is timed
+/// separately, the histogram has power-of-two latency ranges.
+///
+/// Usage: HashTableLatencyBenchmark [keys] [rehash_step]
+
+static const size_t HistogramSize = 32;
+
+static double percentile(const std::vector<uint64_t>& sorted, double fraction)
+{
+    size_t rank = static_cast<size_t>(fraction * (sorted.size() - 1));
+    return static_cast<double>(sorted[rank]);
+}
+
+static void run(const char* name, const std::vector<uint64_t>& keys, size_t rehash_step)
+{
+    CppADS::HashTable<uint64_t, uint64_t> table;
+    table.set_rehash_step(rehash_step);
+
+    std::vector<uint64_t> samples(keys.size());
+    Benchmark::Stopwatch total;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        stopwatch.reset();
+        table.insert({keys[i], i});
+        samples[i] = stopwatch.elapsed_ns();
+    }
+    double elapsed = total.elapsed_ns();
+
+    size_t histogram[HistogramSize] = {};
+    for (uint64_t sample : samples)
+    {
+        size_t range = 0;
+        while (range + 1 < HistogramSize && (uint64_t(1) << (range + 1)) <= sample)
+            range++;
+        histogram[range]++;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    std::printf("%s (rehash step %zu): %.1f ms total, %zu buckets\n", name, rehash_step, elapsed / 1e6, table.bucket_count());
+    std::printf("  p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns, p99.99 %.0f ns, max %.0f ns\n",
+                percentile(samples, 0.5), percentile(samples, 0.99), percentile(samples, 0.999),
+                percentile(samples, 0.9999), percentile(samples, 1.0));
+    for (size_t range = 0; range < HistogramSize; range++)
+    {
+        if (histogram[range] != 0)
+            std::printf("  %12llu ns+ %10zu\n", static_cast<unsigned long long>(uint64_t(1) << range), histogram[range]);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t rehash_step = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 8;
+
+    std::mt19937_64 random(31);
+    std::vector<uint64_t> keys(count);
+    for (auto& key : keys)
+        key = random();
+
+    std::printf("%zu inserts of uint64_t keys\n", count);
+    run("At once", keys, 0);
+    run("Incremental", keys, rehash_step);
+
+    return 0;
+}
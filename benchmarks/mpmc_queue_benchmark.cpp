@@ -0,0 +1,153 @@
+#include "benchmark.hpp"
+
+#include "mpmc_queue.hpp"
+#include "queue.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Scaling of MpmcQueue against Queue guarded by one mutex, with equal count
+/// of producer and consumer threads from 1 + 1 to 32 + 32.
+///
+/// Usage: MpmcQueueBenchmark [count] [capacity]
+
+/// Bounded Queue guarded by mutex with the same blocking interface as MpmcQueue
+template<typename T>
+class MutexQueue
+{
+public:
+    explicit MutexQueue(size_t capacity) : m_capacity(capacity) {
+        m_queue.reserve(capacity);
+    }
+
+    void enqueue(const T& value) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [this]() { return m_queue.size() < m_capacity; });
+        m_queue.enqueue(value);
+        lock.unlock();
+        m_not_empty.notify_one();
+    }
+
+    void dequeue(T& value) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this]() { return m_queue.size() != 0; });
+        value = std::move(m_queue.front());
+        m_queue.dequeue();
+        lock.unlock();
+        m_not_full.notify_one();
+    }
+
+    template<typename InputIt>
+    size_t try_enqueue_bulk(InputIt first, size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        size_t pushed = 0;
+        for (; pushed < count && m_queue.size() < m_capacity; pushed++, ++first)
+            m_queue.enqueue(*first);
+        lock.unlock();
+        if (pushed != 0)
+            m_not_empty.notify_all();
+        return pushed;
+    }
+
+    template<typename OutputIt>
+    size_t try_dequeue_bulk(OutputIt out, size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        size_t popped = m_queue.dequeue_bulk(out, count);
+        lock.unlock();
+        if (popped != 0)
+            m_not_full.notify_all();
+        return popped;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+    CppADS::Queue<T> m_queue;
+    size_t m_capacity;
+};
+
+/// Transfer of per_thread values by each of pairs producer/consumer pairs
+template<typename Q>
+static double run(size_t pairs, size_t per_thread, size_t capacity, size_t batch_size)
+{
+    Q queue(capacity);
+    std::vector<std::thread> threads;
+    Benchmark::Stopwatch stopwatch;
+
+    for (size_t p = 0; p < pairs; p++)
+    {
+        threads.emplace_back([&queue, per_thread, batch_size]() {
+            size_t batch[64];
+            size_t next = 0;
+            while (next < per_thread)
+            {
+                if (batch_size == 1)
+                {
+                    queue.enqueue(next++);
+                    continue;
+                }
+                size_t size = std::min(batch_size, per_thread - next);
+                for (size_t i = 0; i < size; i++)
+                    batch[i] = next + i;
+                size_t pushed = queue.try_enqueue_bulk(batch, size);
+                if (pushed == 0)
+                    std::this_thread::yield();
+                next += pushed;
+            }
+        });
+        threads.emplace_back([&queue, per_thread, batch_size]() {
+            size_t batch[64];
+            size_t received = 0;
+            size_t sum = 0;
+            while (received < per_thread)
+            {
+                if (batch_size == 1)
+                {
+                    queue.dequeue(batch[0]);
+                    sum += batch[0];
+                    received++;
+                    continue;
+                }
+                size_t popped = queue.try_dequeue_bulk(batch, std::min(batch_size, per_thread - received));
+                if (popped == 0)
+                    std::this_thread::yield();
+                for (size_t i = 0; i < popped; i++)
+                    sum += batch[i];
+                received += popped;
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+    return stopwatch.elapsed_ns();
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t capacity = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1024;
+
+    for (size_t batch_size : {1, 32})
+    {
+        std::printf("%zu values, capacity %zu, batch %zu (Mops/s)\n", count, capacity, batch_size);
+        std::printf("  %8s %12s %12s\n", "threads", "MpmcQueue", "MutexQueue");
+        for (size_t pairs = 1; pairs <= 32; pairs *= 2)
+        {
+            size_t per_thread = count / pairs;
+            double lock_free = run<CppADS::MpmcQueue<size_t>>(pairs, per_thread, capacity, batch_size);
+            double locked = run<MutexQueue<size_t>>(pairs, per_thread, capacity, batch_size);
+            size_t total = per_thread * pairs;
+            std::printf("  %8zu %12.2f %12.2f\n", 2 * pairs, total * 1e3 / lock_free, total * 1e3 / locked);
+        }
+    }
+
+    return 0;
+}
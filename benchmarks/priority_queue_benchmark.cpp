@@ -0,0 +1,67 @@
+#include "benchmark.hpp"
+
+#include "priority_queue.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/// Binary and d-ary PriorityQueue on large heaps: heapify, push of all values,
+/// pop of all values and a push_pop stream over a full heap.
+///
+/// Usage: PriorityQueueBenchmark [count]
+
+template<size_t Arity>
+static void run(const std::vector<uint64_t>& values)
+{
+    using Queue = CppADS::PriorityQueue<uint64_t, std::less<uint64_t>, Arity>;
+    const size_t count = values.size();
+    Benchmark::Stopwatch stopwatch;
+
+    Queue heapified(values.begin(), values.end());
+    double heapify_ns = stopwatch.elapsed_ns();
+
+    Queue queue;
+    queue.reserve(count);
+    stopwatch.reset();
+    for (uint64_t value : values)
+        queue.push(value);
+    double push_ns = stopwatch.elapsed_ns();
+
+    stopwatch.reset();
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++)
+        sum += heapified.push_pop(values[i] >> 1);
+    double push_pop_ns = stopwatch.elapsed_ns();
+
+    stopwatch.reset();
+    while (!queue.empty())
+    {
+        sum += queue.top();
+        queue.pop();
+    }
+    double pop_ns = stopwatch.elapsed_ns();
+    Benchmark::do_not_optimize(sum);
+
+    std::printf("  %6zu %10.1f %10.1f %10.1f %10.1f\n", Arity,
+                heapify_ns / count, push_ns / count, pop_ns / count, push_pop_ns / count);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> values(count);
+    for (auto& value : values)
+        value = random();
+
+    std::printf("%zu random values (ns per element)\n", count);
+    std::printf("  %6s %10s %10s %10s %10s\n", "arity", "heapify", "push", "pop", "push_pop");
+    run<2>(values);
+    run<4>(values);
+    run<8>(values);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "benchmark.hpp"
+
+#include "concurrent_hash_table.hpp"
+#include "hash_table.hpp"
+#include "read_mostly_hash_map.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/// Reader throughput while one writer updates continuously: ReadMostlyHashMap against
+/// ConcurrentHashTable and one HashTable guarded by a shared mutex. Each configuration
+/// runs for a fixed time.
+///
+/// Usage: ReadMostlyHashMapBenchmark [milliseconds] [keys]
+
+/// HashTable guarded by one reader-writer lock
+class SharedMutexTable
+{
+public:
+    bool find(uint64_t key, uint64_t& value) const {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+        const auto& table = m_table;
+        auto found = table.find(key);
+        if (found == table.cend())
+            return false;
+        value = found->second;
+        return true;
+    }
+
+    bool insert_or_assign(uint64_t key, uint64_t value) {
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        return m_table.insert_or_assign(key, value).second;
+    }
+
+private:
+    mutable std::shared_timed_mutex m_mutex;
+    CppADS::HashTable<uint64_t, uint64_t> m_table;
+};
+
+struct Result
+{
+    double lookups;     ///< Lookups per second of all readers, millions
+    double updates;     ///< Updates per second of the writer, thousands
+};
+
+template<typename Map>
+static Result run(size_t readers, unsigned milliseconds, uint64_t keys)
+{
+    Map map;
+    for (uint64_t key = 0; key < keys; key++)
+        map.insert_or_assign(key, key);
+
+    std::atomic<bool> stop { false };
+    std::atomic<size_t> lookups { 0 };
+    size_t updates = 0;
+    std::vector<std::thread> threads;
+    Benchmark::Stopwatch stopwatch;
+    for (size_t r = 0; r < readers; r++)
+    {
+        threads.emplace_back([&map, &stop, &lookups, keys, r]() {
+            std::mt19937_64 random(r + 1);
+            uint64_t sum = 0;
+            size_t count = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                uint64_t value = 0;
+                map.find(random() % keys, value);
+                sum += value;
+                count++;
+            }
+            lookups += count;
+            Benchmark::do_not_optimize(sum);
+        });
+    }
+    threads.emplace_back([&map, &stop, &updates, keys]() {
+        std::mt19937_64 random(0);
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            map.insert_or_assign(random() % keys, updates);
+            updates++;
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop = true;
+    for (auto& thread : threads)
+        thread.join();
+    double elapsed = stopwatch.elapsed_ns();
+    return Result { lookups.load() * 1e3 / elapsed, updates * 1e6 / elapsed };
+}
+
+int main(int argc, char** argv)
+{
+    unsigned milliseconds = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 500;
+    uint64_t keys = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 100000;
+
+    std::printf("%llu keys, %u ms per run, %u hardware threads\n",
+                static_cast<unsigned long long>(keys), milliseconds, std::thread::hardware_concurrency());
+    std::printf("  %8s %26s %26s %26s\n", "readers", "ReadMostlyHashMap", "ConcurrentHashTable", "SharedMutex");
+    std::printf("  %8s %26s %26s %26s\n", "", "Mlookups/s  Kupdates/s", "Mlookups/s  Kupdates/s", "Mlookups/s  Kupdates/s");
+    for (size_t readers = 1; readers <= 8; readers *= 2)
+    {
+        Result rcu = run<CppADS::ReadMostlyHashMap<uint64_t, uint64_t>>(readers, milliseconds, keys);
+        Result sharded = run<CppADS::ConcurrentHashTable<uint64_t, uint64_t>>(readers, milliseconds, keys);
+        Result locked = run<SharedMutexTable>(readers, milliseconds, keys);
+        std::printf("  %8zu %14.2f %11.1f %14.2f %11.1f %14.2f %11.1f\n", readers,
+                    rcu.lookups, rcu.updates, sharded.lookups, sharded.updates, locked.lookups, locked.updates);
+    }
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "benchmark.hpp"
+
+#include "queue.hpp"
+#include "spsc_queue.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+/// Compares lock-free SpscQueue with Queue guarded by mutex.
+///
+/// Usage: SpscQueueBenchmark [count] [capacity]
+
+/// Queue guarded by mutex with the same try-interface as SpscQueue
+template<typename T>
+class MutexQueue
+{
+public:
+    explicit MutexQueue(size_t capacity) : m_capacity(capacity) {
+        m_queue.reserve(capacity);
+    }
+
+    bool try_push(const T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() == m_capacity)
+            return false;
+        m_queue.enqueue(value);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() == 0)
+            return false;
+        value = std::move(m_queue.front());
+        m_queue.dequeue();
+        return true;
+    }
+
+    size_t try_push_n(const T* values, size_t count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t pushed = 0;
+        for (; pushed < count && m_queue.size() < m_capacity; pushed++)
+            m_queue.enqueue(values[pushed]);
+        return pushed;
+    }
+
+    size_t try_pop_n(T* values, size_t count) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.dequeue_bulk(values, count);
+    }
+
+private:
+    std::mutex m_mutex;
+    CppADS::Queue<T> m_queue;
+    size_t m_capacity;
+};
+
+/// Round trip of single value through a pair of queues
+template<typename Q>
+static void bench_ping_pong(const char* name, size_t count, size_t capacity)
+{
+    Q ping(capacity);
+    Q pong(capacity);
+
+    std::thread echo([&ping, &pong, count]() {
+        size_t value;
+        for (size_t i = 0; i < count; i++)
+        {
+            CppADS::Backoff backoff;
+            while (!ping.try_pop(value))
+                backoff.pause();
+            while (!pong.try_push(value))
+                backoff.pause();
+        }
+    });
+
+    Benchmark::Stopwatch stopwatch;
+    size_t value;
+    for (size_t i = 0; i < count; i++)
+    {
+        CppADS::Backoff backoff;
+        while (!ping.try_push(i))
+            backoff.pause();
+        while (!pong.try_pop(value))
+            backoff.pause();
+    }
+    double elapsed = stopwatch.elapsed_ns();
+    echo.join();
+    Benchmark::do_not_optimize(value);
+    std::printf("  %-12s %8.2f ns/round trip\n", name, elapsed / count);
+}
+
+/// One-way transfer of values, batch_size values per call
+template<typename Q>
+static void bench_throughput(const char* name, size_t count, size_t capacity, size_t batch_size)
+{
+    Q queue(capacity);
+
+    Benchmark::Stopwatch stopwatch;
+    std::thread producer([&queue, count, batch_size]() {
+        size_t batch[64];
+        size_t next = 0;
+        CppADS::Backoff backoff;
+        while (next < count)
+        {
+            size_t size = std::min(batch_size, count - next);
+            for (size_t i = 0; i < size; i++)
+                batch[i] = next + i;
+            size_t pushed = (size == 1) ? queue.try_push(batch[0]) : queue.try_push_n(batch, size);
+            if (pushed == 0)
+                backoff.pause();
+            else
+                backoff.reset();
+            next += pushed;
+        }
+    });
+
+    size_t batch[64];
+    size_t received = 0;
+    size_t sum = 0;
+    CppADS::Backoff backoff;
+    while (received < count)
+    {
+        size_t popped = (batch_size == 1) ? queue.try_pop(batch[0]) : queue.try_pop_n(batch, batch_size);
+        if (popped == 0)
+            backoff.pause();
+        else
+            backoff.reset();
+        for (size_t i = 0; i < popped; i++)
+            sum += batch[i];
+        received += popped;
+    }
+    double elapsed = stopwatch.elapsed_ns();
+    producer.join();
+    Benchmark::do_not_optimize(sum);
+    std::printf("  %-12s batch %2zu %8.2f ns/op %8.2f Mops/s\n", name, batch_size,
+                elapsed / count, count * 1e3 / elapsed);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t capacity = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1024;
+
+    std::printf("ping-pong latency, %zu round trips\n", count / 10);
+    bench_ping_pong<CppADS::SpscQueue<size_t>>("SpscQueue", count / 10, capacity);
+    bench_ping_pong<MutexQueue<size_t>>("MutexQueue", count / 10, capacity);
+
+    std::printf("throughput, %zu values, capacity %zu\n", count, capacity);
+    for (size_t batch_size : {1, 16, 64})
+    {
+        bench_throughput<CppADS::SpscQueue<size_t>>("SpscQueue", count, capacity, batch_size);
+        bench_throughput<MutexQueue<size_t>>("MutexQueue", count, capacity, batch_size);
+    }
+
+    return 0;
+}
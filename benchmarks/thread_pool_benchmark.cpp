@@ -0,0 +1,102 @@
+#include "benchmark.hpp"
+
+#include "array.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+/// Scaling of recursive fork/join computations on ThreadPool.
+///
+/// Usage: ThreadPoolBenchmark [fib_n] [sort_count] [max_threads]
+
+static long long fib_serial(int n)
+{
+    return (n < 2) ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static long long fib(CppADS::ThreadPool& pool, int n)
+{
+    if (n < 20)
+        return fib_serial(n);
+
+    long long left = 0;
+    CppADS::WaitGroup group;
+    pool.submit(group, [&pool, &left, n]() { left = fib(pool, n - 1); });
+    long long right = fib(pool, n - 2);
+    pool.wait(group);
+    return left + right;
+}
+
+static void quicksort(CppADS::ThreadPool& pool, int* first, int* last)
+{
+    size_t count = last - first;
+    if (count < 4096)
+    {
+        std::sort(first, last);
+        return;
+    }
+
+    int pivot = std::max(std::min(first[0], first[count / 2]), std::min(std::max(first[0], first[count / 2]), last[-1]));
+    int* middle_first = std::partition(first, last, [pivot](int value) { return value < pivot; });
+    int* middle_last = std::partition(middle_first, last, [pivot](int value) { return value == pivot; });
+
+    CppADS::WaitGroup group;
+    pool.submit(group, [&pool, first, middle_first]() { quicksort(pool, first, middle_first); });
+    quicksort(pool, middle_last, last);
+    pool.wait(group);
+}
+
+int main(int argc, char** argv)
+{
+    int fib_n = (argc > 1) ? std::atoi(argv[1]) : 36;
+    size_t sort_count = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+    size_t max_threads = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    CppADS::Array<int> source;
+    source.reserve(sort_count);
+    std::mt19937 random(42);
+    for (size_t i = 0; i < sort_count; i++)
+        source.push_back(static_cast<int>(random()));
+
+    Benchmark::Stopwatch stopwatch;
+    Benchmark::do_not_optimize(fib_serial(fib_n));
+    double fib_base = stopwatch.elapsed_ns();
+
+    CppADS::Array<int> data(source);
+    stopwatch.reset();
+    std::sort(&data[0], &data[0] + sort_count);
+    double sort_base = stopwatch.elapsed_ns();
+
+    std::printf("fib(%d) serial %.1f ms, sort of %zu ints serial %.1f ms\n", fib_n, fib_base / 1e6, sort_count, sort_base / 1e6);
+    std::printf("  %8s %10s %8s %10s %8s\n", "threads", "fib ms", "speedup", "sort ms", "speedup");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        CppADS::ThreadPool pool(threads);
+
+        long long result = 0;
+        stopwatch.reset();
+        CppADS::WaitGroup group;
+        pool.submit(group, [&pool, &result, fib_n]() { result = fib(pool, fib_n); });
+        pool.wait(group);
+        double fib_time = stopwatch.elapsed_ns();
+        Benchmark::do_not_optimize(result);
+
+        data = source;
+        stopwatch.reset();
+        CppADS::WaitGroup sort_group;
+        pool.submit(sort_group, [&pool, &data, sort_count]() { quicksort(pool, &data[0], &data[0] + sort_count); });
+        pool.wait(sort_group);
+        double sort_time = stopwatch.elapsed_ns();
+        if (!std::is_sorted(&data[0], &data[0] + sort_count))
+            std::printf("  sort failed\n");
+
+        std::printf("  %8zu %10.1f %8.2f %10.1f %8.2f\n", threads, fib_time / 1e6, fib_base / fib_time,
+                    sort_time / 1e6, sort_base / sort_time);
+    }
+
+    return 0;
+}
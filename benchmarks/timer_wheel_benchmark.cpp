@@ -0,0 +1,110 @@
+#include "benchmark.hpp"
+
+#include "indexed_heap.hpp"
+#include "timer_wheel.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+/// Connection timeouts: every tick a batch of timers is scheduled and 90% of them are
+/// cancelled a few ticks later, the rest expire. TimerWheel is compared with timers
+/// kept in IndexedHeap ordered by expiry.
+///
+/// Usage: TimerWheelBenchmark [timers]
+
+static const size_t PerTick = 1000;             ///< Timers scheduled per tick
+static const size_t CancelLag = 16;             ///< Ticks before cancellation
+static const uint64_t MinTimeout = 1000;        ///< Timeout range in ticks
+static const uint64_t MaxTimeout = 5000;
+
+/// Timers on IndexedHeap with the TimerWheel interface used below
+class HeapTimers
+{
+    using Item = std::pair<uint64_t, size_t>;
+    using Heap = CppADS::IndexedHeap<Item, std::less<Item>, 4>;
+
+public:
+    using timer_id = Heap::handle_type;
+
+    timer_id schedule(uint64_t delay, size_t value) {
+        return m_heap.push(Item(m_now + delay, value));
+    }
+
+    bool cancel(timer_id id) {
+        if (!m_heap.contains(id))
+            return false;
+        m_heap.erase(id);
+        return true;
+    }
+
+    template<typename Callback>
+    size_t advance(uint64_t ticks, Callback callback) {
+        m_now += ticks;
+        size_t expired = 0;
+        while (!m_heap.empty() && m_heap.top().first <= m_now)
+        {
+            size_t value = m_heap.top().second;
+            m_heap.pop();
+            callback(value);
+            expired++;
+        }
+        return expired;
+    }
+
+private:
+    Heap m_heap;
+    uint64_t m_now { 0 };
+};
+
+template<typename Timers>
+static void run(const char* name, size_t count, const std::vector<uint32_t>& timeouts)
+{
+    Timers timers;
+    std::vector<std::vector<typename Timers::timer_id>> to_cancel(CancelLag);
+    size_t scheduled = 0;
+    size_t cancelled = 0;
+    size_t expired = 0;
+    size_t checksum = 0;
+    auto on_expiry = [&checksum](size_t value) { checksum += value; };
+
+    Benchmark::Stopwatch stopwatch;
+    for (uint64_t tick = 0; scheduled < count || expired + cancelled < count; tick++)
+    {
+        auto& batch = to_cancel[tick % CancelLag];
+        for (auto id : batch)
+            cancelled += timers.cancel(id);
+        batch.clear();
+
+        for (size_t i = 0; i < PerTick && scheduled < count; i++, scheduled++)
+        {
+            auto id = timers.schedule(timeouts[scheduled], scheduled);
+            if (scheduled % 10 != 0)
+                batch.push_back(id);
+        }
+        expired += timers.advance(1, on_expiry);
+    }
+    double elapsed = stopwatch.elapsed_ns();
+    Benchmark::do_not_optimize(checksum);
+
+    std::printf("  %-12s %10.1f ms %8.1f ns/timer  (%zu cancelled, %zu expired)\n",
+                name, elapsed / 1e6, elapsed / count, cancelled, expired);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937 random(5);
+    std::vector<uint32_t> timeouts(count);
+    for (auto& timeout : timeouts)
+        timeout = MinTimeout + random() % (MaxTimeout - MinTimeout);
+
+    std::printf("%zu timers, %zu per tick, 90%% cancelled after %zu ticks\n", count, PerTick, CancelLag);
+    run<CppADS::TimerWheel<size_t>>("TimerWheel", count, timeouts);
+    run<HeapTimers>("IndexedHeap", count, timeouts);
+
+    return 0;
+}
@@ -514,30 +514,33 @@ void CppADS::Array<T>::push_back(T&& value)
 template<typename T>
 void CppADS::Array<T>::remove(size_t index)
 {
-    if (index > m_size)
+    if (index >= m_size)
         throw std::out_of_range("CppADS::Array<T>::remove: index is out of range");
 
     auto it = begin() + index;
-    while (it < end())
+    while (it + 1 < end())
     {
         *it = std::move(*(it + 1));
         it++;
     }
-
+    // Vacated slot releases its value now rather than on reuse
+    *it = T();
     m_size--;
 }
 
 template<typename T>
 void CppADS::Array<T>::remove(iterator position)
 {
-    if (position > end() || position < begin())
+    if (position >= end() || position < begin())
          throw std::out_of_range("CppADS::Array<T>::remove: iterator is invalid");
 
-    while (position < end())
+    while (position + 1 < end())
     {
         *position = std::move(*(position + 1));
         position++;
     }
+    // Vacated slot releases its value now rather than on reuse
+    *position = T();
     m_size--;
 }
 
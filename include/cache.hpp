@@ -0,0 +1,950 @@
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include "container.hpp"
+#include "array.hpp"
+#include "hash_table.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace CppADS
+{
+    /// @brief Slab of cache nodes linked into several intrusive lists
+    /// @details Building block of cache policies: nodes are addressed by stable indices
+    /// (handles) and may be moved between lists in O(1) without allocations.
+    /// @tparam Key key type stored in nodes
+    /// @tparam Lists count of lists nodes can be linked to
+    template<typename Key, size_t Lists>
+    class CacheNodePool
+    {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);     ///< Invalid node index
+
+        /// @brief Constructor
+        /// @param capacity count of nodes in the slab
+        explicit CacheNodePool(size_t capacity);
+
+        /// @brief Unlink and release all nodes
+        void clear();
+
+        /// @brief Take unused node from the slab
+        /// @param key key stored in the node
+        /// @return index of the node (not linked to any list)
+        size_t acquire(const Key& key);
+        /// @brief Return unlinked node to the slab
+        /// @param index index of the node
+        void release(size_t index);
+
+        /// @brief Link node to the front of list
+        /// @param list list number
+        /// @param index index of unlinked node
+        void push_front(size_t list, size_t index);
+        /// @brief Unlink node from its list
+        /// @param index index of linked node
+        void unlink(size_t index);
+        /// @brief Move linked node to the front of list
+        /// @param list list number
+        /// @param index index of linked node
+        void move_front(size_t list, size_t index);
+
+        /// @param list list number
+        /// @return index of the last node of list (npos if list is empty)
+        size_t back(size_t list) const;
+        /// @param list list number
+        /// @return count of nodes linked to list
+        size_t size(size_t list) const;
+        /// @param index index of linked node
+        /// @return number of the list node linked to
+        size_t list(size_t index) const;
+        /// @param index index of node
+        /// @return key stored in node
+        const Key& key(size_t index) const;
+
+    private:
+        struct Node
+        {
+            Key key {};
+            size_t prev { npos };
+            size_t next { npos };
+            size_t list { npos };
+        };
+
+        Array<Node> m_nodes;
+        size_t m_free { npos };
+        size_t m_head[Lists];
+        size_t m_tail[Lists];
+        size_t m_count[Lists];
+    };
+
+    /// @brief Least-recently-used eviction policy
+    /// @tparam Key key type
+    template<typename Key>
+    class LruPolicy
+    {
+    public:
+        /// @param capacity maximum count of resident entries
+        explicit LruPolicy(size_t capacity);
+
+        /// @return maximum count of resident entries
+        size_t capacity() const;
+        /// @brief Forget all entries
+        void clear();
+
+        /// @brief Register access to resident entry
+        /// @param handle handle returned by admit()
+        void touch(size_t handle);
+        /// @brief Register new resident entry, evicting another one if policy is full
+        /// @param key key of the new entry
+        /// @param evicted set to true if resident entry was evicted
+        /// @param victim key of evicted entry
+        /// @return handle of the new entry
+        size_t admit(const Key& key, bool& evicted, Key& victim);
+        /// @brief Forget resident entry
+        /// @param handle handle returned by admit()
+        void remove(size_t handle);
+
+    private:
+        CacheNodePool<Key, 1> m_nodes;
+        size_t m_capacity;
+    };
+
+    /// @brief CLOCK (second chance) eviction policy over ring of slots
+    /// @details Hand sweeps the ring clearing reference bits and evicts the first entry
+    /// which wasn't accessed since the previous sweep. Entries are admitted unreferenced,
+    /// so single-use keys are the first to go.
+    /// @tparam Key key type
+    template<typename Key>
+    class ClockPolicy
+    {
+    public:
+        /// @param capacity maximum count of resident entries
+        explicit ClockPolicy(size_t capacity);
+
+        /// @return maximum count of resident entries
+        size_t capacity() const;
+        /// @brief Forget all entries
+        void clear();
+
+        /// @brief Register access to resident entry
+        /// @param handle handle returned by admit()
+        void touch(size_t handle);
+        /// @brief Register new resident entry, evicting another one if policy is full
+        /// @param key key of the new entry
+        /// @param evicted set to true if resident entry was evicted
+        /// @param victim key of evicted entry
+        /// @return handle of the new entry
+        size_t admit(const Key& key, bool& evicted, Key& victim);
+        /// @brief Forget resident entry
+        /// @param handle handle returned by admit()
+        void remove(size_t handle);
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct Slot
+        {
+            Key key {};
+            bool referenced { false };
+            size_t next_free { npos };
+        };
+
+        Array<Slot> m_slots;
+        size_t m_hand { 0 };
+        size_t m_free { npos };
+    };
+
+    /// @brief 2Q eviction policy
+    /// @details New keys enter FIFO A1in. Keys evicted from A1in are remembered in ghost
+    /// FIFO A1out, and only keys seen again while remembered are promoted to LRU Am.
+    /// One-time keys of a scan therefore never displace the hot set held in Am.
+    /// @tparam Key key type
+    template<typename Key>
+    class TwoQueuePolicy
+    {
+    public:
+        /// @param capacity maximum count of resident entries
+        explicit TwoQueuePolicy(size_t capacity);
+
+        /// @return maximum count of resident entries
+        size_t capacity() const;
+        /// @brief Forget all entries
+        void clear();
+
+        /// @brief Register access to resident entry
+        /// @param handle handle returned by admit()
+        void touch(size_t handle);
+        /// @brief Register new resident entry, evicting another one if policy is full
+        /// @param key key of the new entry
+        /// @param evicted set to true if resident entry was evicted
+        /// @param victim key of evicted entry
+        /// @return handle of the new entry
+        size_t admit(const Key& key, bool& evicted, Key& victim);
+        /// @brief Forget resident entry
+        /// @param handle handle returned by admit()
+        void remove(size_t handle);
+
+    private:
+        enum : size_t { A1in, Am, A1out, ListsCount };
+
+        CacheNodePool<Key, ListsCount> m_nodes;
+        HashTable<Key, size_t> m_ghosts;
+        size_t m_capacity;
+        size_t m_in_capacity;
+        size_t m_out_capacity;
+
+        void reclaim(bool& evicted, Key& victim);
+    };
+
+    /// @brief Adaptive replacement cache (ARC) eviction policy
+    /// @details Balances recency list T1 and frequency list T2 using ghost lists B1 and B2
+    /// of recently evicted keys. Target size of T1 adapts on ghost hits.
+    /// @tparam Key key type
+    template<typename Key>
+    class ArcPolicy
+    {
+    public:
+        /// @param capacity maximum count of resident entries
+        explicit ArcPolicy(size_t capacity);
+
+        /// @return maximum count of resident entries
+        size_t capacity() const;
+        /// @brief Forget all entries
+        void clear();
+
+        /// @brief Register access to resident entry
+        /// @param handle handle returned by admit()
+        void touch(size_t handle);
+        /// @brief Register new resident entry, evicting another one if policy is full
+        /// @param key key of the new entry
+        /// @param evicted set to true if resident entry was evicted
+        /// @param victim key of evicted entry
+        /// @return handle of the new entry
+        size_t admit(const Key& key, bool& evicted, Key& victim);
+        /// @brief Forget resident entry
+        /// @param handle handle returned by admit()
+        void remove(size_t handle);
+
+    private:
+        enum : size_t { T1, T2, B1, B2, ListsCount };
+
+        CacheNodePool<Key, ListsCount> m_nodes;
+        HashTable<Key, size_t> m_ghosts;
+        size_t m_capacity;
+        size_t m_target { 0 };      ///< Adaptive target size of T1
+
+        size_t resident() const;
+        void replace(bool ghost_in_b2, bool& evicted, Key& victim);
+        void drop_ghost(size_t list);
+    };
+
+    /// @brief Bounded key-value cache with pluggable eviction policy
+    /// @details Values are stored in HashTable, policy tracks keys by handles and chooses
+    /// which entry to evict. Policy must provide capacity(), clear(), touch(handle),
+    /// admit(key, evicted, victim) and remove(handle) (see LruPolicy).
+    /// @tparam Key key type
+    /// @tparam T cached value type
+    /// @tparam Policy eviction policy
+    template<typename Key, typename T, typename Policy>
+    class Cache : public IContainer
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using policy_type = Policy;
+
+        /// @brief Constructor
+        /// @param capacity maximum number of cached entries
+        explicit Cache(size_t capacity);
+
+        Cache(const Cache& copy) = default;                 ///< Copy constructor
+        Cache(Cache&& move) = default;                      ///< Move constructor
+
+        Cache& operator=(const Cache& copy) = default;      ///< Copy assignment operator
+        Cache& operator=(Cache&& move) = default;           ///< Move assignment operator
+
+        ~Cache() = default;                                 ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get maximum number of entries
+        /// @return maximum number of entries
+        size_t capacity() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert or update entry
+        /// @param key key of the entry
+        /// @param value value of the entry
+        /// @return true if new entry was inserted, false if existing one was updated
+        bool put(const key_type& key, const mapped_type& value);
+        /// @brief Insert or update entry
+        /// @param key key of the entry
+        /// @param value value of the entry
+        /// @return true if new entry was inserted, false if existing one was updated
+        bool put(const key_type& key, mapped_type&& value);
+
+        /// @brief Remove entry from cache
+        /// @param key key of the entry
+        /// @return true if entry was removed, false if it wasn't cached
+        bool erase(const key_type& key);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Access to cached value and register access in policy
+        /// @param key key of the entry
+        /// @return pointer to the cached value, nullptr on miss
+        pointer get(const key_type& key);
+
+        /// @brief Check if key is cached without changing policy state and statistics
+        /// @param key key of the entry
+        /// @return true if entry is cached
+        bool contains(const key_type& key) const;
+
+        /// @}
+        /// @name Statistics
+        /// @{
+
+        /// @return count of get() calls which found cached value
+        size_t hits() const;
+        /// @return count of get() calls which didn't find cached value
+        size_t misses() const;
+        /// @return count of entries removed to free space for new ones
+        size_t evictions() const;
+        /// @brief Reset hits, misses and evictions counters
+        void reset_stats();
+
+        /// @}
+
+    private:
+        struct Entry
+        {
+            T value {};
+            size_t handle { 0 };
+        };
+
+        HashTable<Key, Entry> m_table;
+        Policy m_policy;
+
+        size_t m_hits { 0 };
+        size_t m_misses { 0 };
+        size_t m_evictions { 0 };
+
+        template<typename V>
+        bool put_impl(const key_type& key, V&& value);
+    };
+
+    template<typename Key, typename T>
+    using LruPolicyCache = Cache<Key, T, LruPolicy<Key>>;       ///< Cache with LRU policy
+    template<typename Key, typename T>
+    using ClockCache = Cache<Key, T, ClockPolicy<Key>>;         ///< Cache with CLOCK policy
+    template<typename Key, typename T>
+    using TwoQueueCache = Cache<Key, T, TwoQueuePolicy<Key>>;   ///< Cache with 2Q policy
+    template<typename Key, typename T>
+    using ArcCache = Cache<Key, T, ArcPolicy<Key>>;             ///< Cache with ARC policy
+}
+
+template<typename Key, size_t Lists>
+constexpr size_t CppADS::CacheNodePool<Key, Lists>::npos;
+
+template<typename Key, size_t Lists>
+CppADS::CacheNodePool<Key, Lists>::CacheNodePool(size_t capacity)
+{
+    m_nodes.reserve(capacity);
+    for (size_t i = 0; i < capacity; i++)
+        m_nodes.push_back(Node{});
+    clear();
+}
+
+template<typename Key, size_t Lists>
+void CppADS::CacheNodePool<Key, Lists>::clear()
+{
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        m_nodes[i] = Node{};
+        m_nodes[i].next = (i + 1 < m_nodes.size()) ? i + 1 : npos;
+    }
+    m_free = (m_nodes.size() != 0) ? 0 : npos;
+
+    for (size_t list = 0; list < Lists; list++)
+    {
+        m_head[list] = npos;
+        m_tail[list] = npos;
+        m_count[list] = 0;
+    }
+}
+
+template<typename Key, size_t Lists>
+size_t CppADS::CacheNodePool<Key, Lists>::acquire(const Key& key)
+{
+    size_t index = m_free;
+    Node& node = m_nodes[index];
+    m_free = node.next;
+
+    node.key = key;
+    node.next = npos;
+    return index;
+}
+
+template<typename Key, size_t Lists>
+void CppADS::CacheNodePool<Key, Lists>::release(size_t index)
+{
+    Node& node = m_nodes[index];
+    node.key = Key{};
+    node.next = m_free;
+    m_free = index;
+}
+
+template<typename Key, size_t Lists>
+void CppADS::CacheNodePool<Key, Lists>::push_front(size_t list, size_t index)
+{
+    Node& node = m_nodes[index];
+    node.list = list;
+    node.prev = npos;
+    node.next = m_head[list];
+    if (m_head[list] != npos)
+        m_nodes[m_head[list]].prev = index;
+    else
+        m_tail[list] = index;
+    m_head[list] = index;
+    m_count[list]++;
+}
+
+template<typename Key, size_t Lists>
+void CppADS::CacheNodePool<Key, Lists>::unlink(size_t index)
+{
+    Node& node = m_nodes[index];
+    if (node.prev != npos)
+        m_nodes[node.prev].next = node.next;
+    else
+        m_head[node.list] = node.next;
+
+    if (node.next != npos)
+        m_nodes[node.next].prev = node.prev;
+    else
+        m_tail[node.list] = node.prev;
+
+    m_count[node.list]--;
+    node.list = npos;
+    node.prev = npos;
+    node.next = npos;
+}
+
+template<typename Key, size_t Lists>
+void CppADS::CacheNodePool<Key, Lists>::move_front(size_t list, size_t index)
+{
+    if (m_head[list] == index)
+        return;
+    unlink(index);
+    push_front(list, index);
+}
+
+template<typename Key, size_t Lists>
+size_t CppADS::CacheNodePool<Key, Lists>::back(size_t list) const
+{
+    return m_tail[list];
+}
+
+template<typename Key, size_t Lists>
+size_t CppADS::CacheNodePool<Key, Lists>::size(size_t list) const
+{
+    return m_count[list];
+}
+
+template<typename Key, size_t Lists>
+size_t CppADS::CacheNodePool<Key, Lists>::list(size_t index) const
+{
+    return m_nodes[index].list;
+}
+
+template<typename Key, size_t Lists>
+const Key& CppADS::CacheNodePool<Key, Lists>::key(size_t index) const
+{
+    return m_nodes[index].key;
+}
+
+template<typename Key>
+CppADS::LruPolicy<Key>::LruPolicy(size_t capacity)
+    : m_nodes(capacity), m_capacity(capacity)
+{}
+
+template<typename Key>
+size_t CppADS::LruPolicy<Key>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename Key>
+void CppADS::LruPolicy<Key>::clear()
+{
+    m_nodes.clear();
+}
+
+template<typename Key>
+void CppADS::LruPolicy<Key>::touch(size_t handle)
+{
+    m_nodes.move_front(0, handle);
+}
+
+template<typename Key>
+size_t CppADS::LruPolicy<Key>::admit(const Key& key, bool& evicted, Key& victim)
+{
+    evicted = false;
+    if (m_nodes.size(0) >= m_capacity)
+    {
+        size_t lru = m_nodes.back(0);
+        victim = m_nodes.key(lru);
+        evicted = true;
+        m_nodes.unlink(lru);
+        m_nodes.release(lru);
+    }
+
+    size_t index = m_nodes.acquire(key);
+    m_nodes.push_front(0, index);
+    return index;
+}
+
+template<typename Key>
+void CppADS::LruPolicy<Key>::remove(size_t handle)
+{
+    m_nodes.unlink(handle);
+    m_nodes.release(handle);
+}
+
+template<typename Key>
+constexpr size_t CppADS::ClockPolicy<Key>::npos;
+
+template<typename Key>
+CppADS::ClockPolicy<Key>::ClockPolicy(size_t capacity)
+{
+    m_slots.reserve(capacity);
+    for (size_t i = 0; i < capacity; i++)
+        m_slots.push_back(Slot{});
+    clear();
+}
+
+template<typename Key>
+size_t CppADS::ClockPolicy<Key>::capacity() const
+{
+    return m_slots.size();
+}
+
+template<typename Key>
+void CppADS::ClockPolicy<Key>::clear()
+{
+    for (size_t i = 0; i < m_slots.size(); i++)
+    {
+        m_slots[i] = Slot{};
+        m_slots[i].next_free = (i + 1 < m_slots.size()) ? i + 1 : npos;
+    }
+    m_free = (m_slots.size() != 0) ? 0 : npos;
+    m_hand = 0;
+}
+
+template<typename Key>
+void CppADS::ClockPolicy<Key>::touch(size_t handle)
+{
+    m_slots[handle].referenced = true;
+}
+
+template<typename Key>
+size_t CppADS::ClockPolicy<Key>::admit(const Key& key, bool& evicted, Key& victim)
+{
+    evicted = false;
+    size_t index = m_free;
+    if (index != npos)
+    {
+        m_free = m_slots[index].next_free;
+    }
+    else
+    {
+        while (m_slots[m_hand].referenced)
+        {
+            m_slots[m_hand].referenced = false;
+            m_hand = (m_hand + 1 < m_slots.size()) ? m_hand + 1 : 0;
+        }
+        index = m_hand;
+        m_hand = (m_hand + 1 < m_slots.size()) ? m_hand + 1 : 0;
+
+        victim = m_slots[index].key;
+        evicted = true;
+    }
+
+    Slot& slot = m_slots[index];
+    slot.key = key;
+    slot.referenced = false;
+    slot.next_free = npos;
+    return index;
+}
+
+template<typename Key>
+void CppADS::ClockPolicy<Key>::remove(size_t handle)
+{
+    Slot& slot = m_slots[handle];
+    slot.key = Key{};
+    slot.referenced = false;
+    slot.next_free = m_free;
+    m_free = handle;
+}
+
+template<typename Key>
+CppADS::TwoQueuePolicy<Key>::TwoQueuePolicy(size_t capacity)
+    : m_nodes(capacity + std::max<size_t>(capacity / 2, 1)),
+      m_capacity(capacity),
+      m_in_capacity(std::max<size_t>(capacity / 4, 1)),
+      m_out_capacity(std::max<size_t>(capacity / 2, 1))
+{
+    m_ghosts.reserve(m_out_capacity);
+}
+
+template<typename Key>
+size_t CppADS::TwoQueuePolicy<Key>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename Key>
+void CppADS::TwoQueuePolicy<Key>::clear()
+{
+    m_nodes.clear();
+    m_ghosts.clear();
+}
+
+template<typename Key>
+void CppADS::TwoQueuePolicy<Key>::touch(size_t handle)
+{
+    if (m_nodes.list(handle) == Am)
+        m_nodes.move_front(Am, handle);
+}
+
+template<typename Key>
+size_t CppADS::TwoQueuePolicy<Key>::admit(const Key& key, bool& evicted, Key& victim)
+{
+    evicted = false;
+    size_t target = A1in;
+
+    auto ghost = m_ghosts.find(key);
+    if (ghost != m_ghosts.end())
+    {
+        size_t index = ghost->second;
+        m_ghosts.remove(key);
+        m_nodes.unlink(index);
+        m_nodes.release(index);
+        target = Am;
+    }
+
+    if (m_nodes.size(A1in) + m_nodes.size(Am) >= m_capacity)
+        reclaim(evicted, victim);
+
+    size_t index = m_nodes.acquire(key);
+    m_nodes.push_front(target, index);
+    return index;
+}
+
+template<typename Key>
+void CppADS::TwoQueuePolicy<Key>::remove(size_t handle)
+{
+    m_nodes.unlink(handle);
+    m_nodes.release(handle);
+}
+
+template<typename Key>
+void CppADS::TwoQueuePolicy<Key>::reclaim(bool& evicted, Key& victim)
+{
+    if (m_nodes.size(A1in) > m_in_capacity || m_nodes.size(Am) == 0)
+    {
+        size_t lru = m_nodes.back(A1in);
+        victim = m_nodes.key(lru);
+        evicted = true;
+        m_nodes.unlink(lru);
+        m_nodes.push_front(A1out, lru);
+        m_ghosts.insert({victim, lru});
+
+        if (m_nodes.size(A1out) > m_out_capacity)
+        {
+            size_t oldest = m_nodes.back(A1out);
+            m_ghosts.remove(m_nodes.key(oldest));
+            m_nodes.unlink(oldest);
+            m_nodes.release(oldest);
+        }
+    }
+    else
+    {
+        size_t lru = m_nodes.back(Am);
+        victim = m_nodes.key(lru);
+        evicted = true;
+        m_nodes.unlink(lru);
+        m_nodes.release(lru);
+    }
+}
+
+template<typename Key>
+CppADS::ArcPolicy<Key>::ArcPolicy(size_t capacity)
+    : m_nodes(capacity * 2), m_capacity(capacity)
+{
+    m_ghosts.reserve(capacity);
+}
+
+template<typename Key>
+size_t CppADS::ArcPolicy<Key>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename Key>
+void CppADS::ArcPolicy<Key>::clear()
+{
+    m_nodes.clear();
+    m_ghosts.clear();
+    m_target = 0;
+}
+
+template<typename Key>
+void CppADS::ArcPolicy<Key>::touch(size_t handle)
+{
+    m_nodes.move_front(T2, handle);
+}
+
+template<typename Key>
+size_t CppADS::ArcPolicy<Key>::admit(const Key& key, bool& evicted, Key& victim)
+{
+    evicted = false;
+
+    auto ghost = m_ghosts.find(key);
+    if (ghost != m_ghosts.end())
+    {
+        size_t index = ghost->second;
+        bool in_b2 = (m_nodes.list(index) == B2);
+        size_t b1 = m_nodes.size(B1);
+        size_t b2 = m_nodes.size(B2);
+
+        if (in_b2)
+        {
+            size_t delta = std::max<size_t>(b1 / b2, 1);
+            m_target = (m_target > delta) ? m_target - delta : 0;
+        }
+        else
+        {
+            size_t delta = std::max<size_t>(b2 / b1, 1);
+            m_target = std::min(m_capacity, m_target + delta);
+        }
+
+        m_ghosts.remove(key);
+        m_nodes.unlink(index);
+        if (resident() >= m_capacity)
+            replace(in_b2, evicted, victim);
+        m_nodes.push_front(T2, index);
+        return index;
+    }
+
+    size_t l1 = m_nodes.size(T1) + m_nodes.size(B1);
+    if (l1 >= m_capacity)
+    {
+        if (m_nodes.size(T1) < m_capacity)
+        {
+            drop_ghost(B1);
+            if (resident() >= m_capacity)
+                replace(false, evicted, victim);
+        }
+        else
+        {
+            size_t lru = m_nodes.back(T1);
+            victim = m_nodes.key(lru);
+            evicted = true;
+            m_nodes.unlink(lru);
+            m_nodes.release(lru);
+        }
+    }
+    else
+    {
+        size_t total = l1 + m_nodes.size(T2) + m_nodes.size(B2);
+        if (total >= m_capacity)
+        {
+            if (total >= 2 * m_capacity)
+                drop_ghost(B2);
+            if (resident() >= m_capacity)
+                replace(false, evicted, victim);
+        }
+    }
+
+    size_t index = m_nodes.acquire(key);
+    m_nodes.push_front(T1, index);
+    return index;
+}
+
+template<typename Key>
+void CppADS::ArcPolicy<Key>::remove(size_t handle)
+{
+    m_nodes.unlink(handle);
+    m_nodes.release(handle);
+}
+
+template<typename Key>
+size_t CppADS::ArcPolicy<Key>::resident() const
+{
+    return m_nodes.size(T1) + m_nodes.size(T2);
+}
+
+template<typename Key>
+void CppADS::ArcPolicy<Key>::replace(bool ghost_in_b2, bool& evicted, Key& victim)
+{
+    size_t t1 = m_nodes.size(T1);
+    bool from_t1 = (t1 != 0) && ((ghost_in_b2 && t1 == m_target) || t1 > m_target || m_nodes.size(T2) == 0);
+
+    size_t lru = m_nodes.back(from_t1 ? T1 : T2);
+    victim = m_nodes.key(lru);
+    evicted = true;
+    m_nodes.unlink(lru);
+    m_nodes.push_front(from_t1 ? B1 : B2, lru);
+    m_ghosts.insert({victim, lru});
+}
+
+template<typename Key>
+void CppADS::ArcPolicy<Key>::drop_ghost(size_t list)
+{
+    size_t lru = m_nodes.back(list);
+    m_ghosts.remove(m_nodes.key(lru));
+    m_nodes.unlink(lru);
+    m_nodes.release(lru);
+}
+
+template<typename Key, typename T, typename Policy>
+CppADS::Cache<Key, T, Policy>::Cache(size_t capacity)
+    : m_policy(capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("CppADS::Cache<Key, T, Policy>::Cache: capacity must be positive");
+
+    m_table.reserve(capacity);
+}
+
+template<typename Key, typename T, typename Policy>
+size_t CppADS::Cache<Key, T, Policy>::size() const
+{
+    return m_table.size();
+}
+
+template<typename Key, typename T, typename Policy>
+size_t CppADS::Cache<Key, T, Policy>::capacity() const
+{
+    return m_policy.capacity();
+}
+
+template<typename Key, typename T, typename Policy>
+void CppADS::Cache<Key, T, Policy>::clear()
+{
+    m_table.clear();
+    m_policy.clear();
+}
+
+template<typename Key, typename T, typename Policy>
+bool CppADS::Cache<Key, T, Policy>::put(const key_type& key, const mapped_type& value)
+{
+    return put_impl(key, value);
+}
+
+template<typename Key, typename T, typename Policy>
+bool CppADS::Cache<Key, T, Policy>::put(const key_type& key, mapped_type&& value)
+{
+    return put_impl(key, std::move(value));
+}
+
+template<typename Key, typename T, typename Policy>
+template<typename V>
+bool CppADS::Cache<Key, T, Policy>::put_impl(const key_type& key, V&& value)
+{
+    auto item = m_table.find(key);
+    if (item != m_table.end())
+    {
+        item->second.value = std::forward<V>(value);
+        m_policy.touch(item->second.handle);
+        return false;
+    }
+
+    bool evicted = false;
+    Key victim {};
+    size_t handle = m_policy.admit(key, evicted, victim);
+    if (evicted)
+    {
+        m_table.remove(victim);
+        m_evictions++;
+    }
+
+    m_table.insert({key, Entry{std::forward<V>(value), handle}});
+    return true;
+}
+
+template<typename Key, typename T, typename Policy>
+bool CppADS::Cache<Key, T, Policy>::erase(const key_type& key)
+{
+    auto item = m_table.find(key);
+    if (item == m_table.end())
+        return false;
+
+    m_policy.remove(item->second.handle);
+    m_table.remove(key);
+    return true;
+}
+
+template<typename Key, typename T, typename Policy>
+typename CppADS::Cache<Key, T, Policy>::pointer CppADS::Cache<Key, T, Policy>::get(const key_type& key)
+{
+    auto item = m_table.find(key);
+    if (item == m_table.end())
+    {
+        m_misses++;
+        return nullptr;
+    }
+
+    m_hits++;
+    m_policy.touch(item->second.handle);
+    return &(item->second.value);
+}
+
+template<typename Key, typename T, typename Policy>
+bool CppADS::Cache<Key, T, Policy>::contains(const key_type& key) const
+{
+    return m_table.find(key) != m_table.end();
+}
+
+template<typename Key, typename T, typename Policy>
+size_t CppADS::Cache<Key, T, Policy>::hits() const
+{
+    return m_hits;
+}
+
+template<typename Key, typename T, typename Policy>
+size_t CppADS::Cache<Key, T, Policy>::misses() const
+{
+    return m_misses;
+}
+
+template<typename Key, typename T, typename Policy>
+size_t CppADS::Cache<Key, T, Policy>::evictions() const
+{
+    return m_evictions;
+}
+
+template<typename Key, typename T, typename Policy>
+void CppADS::Cache<Key, T, Policy>::reset_stats()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+#endif //CACHE_HPP
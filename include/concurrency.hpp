@@ -0,0 +1,125 @@
+#ifndef CONCURRENCY_HPP
+#define CONCURRENCY_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <thread>
+
+namespace CppADS
+{
+    /// @brief Assumed size of cache line
+    /// @details Independently modified shared data is aligned by this value to avoid false sharing.
+    constexpr size_t CacheLineSize = 64;
+
+    /// @brief Create objects aligned by alignof(T) on the heap
+    /// @details Before C++17 plain new only guarantees alignment of max_align_t, so
+    /// types aligned by CacheLineSize would get no cache line of their own. Count of
+    /// objects and the allocated address are kept just before the first object.
+    /// @tparam T type of objects, default constructible
+    /// @param count count of objects
+    /// @return pointer to the first object, release it with aligned_delete
+    template<typename T>
+    T* aligned_new(size_t count = 1)
+    {
+        const size_t header = 2 * sizeof(size_t);
+        const size_t alignment = alignof(T) > header ? alignof(T) : header;
+        char* raw = static_cast<char*>(::operator new(header + alignment + count * sizeof(T)));
+        uintptr_t address = (reinterpret_cast<uintptr_t>(raw) + header + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        T* objects = reinterpret_cast<T*>(address);
+
+        size_t created = 0;
+        try
+        {
+            for (; created < count; created++)
+                new (objects + created) T();
+        }
+        catch (...)
+        {
+            while (created != 0)
+                objects[--created].~T();
+            ::operator delete(raw);
+            throw;
+        }
+
+        size_t* fields = reinterpret_cast<size_t*>(address) - 2;
+        fields[0] = count;
+        fields[1] = reinterpret_cast<uintptr_t>(raw);
+        return objects;
+    }
+
+    /// @brief Destroy objects created by aligned_new
+    /// @param objects pointer returned by aligned_new or nullptr
+    template<typename T>
+    void aligned_delete(T* objects)
+    {
+        if (objects == nullptr)
+            return;
+        size_t* fields = reinterpret_cast<size_t*>(objects) - 2;
+        size_t count = fields[0];
+        void* raw = reinterpret_cast<void*>(fields[1]);
+        while (count != 0)
+            objects[--count].~T();
+        ::operator delete(raw);
+    }
+
+    /// @brief Deleter of std::unique_ptr for objects created by aligned_new
+    struct AlignedDelete
+    {
+        template<typename T>
+        void operator()(T* objects) const { aligned_delete(objects); }
+    };
+
+    /// @brief Hint processor that calling thread is spinning in a busy-wait loop
+    inline void cpu_relax()
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /// @brief Exponential backoff for busy-wait loops
+    /// @details Spins with growing count of cpu_relax() calls and then falls back to
+    /// yielding the time slice, so waiting thread doesn't starve the one it waits for
+    /// when there are more threads than cores.
+    class Backoff
+    {
+    public:
+        /// @brief Wait before the next attempt
+        void pause()
+        {
+            if (m_step < SpinLimit)
+            {
+                for (unsigned i = 0; i < (1u << m_step); i++)
+                    cpu_relax();
+                m_step++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        /// @brief Start waiting from the shortest spin again
+        void reset()
+        {
+            m_step = 0;
+        }
+
+        /// @return true if backoff has switched to yielding
+        bool exhausted() const
+        {
+            return m_step >= SpinLimit;
+        }
+
+    private:
+        static constexpr unsigned SpinLimit = 6;    ///< Spins up to 2^SpinLimit times before yielding
+        unsigned m_step { 0 };
+    };
+}
+
+#endif //CONCURRENCY_HPP
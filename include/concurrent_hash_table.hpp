@@ -0,0 +1,396 @@
+#ifndef CONCURRENT_HASH_TABLE_HPP
+#define CONCURRENT_HASH_TABLE_HPP
+
+#include "array.hpp"
+#include "concurrency.hpp"
+#include "hash_mix.hpp"
+#include "hash_chains.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Hash table for concurrent access from many threads
+    /// @details Items are split between independent shards, every shard is a HashChains
+    /// core (the one of HashTable) guarded by its own mutex. Shard is chosen by the high
+    /// bits of the mixed hash while the chains take bucket index from the low bits, so
+    /// keys of one shard still spread over all its buckets. The key is hashed once per
+    /// operation, the same hash selects the shard and the bucket. Operations on different
+    /// shards never contend.
+    ///
+    /// Every operation on a single key is atomic: it holds the lock of the key's shard
+    /// from lookup to modification, and callbacks passed to upsert, compute_if_absent and
+    /// erase_if run under that lock. Callbacks must not call back into the table.
+    /// Whole-table operations (size, clear, for_each, erase_if with a predicate only)
+    /// visit shards one by one and never hold more than one lock.
+    /// @tparam Key hashed key type
+    /// @tparam T stored value type
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ConcurrentHashTable
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<key_type, mapped_type>;
+
+        /// @brief Default count of shards
+        static constexpr size_t DefaultShardCount = 64;
+
+        /// @brief Constructor
+        /// @param shard_count count of independently locked shards
+        /// @throw std::invalid_argument if shard_count is zero
+        explicit ConcurrentHashTable(size_t shard_count = DefaultShardCount);
+
+        ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+        ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of items
+        /// @details Exact only when there are no concurrent modifications
+        /// @return item's count
+        size_t size() const;
+
+        /// @return true if table has no items
+        bool empty() const;
+
+        /// @return count of shards
+        size_t shard_count() const { return m_shard_count; }
+
+        /// @brief Remove all items, shard by shard
+        void clear();
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Insert item if its key is missing
+        /// @param value inserted item
+        /// @return true if item was inserted
+        bool insert(const value_type& value);
+
+        /// @brief Insert item or replace value of existing one
+        /// @param key item's key
+        /// @param value new value
+        /// @return true if item was inserted, false if assigned
+        template<typename M>
+        bool insert_or_assign(const key_type& key, M&& value);
+
+        /// @brief Update existing item or insert a new one
+        /// @param key item's key
+        /// @param update function called as update(mapped_type&) if key is present
+        /// @param value value of inserted item if key is missing
+        /// @return true if item was inserted, false if updated
+        template<typename F, typename M>
+        bool upsert(const key_type& key, F update, M&& value);
+
+        /// @brief Get value of item, computing and inserting it if key is missing
+        /// @param key item's key
+        /// @param compute function called as compute(key) only if key is missing
+        /// @return copy of value
+        template<typename F>
+        mapped_type compute_if_absent(const key_type& key, F compute);
+
+        /// @brief Remove item
+        /// @param key item's key
+        /// @return true if item was removed
+        bool remove(const key_type& key);
+
+        /// @brief Remove item if its value satisfies predicate
+        /// @param key item's key
+        /// @param predicate function called as predicate(const mapped_type&)
+        /// @return true if item was removed
+        template<typename Predicate>
+        bool erase_if(const key_type& key, Predicate predicate);
+
+        /// @brief Remove all items which satisfy predicate, shard by shard
+        /// @param predicate function called as predicate(const value_type&)
+        /// @return count of removed items
+        template<typename Predicate>
+        size_t erase_if(Predicate predicate);
+
+        /// @}
+        /// @name Lookup
+        /// @{
+
+        /// @brief Copy value of item
+        /// @param key item's key
+        /// @param value destination, unchanged if key is missing
+        /// @return true if item was found
+        bool find(const key_type& key, mapped_type& value) const;
+
+        /// @brief Check if table has item with key
+        /// @param key item's key
+        /// @return true if item is found
+        bool contains(const key_type& key) const;
+
+        /// @brief Visit all items, shard by shard
+        /// @details Only the lock of visited shard is held, items of other shards may
+        /// change meanwhile.
+        /// @param function function called as function(const key_type&, mapped_type&)
+        template<typename F>
+        void for_each(F function);
+
+        /// @brief Visit all items, shard by shard
+        /// @param function function called as function(const value_type&)
+        template<typename F>
+        void for_each(F function) const;
+
+        /// @}
+
+    private:
+        using Table = HashChains<value_type, PairKeyOf, Hash, KeyEqual, MaskReduction, false>;
+        using Node = typename Table::Node;
+        using Position = typename Table::Position;
+
+        /// @private
+        struct alignas(CacheLineSize) Shard
+        {
+            mutable std::mutex mutex;
+            Table table;
+        };
+
+        std::unique_ptr<Shard[], AlignedDelete> m_shards;   ///< Created by aligned_new, plain new ignores alignas before C++17
+        size_t m_shard_count { 0 };
+        Hash m_hash {};
+
+        /// @brief Get mixed hash of the key
+        size_t hash(const key_type& key) const { return hash_mix(m_hash(key)); }
+        /// @brief Get shard of the mixed hash
+        Shard& shard(size_t hash) const;
+    };
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr size_t CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::DefaultShardCount;
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::ConcurrentHashTable(size_t shard_count)
+{
+    if (shard_count == 0)
+        throw std::invalid_argument("CppADS::ConcurrentHashTable: shard count must be positive");
+    m_shards.reset(aligned_new<Shard>(shard_count));
+    m_shard_count = shard_count;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::size() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+        count += m_shards[i].table.size();
+    }
+    return count;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::empty() const
+{
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+        if (m_shards[i].table.size() != 0)
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::clear()
+{
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        // Old nodes are freed outside of the lock
+        Table removed;
+        {
+            std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+            std::swap(removed, m_shards[i].table);
+        }
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::insert(const value_type& value)
+{
+    size_t key_hash = hash(value.first);
+    Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    target.table.step();
+    Position position = target.table.locate(value.first, key_hash);
+    if (position.found())
+        return false;
+    target.table.attach(position, std::unique_ptr<Node>(new Node(value)));
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename M>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::insert_or_assign(const key_type& key, M&& value)
+{
+    size_t key_hash = hash(key);
+    Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    target.table.step();
+    Position position = target.table.locate(key, key_hash);
+    if (position.found())
+    {
+        (*position.link)->value.second = std::forward<M>(value);
+        return false;
+    }
+    target.table.attach(position, std::unique_ptr<Node>(new Node(key, std::forward<M>(value))));
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F, typename M>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::upsert(const key_type& key, F update, M&& value)
+{
+    size_t key_hash = hash(key);
+    Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    target.table.step();
+    Position position = target.table.locate(key, key_hash);
+    if (position.found())
+    {
+        update((*position.link)->value.second);
+        return false;
+    }
+    target.table.attach(position, std::unique_ptr<Node>(new Node(key, std::forward<M>(value))));
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F>
+typename CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::mapped_type CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::compute_if_absent(const key_type& key, F compute)
+{
+    size_t key_hash = hash(key);
+    Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    target.table.step();
+    Position position = target.table.locate(key, key_hash);
+    if (!position.found())
+        position = target.table.attach(position, std::unique_ptr<Node>(new Node(key, compute(key))));
+    return (*position.link)->value.second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::remove(const key_type& key)
+{
+    return erase_if(key, [](const mapped_type&) { return true; });
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename Predicate>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::erase_if(const key_type& key, Predicate predicate)
+{
+    size_t key_hash = hash(key);
+    Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    target.table.step();
+    Position position = target.table.locate(key, key_hash);
+    if (!position.found() || !predicate(static_cast<const mapped_type&>((*position.link)->value.second)))
+        return false;
+    target.table.detach(position);
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename Predicate>
+size_t CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::erase_if(Predicate predicate)
+{
+    size_t removed = 0;
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+        Table& table = m_shards[i].table;
+
+        // Chains are unlinked in place, detach moves the link to the next node
+        for (size_t t = 0; t < Table::TableCount; t++)
+        {
+            auto& buckets = table.table(t);
+            for (size_t b = 0; b < buckets.size(); b++)
+            {
+                Position position { t, b, 0, &buckets[b] };
+                while (*position.link)
+                {
+                    if (predicate(static_cast<const value_type&>((*position.link)->value)))
+                    {
+                        table.detach(position);
+                        removed++;
+                    }
+                    else
+                        position.link = &(*position.link)->next;
+                }
+            }
+        }
+    }
+    return removed;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key, mapped_type& value) const
+{
+    size_t key_hash = hash(key);
+    const Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    Position position = target.table.locate(key, key_hash);
+    if (!position.found())
+        return false;
+    value = (*position.link)->value.second;
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    size_t key_hash = hash(key);
+    const Shard& target = shard(key_hash);
+    std::lock_guard<std::mutex> lock(target.mutex);
+    return target.table.locate(key, key_hash).found();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F>
+void CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::for_each(F function)
+{
+    using Iterator = HashChainsIterator<Table, Node, value_type>;
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+        Table& table = m_shards[i].table;
+        for (Iterator it(&table, 0, 0, nullptr); it != Iterator(); ++it)
+            function(static_cast<const key_type&>(it->first), it->second);
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F>
+void CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::for_each(F function) const
+{
+    using Iterator = HashChainsIterator<const Table, const Node, const value_type>;
+    for (size_t i = 0; i < m_shard_count; i++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+        const Table& table = m_shards[i].table;
+        for (Iterator it(&table, 0, 0, nullptr); it != Iterator(); ++it)
+            function(*it);
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::Shard& CppADS::ConcurrentHashTable<Key, T, Hash, KeyEqual>::shard(size_t hash) const
+{
+    // High bits of the hash, low ones select the bucket inside the shard
+    return m_shards[FastRangeReduction::reduce(hash, m_shard_count)];
+}
+
+#endif //CONCURRENT_HASH_TABLE_HPP
@@ -0,0 +1,461 @@
+#ifndef CONCURRENT_QUEUE_HPP
+#define CONCURRENT_QUEUE_HPP
+
+#include "concurrency.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace CppADS
+{
+    /// @brief Unbounded FIFO queue for multiple producers and multiple consumers
+    /// @details Each producer works through its own Producer handle which owns a sub-queue,
+    /// so producers never contend with each other. Sub-queue is a chain of fixed-size
+    /// segments: producer writes values into the tail segment and publishes them with
+    /// a single release store of its tail counter, no matter how many values were written.
+    /// Consumers visit sub-queues in turn, take a sub-queue with try-lock (skipping busy
+    /// ones) and move out everything they need after one acquire load of the tail counter.
+    ///
+    /// Drained segments go back to the producer of their sub-queue, so in the steady state
+    /// neither side allocates. Values of one producer are dequeued in the order they were
+    /// enqueued; there is no ordering between different producers.
+    /// @tparam T value type stored in the container
+    template<typename T>
+    class ConcurrentQueue
+    {
+        struct SubQueue;
+
+    public:
+        using value_type = T;
+
+        class Producer;
+
+        ConcurrentQueue() = default;                    ///< Default constructor
+
+        ConcurrentQueue(const ConcurrentQueue&) = delete;
+        ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
+        ~ConcurrentQueue();                             ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of elements
+        /// @details Exact only when there are no concurrent operations
+        /// @return element's count
+        size_t size() const;
+
+        /// @return true if queue has no elements
+        bool empty() const;
+
+        /// @brief Get count of allocated slots (including recycled segments)
+        /// @return slots count
+        size_t capacity() const;
+
+        /// @}
+        /// @name Producers
+        /// @{
+
+        /// @brief Get handle for enqueueing values
+        /// @details Sub-queue of destroyed handle is given to the next created one
+        /// @return handle which must not outlive the queue
+        Producer make_producer();
+
+        /// @}
+        /// @name Consumers
+        /// @{
+
+        /// @brief Move front value of some producer out of queue
+        /// @param value destination
+        /// @return false if queue is empty or all non-empty sub-queues are busy
+        bool try_dequeue(T& value);
+
+        /// @brief Move several values out of queue
+        /// @param out output iterator receiving removed values
+        /// @param count maximum count of removed values
+        /// @return count of removed values
+        template<typename OutputIt>
+        size_t try_dequeue_bulk(OutputIt out, size_t count);
+
+        /// @}
+
+    private:
+        /// @private
+        /// @brief Segment size calculation function
+        /// @return power of two elements count fitting into 4KiB (at least 16)
+        static constexpr size_t calc_segment_size()
+        {
+            size_t size = 16;
+            while (size * 2 * sizeof(T) <= 4096)
+                size *= 2;
+            return size;
+        }
+
+        static constexpr size_t segment_size = calc_segment_size();
+
+        /// @private
+        /// @brief Fixed-size part of sub-queue
+        struct Segment
+        {
+            T values[segment_size];
+            Segment* next { nullptr };                      ///< Next segment of the chain
+            Segment* next_free { nullptr };                 ///< Next segment of the free list
+            std::unique_ptr<Segment> next_allocated;        ///< Ownership list of sub-queue
+        };
+
+        /// @private
+        /// @brief Queue of the single producer
+        struct SubQueue
+        {
+            SubQueue();
+            ~SubQueue();
+
+            // Producer side
+            alignas(CacheLineSize) std::atomic<size_t> tail { 0 };  ///< Count of published values
+            Segment* tail_segment { nullptr };                      ///< Segment of the next value
+            Segment* free_segments { nullptr };                     ///< Producer's free list
+            std::unique_ptr<Segment> allocated;                     ///< All segments of sub-queue
+            std::atomic<size_t> allocated_count { 0 };              ///< Count of allocated segments
+
+            // Consumer side
+            alignas(CacheLineSize) std::atomic<size_t> head { 0 };  ///< Count of removed values
+            Segment* head_segment { nullptr };                      ///< Segment of the front value
+            std::atomic<bool> locked { false };                     ///< Consumer's lock
+
+            alignas(CacheLineSize) std::atomic<Segment*> recycled { nullptr };  ///< Drained segments
+            std::atomic<bool> active { true };                      ///< Sub-queue has a producer
+            SubQueue* next { nullptr };                             ///< Next sub-queue of the queue
+
+            /// @brief Get empty segment, recycled if possible
+            Segment* acquire_segment();
+
+            /// @brief Move values out under consumer's lock
+            template<typename OutputIt>
+            size_t pop(OutputIt& out, size_t count);
+        };
+
+        alignas(CacheLineSize) std::atomic<SubQueue*> m_sub_queues { nullptr };  ///< List of sub-queues
+        std::atomic<SubQueue*> m_consumer_hint { nullptr };     ///< Sub-queue to visit first
+    };
+
+    /// @brief Handle for enqueueing values into ConcurrentQueue
+    /// @details Handle must be used by one thread at a time
+    template<typename T>
+    class ConcurrentQueue<T>::Producer
+    {
+        friend class ConcurrentQueue;
+
+    public:
+        Producer(Producer&& move);                      ///< Move constructor
+        Producer& operator=(Producer&& move);           ///< Move assignment operator
+
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        ~Producer();                                    ///< Destructor
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        void enqueue(const T& value);
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        void enqueue(T&& value);
+
+        /// @brief Construct value in the tail of queue
+        /// @param args arguments of value's constructor
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        /// @brief Add range of values to tail of queue and publish them at once
+        /// @param first iterator to the first added value
+        /// @param last iterator to the element after the last added value
+        template<typename InputIt>
+        void enqueue_bulk(InputIt first, InputIt last);
+
+    private:
+        SubQueue* m_queue { nullptr };
+
+        explicit Producer(SubQueue* queue) : m_queue(queue) {}
+
+        /// @private
+        /// @brief Get slot for the value with given position, switching tail segment if needed
+        T& slot(size_t position);
+    };
+}
+
+template<typename T>
+constexpr size_t CppADS::ConcurrentQueue<T>::segment_size;
+
+template<typename T>
+CppADS::ConcurrentQueue<T>::SubQueue::SubQueue()
+{
+    tail_segment = acquire_segment();
+    head_segment = tail_segment;
+}
+
+template<typename T>
+CppADS::ConcurrentQueue<T>::SubQueue::~SubQueue()
+{
+    // Unlinked one by one to avoid deep recursion of unique_ptr destructors
+    while (allocated != nullptr)
+    {
+        std::unique_ptr<Segment> next = std::move(allocated->next_allocated);
+        allocated = std::move(next);
+    }
+}
+
+template<typename T>
+typename CppADS::ConcurrentQueue<T>::Segment* CppADS::ConcurrentQueue<T>::SubQueue::acquire_segment()
+{
+    if (free_segments == nullptr)
+        free_segments = recycled.exchange(nullptr, std::memory_order_acquire);
+
+    Segment* segment = free_segments;
+    if (segment != nullptr)
+    {
+        free_segments = segment->next_free;
+    }
+    else
+    {
+        std::unique_ptr<Segment> created = std::make_unique<Segment>();
+        segment = created.get();
+        created->next_allocated = std::move(allocated);
+        allocated = std::move(created);
+        allocated_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    segment->next = nullptr;
+    segment->next_free = nullptr;
+    return segment;
+}
+
+template<typename T>
+template<typename OutputIt>
+size_t CppADS::ConcurrentQueue<T>::SubQueue::pop(OutputIt& out, size_t count)
+{
+    size_t position = head.load(std::memory_order_relaxed);
+    count = std::min(count, tail.load(std::memory_order_acquire) - position);
+
+    Segment* drained = nullptr;
+    Segment* drained_last = nullptr;
+    for (size_t i = 0; i < count; i++, position++, ++out)
+    {
+        size_t offset = position & (segment_size - 1);
+        if (offset == 0 && position != 0)
+        {
+            Segment* segment = head_segment;
+            head_segment = segment->next;
+            segment->next_free = drained;
+            drained = segment;
+            if (drained_last == nullptr)
+                drained_last = segment;
+        }
+        *out = std::move(head_segment->values[offset]);
+    }
+    head.store(position, std::memory_order_relaxed);
+
+    if (drained != nullptr)
+    {
+        Segment* top = recycled.load(std::memory_order_relaxed);
+        do
+        {
+            drained_last->next_free = top;
+        }
+        while (!recycled.compare_exchange_weak(top, drained, std::memory_order_release, std::memory_order_relaxed));
+    }
+    return count;
+}
+
+template<typename T>
+CppADS::ConcurrentQueue<T>::~ConcurrentQueue()
+{
+    SubQueue* sub_queue = m_sub_queues.load(std::memory_order_relaxed);
+    while (sub_queue != nullptr)
+    {
+        SubQueue* next = sub_queue->next;
+        aligned_delete(sub_queue);
+        sub_queue = next;
+    }
+}
+
+template<typename T>
+size_t CppADS::ConcurrentQueue<T>::size() const
+{
+    size_t count = 0;
+    for (SubQueue* sub_queue = m_sub_queues.load(std::memory_order_acquire); sub_queue != nullptr; sub_queue = sub_queue->next)
+    {
+        size_t head = sub_queue->head.load(std::memory_order_relaxed);
+        size_t tail = sub_queue->tail.load(std::memory_order_acquire);
+        count += (tail >= head) ? tail - head : 0;
+    }
+    return count;
+}
+
+template<typename T>
+bool CppADS::ConcurrentQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T>
+size_t CppADS::ConcurrentQueue<T>::capacity() const
+{
+    size_t segments = 0;
+    for (SubQueue* sub_queue = m_sub_queues.load(std::memory_order_acquire); sub_queue != nullptr; sub_queue = sub_queue->next)
+        segments += sub_queue->allocated_count.load(std::memory_order_relaxed);
+    return segments * segment_size;
+}
+
+template<typename T>
+typename CppADS::ConcurrentQueue<T>::Producer CppADS::ConcurrentQueue<T>::make_producer()
+{
+    SubQueue* head = m_sub_queues.load(std::memory_order_acquire);
+    for (SubQueue* sub_queue = head; sub_queue != nullptr; sub_queue = sub_queue->next)
+    {
+        bool active = false;
+        if (!sub_queue->active.load(std::memory_order_relaxed) &&
+            sub_queue->active.compare_exchange_strong(active, true, std::memory_order_acquire))
+            return Producer(sub_queue);
+    }
+
+    SubQueue* sub_queue = aligned_new<SubQueue>();
+    sub_queue->next = head;
+    while (!m_sub_queues.compare_exchange_weak(sub_queue->next, sub_queue, std::memory_order_release, std::memory_order_acquire))
+        ;
+    return Producer(sub_queue);
+}
+
+template<typename T>
+bool CppADS::ConcurrentQueue<T>::try_dequeue(T& value)
+{
+    return try_dequeue_bulk(&value, 1) == 1;
+}
+
+template<typename T>
+template<typename OutputIt>
+size_t CppADS::ConcurrentQueue<T>::try_dequeue_bulk(OutputIt out, size_t count)
+{
+    // Hint is loaded first: sub-queues are only prepended, so the head loaded after it
+    // reaches the hinted sub-queue
+    SubQueue* start = m_consumer_hint.load(std::memory_order_acquire);
+    SubQueue* head = m_sub_queues.load(std::memory_order_acquire);
+    if (start == nullptr)
+        start = head;
+    if (start == nullptr || count == 0)
+        return 0;
+
+    size_t taken = 0;
+    bool wrapped = false;
+    SubQueue* sub_queue = start;
+    do
+    {
+        SubQueue* next = sub_queue->next;
+        if (next == nullptr)
+        {
+            // Walk wraps to the head only once, even if start can't be reached from it
+            if (wrapped)
+                next = start;
+            else
+                next = head;
+            wrapped = true;
+        }
+        bool has_values = sub_queue->head.load(std::memory_order_relaxed) != sub_queue->tail.load(std::memory_order_relaxed);
+        if (has_values && !sub_queue->locked.exchange(true, std::memory_order_acquire))
+        {
+            taken += sub_queue->pop(out, count - taken);
+            sub_queue->locked.store(false, std::memory_order_release);
+            if (taken == count)
+            {
+                // Next consumer starts from the following sub-queue, so busy producers don't starve others
+                m_consumer_hint.store(next, std::memory_order_release);
+                break;
+            }
+        }
+        sub_queue = next;
+    }
+    while (sub_queue != start);
+
+    return taken;
+}
+
+template<typename T>
+CppADS::ConcurrentQueue<T>::Producer::Producer(Producer&& move)
+    : m_queue(move.m_queue)
+{
+    move.m_queue = nullptr;
+}
+
+template<typename T>
+typename CppADS::ConcurrentQueue<T>::Producer& CppADS::ConcurrentQueue<T>::Producer::operator=(Producer&& move)
+{
+    if (this == &move)
+        return *this;
+
+    if (m_queue != nullptr)
+        m_queue->active.store(false, std::memory_order_release);
+    m_queue = move.m_queue;
+    move.m_queue = nullptr;
+    return *this;
+}
+
+template<typename T>
+CppADS::ConcurrentQueue<T>::Producer::~Producer()
+{
+    if (m_queue != nullptr)
+        m_queue->active.store(false, std::memory_order_release);
+}
+
+template<typename T>
+T& CppADS::ConcurrentQueue<T>::Producer::slot(size_t position)
+{
+    size_t offset = position & (segment_size - 1);
+    if (offset == 0 && position != 0)
+    {
+        Segment* segment = m_queue->acquire_segment();
+        m_queue->tail_segment->next = segment;
+        m_queue->tail_segment = segment;
+    }
+    return m_queue->tail_segment->values[offset];
+}
+
+template<typename T>
+void CppADS::ConcurrentQueue<T>::Producer::enqueue(const T& value)
+{
+    size_t tail = m_queue->tail.load(std::memory_order_relaxed);
+    slot(tail) = value;
+    m_queue->tail.store(tail + 1, std::memory_order_release);
+}
+
+template<typename T>
+void CppADS::ConcurrentQueue<T>::Producer::enqueue(T&& value)
+{
+    size_t tail = m_queue->tail.load(std::memory_order_relaxed);
+    slot(tail) = std::move(value);
+    m_queue->tail.store(tail + 1, std::memory_order_release);
+}
+
+template<typename T>
+template<typename... Args>
+void CppADS::ConcurrentQueue<T>::Producer::emplace(Args&&... args)
+{
+    size_t tail = m_queue->tail.load(std::memory_order_relaxed);
+    slot(tail) = T(std::forward<Args>(args)...);
+    m_queue->tail.store(tail + 1, std::memory_order_release);
+}
+
+template<typename T>
+template<typename InputIt>
+void CppADS::ConcurrentQueue<T>::Producer::enqueue_bulk(InputIt first, InputIt last)
+{
+    size_t tail = m_queue->tail.load(std::memory_order_relaxed);
+    size_t position = tail;
+    for (; first != last; ++first, position++)
+        slot(position) = *first;
+
+    if (position != tail)
+        m_queue->tail.store(position, std::memory_order_release);
+}
+
+#endif //CONCURRENT_QUEUE_HPP
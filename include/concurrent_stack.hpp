@@ -0,0 +1,305 @@
+#ifndef CONCURRENT_STACK_HPP
+#define CONCURRENT_STACK_HPP
+
+#include "concurrency.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace CppADS
+{
+    /// @brief Lock-free LIFO stack (Treiber stack) for multiple threads
+    /// @details Nodes are taken from a pool owned by the stack and addressed by 32-bit
+    /// indexes. Head of the stack is a 64-bit word of node index and a tag which is
+    /// incremented by every change, so a CAS based on an outdated head fails even if
+    /// the same node got back to the top (ABA problem).
+    ///
+    /// Popped nodes go back to the pool's free list (which is the same kind of tagged
+    /// stack) and the pool never returns memory before the stack is destroyed. Thus a
+    /// thread which still reads a node popped by another thread reads valid memory,
+    /// and no deferred reclamation is needed.
+    /// @tparam T value type stored in the container
+    template<typename T>
+    class ConcurrentStack
+    {
+    public:
+        using value_type = T;
+
+        ConcurrentStack() = default;                    ///< Default constructor
+
+        ConcurrentStack(const ConcurrentStack&) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+        ~ConcurrentStack() = default;                   ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @return true if stack has no elements
+        bool empty() const;
+
+        /// @brief Get count of allocated nodes (used and free)
+        /// @details Nodes are recycled, so it is the maximum count of values stored at once
+        /// @return nodes count
+        size_t capacity() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Push value on top of the stack
+        /// @param value added value
+        void push(const T& value);
+
+        /// @brief Push value on top of the stack
+        /// @param value added value
+        void push(T&& value);
+
+        /// @brief Construct value on top of the stack
+        /// @param args arguments of value's constructor
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        /// @brief Move top value out of the stack
+        /// @param value destination
+        /// @return false if stack is empty
+        bool try_pop(T& value);
+
+        /// @brief Detach all values with one successful CAS and move them out
+        /// @param out output iterator receiving values (the top one first)
+        /// @return count of removed values
+        template<typename OutputIt>
+        size_t pop_all(OutputIt out);
+
+        /// @}
+
+    private:
+        static constexpr uint32_t Null = 0xFFFFFFFFu;   ///< Index of missing node
+        static constexpr size_t FirstChunkBits = 6;     ///< First chunk has 2^FirstChunkBits nodes
+        static constexpr size_t MaxChunks = 26;         ///< Chunk k has 2^(FirstChunkBits + k) nodes
+
+        /// @private
+        struct Node
+        {
+            T value;
+            std::atomic<uint32_t> next { Null };
+        };
+
+        /// @private
+        /// @brief Stack of node indexes with tagged head
+        struct TaggedList
+        {
+            alignas(CacheLineSize) std::atomic<uint64_t> head { Null };
+
+            static uint32_t index(uint64_t head) {
+                return static_cast<uint32_t>(head);
+            }
+            static uint64_t make(uint32_t index, uint64_t previous) {
+                return ((previous >> 32) + 1) << 32 | index;
+            }
+        };
+
+        TaggedList m_stack;                             ///< Used nodes
+        TaggedList m_free;                              ///< Free nodes
+
+        alignas(CacheLineSize) std::atomic<uint32_t> m_allocated { 0 };    ///< Count of nodes given out of chunks
+        std::unique_ptr<Node[]> m_chunks[MaxChunks];    ///< Chunks of type-stable nodes
+        std::atomic<Node*> m_chunk_pointers[MaxChunks] {};
+        std::mutex m_chunk_mutex;                       ///< Serializes chunk allocation
+
+        /// @private
+        /// @brief Find position of node in chunks
+        /// @param index node index
+        /// @param offset position of node in its chunk
+        /// @return chunk number
+        static size_t locate(uint32_t index, size_t& offset);
+
+        /// @private
+        /// @brief Get node by index
+        Node& node(uint32_t index) const;
+
+        /// @private
+        /// @brief Take node from free list or from chunks
+        uint32_t allocate();
+
+        /// @private
+        /// @brief Put chain of linked nodes on top of list
+        void push_chain(TaggedList& list, uint32_t first, uint32_t last);
+
+        /// @private
+        /// @brief Take top node of list
+        /// @return node index or Null
+        uint32_t pop_node(TaggedList& list);
+
+        /// @private
+        /// @brief Push allocated node with value
+        void push_node(uint32_t index);
+    };
+}
+
+template<typename T>
+constexpr uint32_t CppADS::ConcurrentStack<T>::Null;
+
+template<typename T>
+bool CppADS::ConcurrentStack<T>::empty() const
+{
+    return TaggedList::index(m_stack.head.load(std::memory_order_acquire)) == Null;
+}
+
+template<typename T>
+size_t CppADS::ConcurrentStack<T>::capacity() const
+{
+    return m_allocated.load(std::memory_order_relaxed);
+}
+
+template<typename T>
+size_t CppADS::ConcurrentStack<T>::locate(uint32_t index, size_t& offset)
+{
+    // Chunk k starts at index 2^(b + k) - 2^b, where b is FirstChunkBits
+    uint64_t shifted = uint64_t(index) + (uint64_t(1) << FirstChunkBits);
+#if defined(__GNUC__)
+    size_t bit = 63 - __builtin_clzll(shifted);
+#else
+    size_t bit = 0;
+    while ((shifted >> (bit + 1)) != 0)
+        bit++;
+#endif
+    offset = static_cast<size_t>(shifted - (uint64_t(1) << bit));
+    return bit - FirstChunkBits;
+}
+
+template<typename T>
+typename CppADS::ConcurrentStack<T>::Node& CppADS::ConcurrentStack<T>::node(uint32_t index) const
+{
+    size_t offset;
+    size_t chunk = locate(index, offset);
+    return m_chunk_pointers[chunk].load(std::memory_order_acquire)[offset];
+}
+
+template<typename T>
+uint32_t CppADS::ConcurrentStack<T>::allocate()
+{
+    uint32_t index = pop_node(m_free);
+    if (index != Null)
+        return index;
+
+    index = m_allocated.fetch_add(1, std::memory_order_relaxed);
+    size_t offset;
+    size_t chunk = locate(index, offset);
+    if (chunk >= MaxChunks)
+        throw std::length_error("CppADS::ConcurrentStack<T>::allocate: too many nodes");
+
+    if (m_chunk_pointers[chunk].load(std::memory_order_acquire) == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_chunk_mutex);
+        if (m_chunks[chunk] == nullptr)
+        {
+            m_chunks[chunk] = std::make_unique<Node[]>(size_t(1) << (FirstChunkBits + chunk));
+            m_chunk_pointers[chunk].store(m_chunks[chunk].get(), std::memory_order_release);
+        }
+    }
+    return index;
+}
+
+template<typename T>
+void CppADS::ConcurrentStack<T>::push_chain(TaggedList& list, uint32_t first, uint32_t last)
+{
+    Node& tail = node(last);
+    uint64_t head = list.head.load(std::memory_order_relaxed);
+    do
+    {
+        tail.next.store(TaggedList::index(head), std::memory_order_relaxed);
+    }
+    while (!list.head.compare_exchange_weak(head, TaggedList::make(first, head),
+                                            std::memory_order_release, std::memory_order_relaxed));
+}
+
+template<typename T>
+uint32_t CppADS::ConcurrentStack<T>::pop_node(TaggedList& list)
+{
+    uint64_t head = list.head.load(std::memory_order_acquire);
+    while (TaggedList::index(head) != Null)
+    {
+        // Node may be popped and reused concurrently, then the tag makes CAS fail
+        uint32_t next = node(TaggedList::index(head)).next.load(std::memory_order_relaxed);
+        if (list.head.compare_exchange_weak(head, TaggedList::make(next, head),
+                                            std::memory_order_acquire, std::memory_order_acquire))
+            return TaggedList::index(head);
+    }
+    return Null;
+}
+
+template<typename T>
+void CppADS::ConcurrentStack<T>::push_node(uint32_t index)
+{
+    push_chain(m_stack, index, index);
+}
+
+template<typename T>
+void CppADS::ConcurrentStack<T>::push(const T& value)
+{
+    uint32_t index = allocate();
+    node(index).value = value;
+    push_node(index);
+}
+
+template<typename T>
+void CppADS::ConcurrentStack<T>::push(T&& value)
+{
+    uint32_t index = allocate();
+    node(index).value = std::move(value);
+    push_node(index);
+}
+
+template<typename T>
+template<typename... Args>
+void CppADS::ConcurrentStack<T>::emplace(Args&&... args)
+{
+    uint32_t index = allocate();
+    node(index).value = T(std::forward<Args>(args)...);
+    push_node(index);
+}
+
+template<typename T>
+bool CppADS::ConcurrentStack<T>::try_pop(T& value)
+{
+    uint32_t index = pop_node(m_stack);
+    if (index == Null)
+        return false;
+
+    value = std::move(node(index).value);
+    push_chain(m_free, index, index);
+    return true;
+}
+
+template<typename T>
+template<typename OutputIt>
+size_t CppADS::ConcurrentStack<T>::pop_all(OutputIt out)
+{
+    uint64_t head = m_stack.head.load(std::memory_order_acquire);
+    while (TaggedList::index(head) != Null &&
+           !m_stack.head.compare_exchange_weak(head, TaggedList::make(Null, head),
+                                               std::memory_order_acquire, std::memory_order_acquire))
+        ;
+
+    uint32_t first = TaggedList::index(head);
+    if (first == Null)
+        return 0;
+
+    // Detached chain is private now, its links are reused by the free list as is
+    size_t count = 0;
+    uint32_t last = first;
+    for (uint32_t index = first; index != Null; index = node(index).next.load(std::memory_order_relaxed), ++out)
+    {
+        *out = std::move(node(index).value);
+        last = index;
+        count++;
+    }
+    push_chain(m_free, first, last);
+    return count;
+}
+
+#endif //CONCURRENT_STACK_HPP
@@ -1,14 +1,23 @@
 #ifndef DEQUE_HPP
 #define DEQUE_HPP
 
-#include "list.hpp"
+#include "container.hpp"
+
+#include <memory>
+#include <iterator>
+#include <new>
+#include <stdexcept>
 
 namespace CppADS
 {
     /// @brief Double-endian queue class
+    /// @details Elements are stored in fixed-size blocks referenced from a circular map.
+    /// Blocks released by pops stay in the map and are reused by following pushes, so
+    /// push/pop at both ends allocate only when the deque grows beyond its previous size.
+    /// Unused slots of blocks are uninitialized, so T needn't be default constructible.
     /// @tparam T value type stored in the container
     template<typename T>
-    class Deque : private List<T>
+    class Deque : public IContainer
     {
     public:
         using value_type = T;
@@ -17,6 +26,11 @@ namespace CppADS
         using pointer = T*;
         using const_pointer = const T*;
 
+        class iterator;
+        class const_iterator;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
         Deque() = default;                          ///< Default constructor
         Deque(const Deque<T>& copy);                ///< Copy constructor
         Deque(Deque<T>&& move);                     ///< Move constructor
@@ -25,7 +39,7 @@ namespace CppADS
         Deque<T>& operator=(const Deque<T>& copy);  ///< Copy assignment operator
         Deque<T>& operator=(Deque<T>&& move);       ///< Move assignment operator
 
-        ~Deque() = default;                         ///< Destructor
+        ~Deque();                                   ///< Destructor
 
         /// @name Capacity
         /// @{
@@ -34,13 +48,20 @@ namespace CppADS
         /// @return element's count
         size_t size() const override;
 
+        /// @brief Get count of elements which fit into allocated blocks
+        /// @return Count of elements in used and spare blocks
+        size_t capacity() const;
+
         /// @}
         /// @name Modifiers
         /// @{
 
-        /// @brief Remove all data from container
+        /// @brief Remove all data from container and free memory
         void clear() override;
 
+        /// @brief Free spare blocks kept for reuse
+        void shrink_to_fit();
+
         /// @brief Insert element to the end
         /// @param value inserted item
         void push_back(const T& value);
@@ -66,6 +87,16 @@ namespace CppADS
         /// @name Accesors
         /// @{
 
+        /// @brief Access to item
+        /// @param index item position
+        /// @return reference to value
+        reference operator[](size_t index);
+
+        /// @brief Access to item
+        /// @param index item position
+        /// @return const reference to value
+        const_reference operator[](size_t index) const;
+
         /// @brief Access to the first element
         /// @return Reference to the first element
         reference front();
@@ -86,115 +117,633 @@ namespace CppADS
 
         bool operator==(const Deque<T>& rhs) const;
         bool operator!=(const Deque<T>& rhs) const;
+
+        /// @name Iterators
+        /// @{
+
+        /// @return read-write iterator to the first element of the container
+        iterator begin();
+        /// @return read-only iterator to the first element of the container
+        const_iterator begin() const;
+        /// @return read-only iterator to the first element of the container
+        const_iterator cbegin() const;
+
+        /// @return read-write iterator to the element after the last element of the container
+        iterator end();
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator end() const;
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator cend() const;
+
+        /// @return read-write reverse iterator to the last element of the container
+        reverse_iterator rbegin();
+        /// @return read-only reverse iterator to the last element of the container
+        const_reverse_iterator rbegin() const;
+        /// @return read-only reverse iterator to the last element of the container
+        const_reverse_iterator crbegin() const;
+
+        /// @return read-write reverse iterator to the element before the first element of the container
+        reverse_iterator rend();
+        /// @return read-only reverse iterator to the element before the first element of the container
+        const_reverse_iterator rend() const;
+        /// @return read-only reverse iterator to the element before the first element of the container
+        const_reverse_iterator crend() const;
+
+        /// @}
+
+    private:
+        /// @private
+        /// @brief Block storage deleter, elements are destroyed by the deque itself
+        struct BlockDeleter
+        {
+            void operator()(T* block) const;
+        };
+
+        using Block = std::unique_ptr<T, BlockDeleter>;
+
+        /// @private
+        /// @brief Block size calculation function
+        /// @return power of two elements count fitting into 4KiB (at least 16)
+        static constexpr size_t calc_block_size()
+        {
+            size_t size = 16;
+            while (size * 2 * sizeof(T) <= 4096)
+                size *= 2;
+            return size;
+        }
+
+        static constexpr size_t block_size = calc_block_size();
+
+        std::unique_ptr<Block[]> m_map { nullptr };     ///< Circular map of blocks
+        size_t m_map_size { 0 };                        ///< Map size (power of two)
+        size_t m_map_head { 0 };                        ///< Map position of the first used block
+        size_t m_blocks { 0 };                          ///< Count of used blocks
+        size_t m_offset { 0 };                          ///< Position of the first element in the first block
+        size_t m_size { 0 };                            ///< Count of elements
+
+        inline T& at(size_t index);
+        inline const T& at(size_t index) const;
+
+        static Block allocate_block();
+        void grow_map();
+        void add_back_block();
+        void add_front_block();
+        void release_blocks_if_empty();
+    };
+
+    template<typename T>
+    /// @brief Read-write iterator for Deque container
+    class Deque<T>::iterator : public std::iterator<std::random_access_iterator_tag, T>
+    {
+    private:
+        Deque<T>* m_container { nullptr };
+        size_t m_index { 0 };
+        friend class Deque;
+
+    public:
+        iterator(Deque<T>* container = nullptr, size_t index = 0) : m_container(container), m_index(index) {}
+
+        Deque<T>::reference operator*() const {
+            return m_container->at(m_index);
+        }
+        Deque<T>::pointer operator->() const {
+            return &m_container->at(m_index);
+        }
+        Deque<T>::reference operator[](std::ptrdiff_t offset) const {
+            return m_container->at(m_index + offset);
+        }
+
+        iterator& operator++() {
+            m_index++;
+            return *this;
+        }
+        iterator& operator--() {
+            m_index--;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator result(*this);
+            m_index++;
+            return result;
+        }
+        iterator operator--(int) {
+            iterator result(*this);
+            m_index--;
+            return result;
+        }
+        iterator& operator+=(std::ptrdiff_t offset) {
+            m_index += offset;
+            return *this;
+        }
+        iterator& operator-=(std::ptrdiff_t offset) {
+            m_index -= offset;
+            return *this;
+        }
+        iterator operator+(std::ptrdiff_t offset) const {
+            return iterator(m_container, m_index + offset);
+        }
+        iterator operator-(std::ptrdiff_t offset) const {
+            return iterator(m_container, m_index - offset);
+        }
+        std::ptrdiff_t operator-(const iterator& rhs) const {
+            return static_cast<std::ptrdiff_t>(m_index) - static_cast<std::ptrdiff_t>(rhs.m_index);
+        }
+
+        bool operator==(const iterator& rhs) const {
+            return m_container == rhs.m_container && m_index == rhs.m_index;
+        }
+        bool operator!=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator>(const iterator& rhs) const {
+            return m_index > rhs.m_index;
+        }
+        bool operator<(const iterator& rhs) const {
+            return m_index < rhs.m_index;
+        }
+        bool operator>=(const iterator& rhs) const {
+            return m_index >= rhs.m_index;
+        }
+        bool operator<=(const iterator& rhs) const {
+            return m_index <= rhs.m_index;
+        }
     };
+
+    template<typename T>
+    /// @brief Read-only iterator for Deque container
+    class Deque<T>::const_iterator : public std::iterator<std::random_access_iterator_tag, T, std::ptrdiff_t, const T*, const T&>
+    {
+    private:
+        const Deque<T>* m_container { nullptr };
+        size_t m_index { 0 };
+        friend class Deque;
+
+    public:
+        const_iterator(const Deque<T>* container = nullptr, size_t index = 0) : m_container(container), m_index(index) {}
+
+        Deque<T>::const_reference operator*() const {
+            return m_container->at(m_index);
+        }
+        Deque<T>::const_pointer operator->() const {
+            return &m_container->at(m_index);
+        }
+        Deque<T>::const_reference operator[](std::ptrdiff_t offset) const {
+            return m_container->at(m_index + offset);
+        }
+
+        const_iterator& operator++() {
+            m_index++;
+            return *this;
+        }
+        const_iterator& operator--() {
+            m_index--;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator result(*this);
+            m_index++;
+            return result;
+        }
+        const_iterator operator--(int) {
+            const_iterator result(*this);
+            m_index--;
+            return result;
+        }
+        const_iterator& operator+=(std::ptrdiff_t offset) {
+            m_index += offset;
+            return *this;
+        }
+        const_iterator& operator-=(std::ptrdiff_t offset) {
+            m_index -= offset;
+            return *this;
+        }
+        const_iterator operator+(std::ptrdiff_t offset) const {
+            return const_iterator(m_container, m_index + offset);
+        }
+        const_iterator operator-(std::ptrdiff_t offset) const {
+            return const_iterator(m_container, m_index - offset);
+        }
+        std::ptrdiff_t operator-(const const_iterator& rhs) const {
+            return static_cast<std::ptrdiff_t>(m_index) - static_cast<std::ptrdiff_t>(rhs.m_index);
+        }
+
+        bool operator==(const const_iterator& rhs) const {
+            return m_container == rhs.m_container && m_index == rhs.m_index;
+        }
+        bool operator!=(const const_iterator& rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator>(const const_iterator& rhs) const {
+            return m_index > rhs.m_index;
+        }
+        bool operator<(const const_iterator& rhs) const {
+            return m_index < rhs.m_index;
+        }
+        bool operator>=(const const_iterator& rhs) const {
+            return m_index >= rhs.m_index;
+        }
+        bool operator<=(const const_iterator& rhs) const {
+            return m_index <= rhs.m_index;
+        }
+    };
+}
+
+template<typename T>
+constexpr size_t CppADS::Deque<T>::block_size;
+
+template<typename T>
+CppADS::Deque<T>::Deque(const Deque<T>& copy)
+{
+    for (auto it = copy.cbegin(); it != copy.cend(); ++it)
+        push_back(*it);
 }
 
 template<typename T>
-CppADS::Deque<T>::Deque(const Deque<T>& copy) : List<T>(copy) {}
+CppADS::Deque<T>::Deque(Deque<T>&& move)
+    : m_map(std::move(move.m_map)), m_map_size(move.m_map_size), m_map_head(move.m_map_head),
+      m_blocks(move.m_blocks), m_offset(move.m_offset), m_size(move.m_size)
+{
+    move.m_map_size = 0;
+    move.m_map_head = 0;
+    move.m_blocks = 0;
+    move.m_offset = 0;
+    move.m_size = 0;
+}
 
 template<typename T>
-CppADS::Deque<T>::Deque(Deque<T>&& move) : List<T>(std::move(move)) {}
+CppADS::Deque<T>::Deque(std::initializer_list<T> init_list)
+{
+    for (auto it = init_list.begin(); it != init_list.end(); it++)
+        push_back(*it);
+}
 
 template<typename T>
-CppADS::Deque<T>::Deque(std::initializer_list<T> init_list) : List<T>(init_list) {}
+CppADS::Deque<T>::~Deque()
+{
+    clear();
+}
 
 template<typename T>
 CppADS::Deque<T>& CppADS::Deque<T>::operator=(const Deque<T>& copy)
 {
-    List<T>::operator=(copy);
+    if (this == &copy)
+        return *this;
+
+    while (m_size != 0)
+        pop_back();
+    for (auto it = copy.cbegin(); it != copy.cend(); ++it)
+        push_back(*it);
     return *this;
 }
 
 template<typename T>
 CppADS::Deque<T>& CppADS::Deque<T>::operator=(Deque<T>&& move)
 {
-    List<T>::operator=(std::move(move));
+    if (this == &move)
+        return *this;
+
+    clear();
+    m_map = std::move(move.m_map);
+    m_map_size = move.m_map_size;
+    m_map_head = move.m_map_head;
+    m_blocks = move.m_blocks;
+    m_offset = move.m_offset;
+    m_size = move.m_size;
+
+    move.m_map_size = 0;
+    move.m_map_head = 0;
+    move.m_blocks = 0;
+    move.m_offset = 0;
+    move.m_size = 0;
     return *this;
 }
 
+template<typename T>
+size_t CppADS::Deque<T>::size() const
+{
+    return m_size;
+}
+
+template<typename T>
+size_t CppADS::Deque<T>::capacity() const
+{
+    size_t blocks = 0;
+    for (size_t i = 0; i < m_map_size; i++)
+    {
+        if (m_map[i] != nullptr)
+            blocks++;
+    }
+    return blocks * block_size;
+}
+
+template<typename T>
+void CppADS::Deque<T>::clear()
+{
+    for (size_t i = 0; i < m_size; i++)
+        at(i).~T();
+    m_map.reset(nullptr);
+    m_map_size = 0;
+    m_map_head = 0;
+    m_blocks = 0;
+    m_offset = 0;
+    m_size = 0;
+}
+
+template<typename T>
+void CppADS::Deque<T>::shrink_to_fit()
+{
+    for (size_t i = m_blocks; i < m_map_size; i++)
+        m_map[(m_map_head + i) & (m_map_size - 1)].reset(nullptr);
+}
+
 template<typename T>
 void CppADS::Deque<T>::push_back(const T& value)
 {
-    List<T>::push_back(value);
+    if (m_offset + m_size == m_blocks * block_size)
+        add_back_block();
+    new (&at(m_size)) T(value);
+    m_size++;
 }
 
 template<typename T>
 void CppADS::Deque<T>::push_back(T&& value)
 {
-    List<T>::push_back(std::move(value));
+    if (m_offset + m_size == m_blocks * block_size)
+        add_back_block();
+    new (&at(m_size)) T(std::move(value));
+    m_size++;
 }
 
 template<typename T>
 void CppADS::Deque<T>::push_front(const T& value)
 {
-
-    List<T>::push_front(value);
+    if (m_offset == 0)
+        add_front_block();
+    m_offset--;
+    try
+    {
+        new (&at(0)) T(value);
+    }
+    catch (...)
+    {
+        m_offset++;
+        throw;
+    }
+    m_size++;
 }
 
 template<typename T>
 void CppADS::Deque<T>::push_front(T&& value)
 {
-    List<T>::push_front(std::move(value));
+    if (m_offset == 0)
+        add_front_block();
+    m_offset--;
+    try
+    {
+        new (&at(0)) T(std::move(value));
+    }
+    catch (...)
+    {
+        m_offset++;
+        throw;
+    }
+    m_size++;
 }
 
 template<typename T>
 void CppADS::Deque<T>::pop_back()
 {
-    List<T>::pop_back();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Deque<T>::pop_back: container is empty");
+
+    m_size--;
+    at(m_size).~T();
+    if (m_offset + m_size <= (m_blocks - 1) * block_size)
+        m_blocks--;
+    release_blocks_if_empty();
 }
 
 template<typename T>
 void CppADS::Deque<T>::pop_front()
 {
-    List<T>::pop_front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Deque<T>::pop_front: container is empty");
+
+    at(0).~T();
+    m_offset++;
+    m_size--;
+    if (m_offset == block_size)
+    {
+        m_map_head = (m_map_head + 1) & (m_map_size - 1);
+        m_blocks--;
+        m_offset = 0;
+    }
+    release_blocks_if_empty();
+}
+
+template<typename T>
+typename CppADS::Deque<T>::reference CppADS::Deque<T>::operator[](size_t index)
+{
+    if (index >= m_size)
+        throw std::out_of_range("CppADS::Deque<T>::operator[]: index is out of range");
+    return at(index);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_reference CppADS::Deque<T>::operator[](size_t index) const
+{
+    if (index >= m_size)
+        throw std::out_of_range("CppADS::Deque<T>::operator[]: index is out of range");
+    return at(index);
 }
 
 template<typename T>
 typename CppADS::Deque<T>::reference CppADS::Deque<T>::front()
 {
-    return List<T>::front();
+    return operator[](0);
 }
 
 template<typename T>
 typename CppADS::Deque<T>::const_reference CppADS::Deque<T>::front() const
 {
-    return List<T>::front();
+    return operator[](0);
 }
 
 template<typename T>
 typename CppADS::Deque<T>::reference CppADS::Deque<T>::back()
 {
-    return List<T>::back();
+    return operator[](m_size - 1);
 }
 
 template<typename T>
 typename CppADS::Deque<T>::const_reference CppADS::Deque<T>::back() const
 {
-    return List<T>::back();
+    return operator[](m_size - 1);
 }
 
 template<typename T>
 bool CppADS::Deque<T>::operator==(const Deque<T>& rhs) const
 {
-    return List<T>::operator==(rhs);
+    if (m_size != rhs.m_size)
+        return false;
+
+    for (size_t i = 0; i < m_size; i++)
+    {
+        if (at(i) != rhs.at(i))
+            return false;
+    }
+    return true;
 }
 
 template<typename T>
 bool CppADS::Deque<T>::operator!=(const Deque<T> &rhs) const
 {
-    return List<T>::operator!=(rhs);
+    return !(*this == rhs);
 }
 
 template<typename T>
-size_t CppADS::Deque<T>::size() const
+T& CppADS::Deque<T>::at(size_t index)
 {
-    return List<T>::size();
+    size_t position = m_offset + index;
+    return m_map[(m_map_head + position / block_size) & (m_map_size - 1)].get()[position % block_size];
 }
 
 template<typename T>
-void CppADS::Deque<T>::clear()
+const T& CppADS::Deque<T>::at(size_t index) const
+{
+    size_t position = m_offset + index;
+    return m_map[(m_map_head + position / block_size) & (m_map_size - 1)].get()[position % block_size];
+}
+
+template<typename T>
+void CppADS::Deque<T>::BlockDeleter::operator()(T* block) const
+{
+    std::allocator<T>().deallocate(block, block_size);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::Block CppADS::Deque<T>::allocate_block()
+{
+    return Block(std::allocator<T>().allocate(block_size));
+}
+
+template<typename T>
+void CppADS::Deque<T>::grow_map()
+{
+    size_t new_size = (m_map_size == 0) ? 8 : m_map_size * 2;
+    std::unique_ptr<Block[]> new_map = std::make_unique<Block[]>(new_size);
+
+    // Used blocks go first, spare blocks follow them to be reused by push_back
+    for (size_t i = 0; i < m_map_size; i++)
+        new_map[i] = std::move(m_map[(m_map_head + i) & (m_map_size - 1)]);
+
+    m_map = std::move(new_map);
+    m_map_size = new_size;
+    m_map_head = 0;
+}
+
+template<typename T>
+void CppADS::Deque<T>::add_back_block()
+{
+    if (m_blocks == m_map_size)
+        grow_map();
+
+    Block& block = m_map[(m_map_head + m_blocks) & (m_map_size - 1)];
+    if (block == nullptr)
+    {
+        // Reuse block released by pop_front before allocating a new one
+        Block& spare = m_map[(m_map_head - 1) & (m_map_size - 1)];
+        block = (spare != nullptr) ? std::move(spare) : allocate_block();
+    }
+    m_blocks++;
+}
+
+template<typename T>
+void CppADS::Deque<T>::add_front_block()
 {
-    List<T>::clear();
+    if (m_blocks == m_map_size)
+        grow_map();
+
+    m_map_head = (m_map_head - 1) & (m_map_size - 1);
+    Block& block = m_map[m_map_head];
+    if (block == nullptr)
+    {
+        // Reuse block released by pop_back before allocating a new one
+        Block& spare = m_map[(m_map_head + m_blocks + 1) & (m_map_size - 1)];
+        block = (spare != nullptr) ? std::move(spare) : allocate_block();
+    }
+    m_blocks++;
+    m_offset += block_size;
+}
+
+template<typename T>
+void CppADS::Deque<T>::release_blocks_if_empty()
+{
+    if (m_size == 0)
+    {
+        m_blocks = 0;
+        m_offset = 0;
+    }
+}
+
+template<typename T>
+typename CppADS::Deque<T>::iterator CppADS::Deque<T>::begin() {
+    return iterator(this, 0);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_iterator CppADS::Deque<T>::begin() const {
+    return const_iterator(this, 0);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_iterator CppADS::Deque<T>::cbegin() const {
+    return const_iterator(this, 0);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::iterator CppADS::Deque<T>::end() {
+    return iterator(this, m_size);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_iterator CppADS::Deque<T>::end() const {
+    return const_iterator(this, m_size);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_iterator CppADS::Deque<T>::cend() const {
+    return const_iterator(this, m_size);
+}
+
+template<typename T>
+typename CppADS::Deque<T>::reverse_iterator CppADS::Deque<T>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_reverse_iterator CppADS::Deque<T>::rbegin() const {
+    return const_reverse_iterator(cend());
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_reverse_iterator CppADS::Deque<T>::crbegin() const {
+    return const_reverse_iterator(cend());
+}
+
+template<typename T>
+typename CppADS::Deque<T>::reverse_iterator CppADS::Deque<T>::rend() {
+    return reverse_iterator(begin());
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_reverse_iterator CppADS::Deque<T>::rend() const {
+    return const_reverse_iterator(cbegin());
+}
+
+template<typename T>
+typename CppADS::Deque<T>::const_reverse_iterator CppADS::Deque<T>::crend() const {
+    return const_reverse_iterator(cbegin());
 }
 
 #endif //DEQUE_HPP
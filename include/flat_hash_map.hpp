@@ -0,0 +1,769 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include "container.hpp"
+#include "array.hpp"
+#include "hash_mix.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace CppADS
+{
+    /// @brief Open-addressing hash map with SIMD probing of control bytes (SwissTable design)
+    /// @details Every slot has one control byte next to the others in a separate array: empty,
+    /// deleted or 7 low bits of the hash of a stored key. Hash is split into H1, which selects
+    /// the first group of 16 slots to probe, and H2 stored in the control byte. A lookup
+    /// compares H2 with the control bytes of a whole group at once (SSE2 when available,
+    /// plain loop otherwise) and touches the slots only on a match, so misses and long
+    /// string keys rarely leave the control array. Groups are probed quadratically; probing
+    /// stops at a group with an empty slot.
+    ///
+    /// Removal leaves a tombstone unless the group still has an empty slot. Tombstones
+    /// are reused by insertion and dropped when the table is rehashed.
+    ///
+    /// Slot count is a power of two, at least 16. Iterators and references are invalidated
+    /// by insertion and removal.
+    /// @tparam Key hashed key type
+    /// @tparam T stored value type
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class FlatHashMap : public IContainer
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<key_type, mapped_type>;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        class iterator;
+        class const_iterator;
+
+        FlatHashMap() = default;                                        ///< Default contructor
+        FlatHashMap(const FlatHashMap& copy) = default;                 ///< Copy contructor
+        FlatHashMap(FlatHashMap&& move);                                ///< Move contructor
+        FlatHashMap(std::initializer_list<value_type> init_list);       ///< Contructor from initializer list
+
+        FlatHashMap& operator=(const FlatHashMap& copy) = default;      ///< Copy assignment operator
+        FlatHashMap& operator=(FlatHashMap&& move);                     ///< Move assignment operator
+
+        ~FlatHashMap() = default;                                       ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get current number of slots
+        /// @return number of slots
+        size_t bucket_count() const;
+
+        /// @brief Get maximum ratio of elements to slots
+        /// @return maximum load factor
+        float max_load_factor() const;
+
+        /// @brief Get current ratio of elements to slots
+        /// @return load factor
+        float load_factor() const;
+
+        /// @}
+        /// @name Hash policy
+        /// @{
+
+        /// @brief Set maximum ratio of elements and tombstones to slots
+        /// @param load_factor new maximum load factor in (0, 1)
+        void set_load_factor(float load_factor);
+
+        /// @brief Reserve slots for specific count of elements
+        /// @param count count of elements which fit without rehashing
+        void reserve(size_t count);
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert value to container, existing value of the key is replaced
+        /// @param pair key-value pair to insert
+        void insert(const value_type& pair);
+        /// @brief Insert value to container, existing value of the key is replaced
+        /// @param pair key-value pair to insert
+        void insert(value_type&& pair);
+
+        /// @brief Remove value from container
+        /// @param key key of item to delete
+        /// @return true if item was removed
+        bool remove(const key_type& key);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Access to item, missing item is default constructed
+        /// @param key item key
+        /// @return reference to value
+        mapped_type& operator[](const key_type& key);
+
+        /// @brief Access to existing item
+        /// @param key item key
+        /// @return reference to value
+        const mapped_type& operator[](const key_type& key) const;
+
+        /// @brief Search for item with key
+        /// @param key key to search for
+        /// @return iterator to found item (end if item not found)
+        iterator find(const key_type& key);
+
+        /// @brief Search for item with key
+        /// @param key key to search for
+        /// @return iterator to found item (end if item not found)
+        const_iterator find(const key_type& key) const;
+
+        /// @}
+        /// @name Iterators
+        /// @{
+
+        /// @return read-write iterator to the first element of the container
+        iterator begin();
+        /// @return read-only iterator to the first element of the container
+        const_iterator begin() const;
+        /// @return read-only iterator to the first element of the container
+        const_iterator cbegin() const;
+
+        /// @return read-write iterator to the element after the last element of the container
+        iterator end();
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator end() const;
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator cend() const;
+
+        /// @}
+
+        bool operator==(const FlatHashMap& rhs) const;
+        bool operator!=(const FlatHashMap& rhs) const;
+
+    private:
+        static constexpr size_t GroupWidth = 16;
+        static constexpr size_t MinSlots = GroupWidth;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        static constexpr int8_t Empty = -128;       ///< Control byte of never used slot
+        static constexpr int8_t Deleted = -2;       ///< Control byte of tombstone, full slots are >= 0
+
+        /// @private
+        /// @brief Control bytes of one group of slots with bit masks of matching slots
+        class Group;
+
+        Array<int8_t> m_ctrl;
+        Array<value_type> m_slots;
+        size_t m_size { 0 };
+        size_t m_group_mask { 0 };
+        size_t m_growth_left { 0 };     ///< Empty slots which may be filled before rehashing
+        float m_max_load_factor { 0.875f };
+        Hash m_hash {};
+        KeyEqual m_equal {};
+
+        /// @private
+        int8_t* ctrl();
+        /// @private
+        const int8_t* ctrl() const;
+        /// @private
+        value_type* slots();
+        /// @private
+        const value_type* slots() const;
+
+        /// @private
+        /// @brief Get index of the lowest set bit of non-zero mask
+        static size_t lowest_bit(uint32_t mask);
+
+        /// @private
+        /// @brief Count of slots which may be used with the load factor
+        size_t capacity_limit(size_t slot_count) const;
+
+        /// @private
+        /// @brief Get index of slot with key
+        /// @return slot index or npos
+        size_t lookup(const key_type& key, size_t hash) const;
+
+        /// @private
+        /// @brief Get index of the first empty or deleted slot on the probe sequence
+        size_t find_free(size_t hash) const;
+
+        /// @private
+        /// @brief Insert entry or find existing entry of its key
+        /// @return slot index of the entry with the key
+        size_t emplace_slot(value_type&& value, bool assign);
+
+        /// @private
+        /// @brief Place entry of unique key to a free slot
+        size_t place(value_type&& value, size_t hash);
+
+        /// @private
+        /// @brief Move entries to a new array of slots
+        void rehash(size_t slot_count);
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    class FlatHashMap<Key, T, Hash, KeyEqual>::Group
+    {
+    public:
+        explicit Group(const int8_t* ctrl)
+#if defined(__SSE2__)
+            : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+#else
+            : m_ctrl(ctrl)
+#endif
+        {
+        }
+
+        /// @brief Get mask of full slots with H2 part of hash
+        uint32_t match(int8_t h2) const {
+#if defined(__SSE2__)
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(h2))));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GroupWidth; i++)
+                mask |= static_cast<uint32_t>(m_ctrl[i] == h2) << i;
+            return mask;
+#endif
+        }
+
+        /// @brief Get mask of empty slots
+        uint32_t match_empty() const {
+            return match(Empty);
+        }
+
+        /// @brief Get mask of empty and deleted slots (control bytes with the sign bit)
+        uint32_t match_free() const {
+#if defined(__SSE2__)
+            return static_cast<uint32_t>(_mm_movemask_epi8(m_ctrl));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GroupWidth; i++)
+                mask |= static_cast<uint32_t>(m_ctrl[i] < 0) << i;
+            return mask;
+#endif
+        }
+
+    private:
+#if defined(__SSE2__)
+        __m128i m_ctrl;
+#else
+        const int8_t* m_ctrl;
+#endif
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    /// @brief Read-write iterator for FlatHashMap container
+    class FlatHashMap<Key, T, Hash, KeyEqual>::iterator : public std::iterator<std::forward_iterator_tag, value_type>
+    {
+    private:
+        const int8_t* m_ctrl { nullptr };
+        const int8_t* m_end { nullptr };
+        value_type* m_slot { nullptr };
+
+        void skip_free() {
+            while (m_ctrl != m_end && *m_ctrl < 0)
+            {
+                m_ctrl++;
+                m_slot++;
+            }
+        }
+
+    public:
+        iterator(const int8_t* ctrl = nullptr, const int8_t* end = nullptr, value_type* slot = nullptr)
+            : m_ctrl(ctrl), m_end(end), m_slot(slot) {
+            skip_free();
+        }
+
+        reference operator*() {
+            return *m_slot;
+        }
+        pointer operator->() {
+            return m_slot;
+        }
+
+        iterator& operator++() {
+            m_ctrl++;
+            m_slot++;
+            skip_free();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator result(*this);
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& rhs) const {
+            return m_ctrl == rhs.m_ctrl;
+        }
+        bool operator!=(const iterator& rhs) const {
+            return m_ctrl != rhs.m_ctrl;
+        }
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    /// @brief Read-only iterator for FlatHashMap container
+    class FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator : public std::iterator<std::forward_iterator_tag, value_type>
+    {
+    private:
+        const int8_t* m_ctrl { nullptr };
+        const int8_t* m_end { nullptr };
+        const value_type* m_slot { nullptr };
+
+        void skip_free() {
+            while (m_ctrl != m_end && *m_ctrl < 0)
+            {
+                m_ctrl++;
+                m_slot++;
+            }
+        }
+
+    public:
+        const_iterator(const int8_t* ctrl = nullptr, const int8_t* end = nullptr, const value_type* slot = nullptr)
+            : m_ctrl(ctrl), m_end(end), m_slot(slot) {
+            skip_free();
+        }
+
+        const_reference operator*() {
+            return *m_slot;
+        }
+        const_pointer operator->() {
+            return m_slot;
+        }
+
+        const_iterator& operator++() {
+            m_ctrl++;
+            m_slot++;
+            skip_free();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator result(*this);
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const const_iterator& rhs) const {
+            return m_ctrl == rhs.m_ctrl;
+        }
+        bool operator!=(const const_iterator& rhs) const {
+            return m_ctrl != rhs.m_ctrl;
+        }
+    };
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::GroupWidth;
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::MinSlots;
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::npos;
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr int8_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::Empty;
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr int8_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::Deleted;
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::FlatHashMap(FlatHashMap&& move)
+    : m_ctrl(std::move(move.m_ctrl)), m_slots(std::move(move.m_slots)), m_size(move.m_size), m_group_mask(move.m_group_mask),
+      m_growth_left(move.m_growth_left), m_max_load_factor(move.m_max_load_factor), m_hash(std::move(move.m_hash)), m_equal(std::move(move.m_equal))
+{
+    move.m_size = 0;
+    move.m_group_mask = 0;
+    move.m_growth_left = 0;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::FlatHashMap(std::initializer_list<value_type> init_list)
+{
+    reserve(init_list.size());
+    for (auto it = init_list.begin(); it != init_list.end(); it++)
+        insert(*it);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::FlatHashMap<Key, T, Hash, KeyEqual>& CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::operator=(FlatHashMap&& move)
+{
+    m_ctrl = std::move(move.m_ctrl);
+    m_slots = std::move(move.m_slots);
+    m_size = move.m_size;
+    m_group_mask = move.m_group_mask;
+    m_growth_left = move.m_growth_left;
+    m_max_load_factor = move.m_max_load_factor;
+    m_hash = std::move(move.m_hash);
+    m_equal = std::move(move.m_equal);
+    move.m_size = 0;
+    move.m_group_mask = 0;
+    move.m_growth_left = 0;
+    return *this;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::size() const
+{
+    return m_size;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::bucket_count() const
+{
+    return m_ctrl.size();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+float CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::max_load_factor() const
+{
+    return m_max_load_factor;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+float CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::load_factor() const
+{
+    return bucket_count() == 0 ? 0.0f : static_cast<float>(size()) / bucket_count();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::set_load_factor(float load_factor)
+{
+    if (!(load_factor > 0.0f && load_factor < 1.0f))
+        throw std::invalid_argument("CppADS::FlatHashMap::set_load_factor: load factor must be in (0, 1)");
+
+    m_max_load_factor = load_factor;
+    if (bucket_count() == 0)
+        return;
+
+    // Count of tombstones isn't kept, rehashing recomputes the growth budget
+    size_t slot_count = bucket_count();
+    while (capacity_limit(slot_count) < size())
+        slot_count *= 2;
+    rehash(slot_count);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::reserve(size_t count)
+{
+    size_t slot_count = MinSlots;
+    while (capacity_limit(slot_count) < count)
+        slot_count *= 2;
+    if (slot_count > bucket_count())
+        rehash(slot_count);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::clear()
+{
+    m_ctrl.clear();
+    m_slots.clear();
+    m_size = 0;
+    m_group_mask = 0;
+    m_growth_left = 0;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::insert(const value_type& pair)
+{
+    emplace_slot(value_type(pair), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::insert(value_type&& pair)
+{
+    emplace_slot(std::move(pair), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::remove(const key_type& key)
+{
+    size_t index = lookup(key, hash_mix(m_hash(key)));
+    if (index == npos)
+        return false;
+
+    // Probing never went past a group which has an empty slot, so the slot may become empty too
+    int8_t* control = ctrl();
+    if (Group(control + (index & ~(GroupWidth - 1))).match_empty() != 0)
+    {
+        control[index] = Empty;
+        m_growth_left++;
+    }
+    else
+    {
+        control[index] = Deleted;
+    }
+    slots()[index] = value_type();
+    m_size--;
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::mapped_type& CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::operator[](const key_type& key)
+{
+    size_t index = lookup(key, hash_mix(m_hash(key)));
+    if (index == npos)
+        index = emplace_slot(value_type(key, T()), false);
+    return slots()[index].second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::mapped_type& CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::operator[](const key_type& key) const
+{
+    size_t index = lookup(key, hash_mix(m_hash(key)));
+    if (index == npos)
+        throw std::out_of_range("CppADS::FlatHashMap::operator[]: key not found");
+    return slots()[index].second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::find(const key_type& key)
+{
+    size_t index = lookup(key, hash_mix(m_hash(key)));
+    if (index == npos)
+        return end();
+    return iterator(ctrl() + index, ctrl() + bucket_count(), slots() + index);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+{
+    size_t index = lookup(key, hash_mix(m_hash(key)));
+    if (index == npos)
+        return cend();
+    return const_iterator(ctrl() + index, ctrl() + bucket_count(), slots() + index);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::begin()
+{
+    return iterator(ctrl(), ctrl() + bucket_count(), slots());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::begin() const
+{
+    return cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::cbegin() const
+{
+    return const_iterator(ctrl(), ctrl() + bucket_count(), slots());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::end()
+{
+    return iterator(ctrl() + bucket_count(), ctrl() + bucket_count(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::end() const
+{
+    return cend();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::const_iterator CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::cend() const
+{
+    return const_iterator(ctrl() + bucket_count(), ctrl() + bucket_count(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::operator==(const FlatHashMap& rhs) const
+{
+    if (size() != rhs.size())
+        return false;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        size_t index = rhs.lookup(it->first, hash_mix(rhs.m_hash(it->first)));
+        if (index == npos || !(rhs.slots()[index].second == it->second))
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::operator!=(const FlatHashMap& rhs) const
+{
+    return !(operator==(rhs));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+int8_t* CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::ctrl()
+{
+    return bucket_count() == 0 ? nullptr : &*m_ctrl.begin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const int8_t* CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::ctrl() const
+{
+    return bucket_count() == 0 ? nullptr : &*m_ctrl.cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::value_type* CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::slots()
+{
+    return bucket_count() == 0 ? nullptr : &*m_slots.begin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const typename CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::value_type* CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::slots() const
+{
+    return bucket_count() == 0 ? nullptr : &*m_slots.cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctz(mask));
+#else
+    size_t index = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::capacity_limit(size_t slot_count) const
+{
+    // At least one slot stays empty to terminate probing
+    size_t limit = static_cast<size_t>(slot_count * m_max_load_factor);
+    return limit < slot_count ? limit : slot_count - 1;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::lookup(const key_type& key, size_t hash) const
+{
+    if (m_size == 0)
+        return npos;
+
+    const int8_t* control = ctrl();
+    const value_type* items = slots();
+    int8_t h2 = static_cast<int8_t>(hash & 0x7F);
+    size_t group = (hash >> 7) & m_group_mask;
+    for (size_t step = 1; ; step++)
+    {
+        size_t first = group * GroupWidth;
+        Group probe(control + first);
+        for (uint32_t mask = probe.match(h2); mask != 0; mask &= mask - 1)
+        {
+            size_t index = first + lowest_bit(mask);
+            if (m_equal(items[index].first, key))
+                return index;
+        }
+        if (probe.match_empty() != 0)
+            return npos;
+        group = (group + step) & m_group_mask;
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::find_free(size_t hash) const
+{
+    const int8_t* control = ctrl();
+    size_t group = (hash >> 7) & m_group_mask;
+    for (size_t step = 1; ; step++)
+    {
+        uint32_t mask = Group(control + group * GroupWidth).match_free();
+        if (mask != 0)
+            return group * GroupWidth + lowest_bit(mask);
+        group = (group + step) & m_group_mask;
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::emplace_slot(value_type&& value, bool assign)
+{
+    size_t hash = hash_mix(m_hash(value.first));
+    size_t existing = lookup(value.first, hash);
+    if (existing != npos)
+    {
+        if (assign)
+            slots()[existing].second = std::move(value.second);
+        return existing;
+    }
+    if (bucket_count() == 0)
+        rehash(MinSlots);
+    return place(std::move(value), hash);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::place(value_type&& value, size_t hash)
+{
+    size_t index = find_free(hash);
+    if (m_growth_left == 0 && ctrl()[index] == Empty)
+    {
+        // Mostly tombstones: rehashing in place frees them, otherwise the table grows
+        size_t slot_count = bucket_count();
+        if (m_size >= capacity_limit(slot_count) / 2)
+            slot_count *= 2;
+        // Small load factors need more than one doubling to fit one more item
+        while (capacity_limit(slot_count) <= m_size)
+            slot_count *= 2;
+        rehash(slot_count);
+        index = find_free(hash);
+    }
+
+    int8_t* control = ctrl();
+    if (control[index] == Empty)
+        m_growth_left--;
+    control[index] = static_cast<int8_t>(hash & 0x7F);
+    slots()[index] = std::move(value);
+    m_size++;
+    return index;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::FlatHashMap<Key, T, Hash, KeyEqual>::rehash(size_t slot_count)
+{
+    Array<int8_t> old_ctrl(std::move(m_ctrl));
+    Array<value_type> old_slots(std::move(m_slots));
+    size_t old_count = old_ctrl.size();
+
+    m_ctrl = Array<int8_t>();
+    m_slots = Array<value_type>();
+    m_ctrl.reserve(slot_count);
+    m_slots.reserve(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+    {
+        m_ctrl.push_back(Empty);
+        m_slots.push_back(value_type());
+    }
+    m_group_mask = slot_count / GroupWidth - 1;
+    m_growth_left = capacity_limit(slot_count);
+    m_size = 0;
+
+    for (size_t i = 0; i < old_count; i++)
+    {
+        if (old_ctrl[i] >= 0)
+        {
+            size_t hash = hash_mix(m_hash(old_slots[i].first));
+            place(std::move(old_slots[i]), hash);
+        }
+    }
+}
+
+#endif //FLAT_HASH_MAP_HPP
@@ -0,0 +1,567 @@
+#ifndef HASH_CHAINS_HPP
+#define HASH_CHAINS_HPP
+
+#include "array.hpp"
+#include "hash_mix.hpp"
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace CppADS
+{
+    /// @private
+    template<typename... Types>
+    struct MakeVoid
+    {
+        using type = void;
+    };
+
+    /// @brief Check if Hash and KeyEqual accept keys of other types than the key type
+    /// @details Both must declare is_transparent member type. K is the type of lookup key.
+    template<typename Hash, typename KeyEqual, typename K, typename = void>
+    struct TransparentLookup : std::false_type
+    {
+    };
+
+    template<typename Hash, typename KeyEqual, typename K>
+    struct TransparentLookup<Hash, KeyEqual, K, typename MakeVoid<typename Hash::is_transparent, typename KeyEqual::is_transparent>::type>
+        : std::true_type
+    {
+    };
+
+    /// @private
+    /// @brief Hash value kept in hash table nodes, empty if hashes aren't stored
+    template<bool Enabled>
+    struct StoredHash
+    {
+        void store(size_t) {}
+        bool may_match(size_t) const { return true; }
+        template<typename Compute>
+        size_t get(Compute compute) const { return compute(); }
+    };
+
+    /// @private
+    template<>
+    struct StoredHash<true>
+    {
+        size_t hash { 0 };
+
+        void store(size_t value) { hash = value; }
+        bool may_match(size_t value) const { return hash == value; }
+        template<typename Compute>
+        size_t get(Compute) const { return hash; }
+    };
+
+    /// @brief Key of a set item, the item itself
+    struct IdentityKeyOf
+    {
+        template<typename Value>
+        static const Value& get(const Value& value) { return value; }
+    };
+
+    /// @brief Key of a map item, the first member of the pair
+    struct PairKeyOf
+    {
+        template<typename Pair>
+        static const typename Pair::first_type& get(const Pair& value) { return value.first; }
+    };
+
+    /// @brief Separate chaining core of HashTable, HashSet and HashMultiMap
+    /// @details Owns power-of-two (or any, with FastRangeReduction) array of buckets with
+    /// singly linked chains of nodes and does hashing, lookup, growth and incremental
+    /// rehashing; containers put their interface on top. While rehashing incrementally
+    /// the old bucket array is kept next to the new one and step() moves a few old
+    /// buckets. Nodes are relinked, never reallocated.
+    ///
+    /// New nodes are linked in front of the found position, so nodes with equal keys
+    /// stay next to each other in their chain.
+    /// @tparam Value item type stored in nodes
+    /// @tparam KeyOf extractor of key from item (IdentityKeyOf or PairKeyOf)
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    /// @tparam Reduction mapping of mixed hash to bucket index (MaskReduction or FastRangeReduction)
+    /// @tparam StoreHash keep hash value in every node
+    template <typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+    class HashChains
+    {
+    public:
+        struct Node;
+        using Bucket = std::unique_ptr<Node>;
+
+        /// @brief Chain node
+        struct Node : StoredHash<StoreHash>
+        {
+            Value value;
+            Bucket next;
+
+            template<typename... Args>
+            explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+        };
+
+        /// @brief Place of a key in buckets
+        struct Position
+        {
+            size_t table;       ///< 0 for current buckets, 1 for old buckets
+            size_t bucket;      ///< Bucket index in the table
+            size_t hash;        ///< Mixed hash of the key
+            Bucket* link;       ///< Link to the first node with the key or the empty link at the end of chain
+
+            bool found() const {
+                return link != nullptr && *link;
+            }
+        };
+
+        /// @brief Count of bucket arrays visited by iterators
+        static constexpr size_t TableCount = 2;
+
+        HashChains();                                   ///< Default constructor, one bucket
+        HashChains(const HashChains& copy);             ///< Copy constructor
+        HashChains(HashChains&& move);                  ///< Move constructor, source has no buckets
+
+        HashChains& operator=(const HashChains& copy);  ///< Copy assignment operator
+        HashChains& operator=(HashChains&& move);       ///< Move assignment operator
+
+        /// @return count of nodes
+        size_t size() const { return m_size; }
+        /// @return count of current buckets
+        size_t bucket_count() const { return m_buckets.size(); }
+        /// @return maximum average count of nodes per bucket
+        float max_load_factor() const { return m_max_load_factor; }
+        /// @return current average count of nodes per bucket
+        float load_factor() const;
+
+        /// @brief Set maximum load factor and grow if needed
+        /// @param load_factor new maximum load factor, positive
+        void set_max_load_factor(float load_factor);
+
+        /// @brief Reserve buckets for count of nodes
+        void reserve(size_t count);
+        /// @brief Reserve buckets for a range which is about to be inserted, if its length is known
+        template<typename InputIt>
+        void reserve_range(InputIt first, InputIt last);
+        /// @brief Rebuild at once with at least bucket_count buckets (power of two, enough for size)
+        void rehash(size_t bucket_count);
+
+        /// @brief Set count of old buckets moved by every step, 0 rehashes at once
+        void set_rehash_step(size_t buckets);
+        /// @return count of old buckets moved by every step
+        size_t rehash_step() const { return m_rehash_step; }
+        /// @return true if old buckets aren't moved yet
+        bool rehashing() const { return m_old_buckets.size() != 0; }
+        /// @brief Move the next few old buckets, called by modifying operations
+        void step() { migrate(m_rehash_step); }
+
+        /// @brief Remove all nodes, one bucket is left
+        void clear();
+
+        /// @brief Get bucket array, 0 is current and 1 is old one
+        CppADS::Array<Bucket>& table(size_t index) { return index == 0 ? m_buckets : m_old_buckets; }
+        /// @brief Get bucket array, 0 is current and 1 is old one
+        const CppADS::Array<Bucket>& table(size_t index) const { return index == 0 ? m_buckets : m_old_buckets; }
+
+        /// @brief Find the link which holds the first node with the key or where it would be linked
+        /// @details Link is mutable for non-const callers, buckets are empty if link is nullptr
+        template<typename K>
+        Position locate(const K& key) const;
+        /// @brief Find the link which holds the key with known mixed hash
+        template<typename K>
+        Position locate(const K& key, size_t hash) const;
+
+        /// @brief Check if node holds the key with known mixed hash
+        template<typename K>
+        bool matches(const Node& node, const K& key, size_t hash) const;
+
+        /// @brief Link node in front of position and grow the table if needed
+        /// @return position of linked node
+        Position attach(Position position, Bucket&& node);
+
+        /// @brief Unlink and destroy node at position, link moves to the next node
+        void detach(Position& position);
+
+        const Hash& hash_function() const { return m_hash; }
+        const KeyEqual& key_eq() const { return m_equal; }
+
+    private:
+        CppADS::Array<Bucket> m_buckets;
+        CppADS::Array<Bucket> m_old_buckets;    ///< Buckets drained by incremental rehashing
+        size_t m_migrated { 0 };                ///< Count of drained old buckets
+        size_t m_rehash_step { 0 };
+
+        size_t m_size { 0 };
+        float m_max_load_factor { 1.0f };
+        Hash m_hash {};
+        KeyEqual m_equal {};
+
+        /// @brief Get mixed hash of node key, stored one if available
+        inline size_t node_hash(const Node& node) const;
+
+        /// @brief Get power-of-two bucket count which keeps count elements under the load factor
+        size_t buckets_for(size_t count) const;
+
+        template<typename InputIt>
+        void reserve_range(InputIt first, InputIt last, std::input_iterator_tag);
+        template<typename InputIt>
+        void reserve_range(InputIt first, InputIt last, std::forward_iterator_tag);
+
+        /// @brief Start moving nodes to a new bucket array
+        void start_rehash(size_t bucket_count);
+        /// @brief Move nodes from count old buckets to the new ones
+        void migrate(size_t count);
+
+        static CppADS::Array<Bucket> copy_buckets(const CppADS::Array<Bucket>& buckets);
+    };
+
+    /// @brief Forward iterator over nodes of HashChains
+    /// @details Visits current buckets and then old buckets of incremental rehashing.
+    /// @tparam Chains HashChains type, const for read-only iterators
+    /// @tparam Node node type, const for read-only iterators
+    /// @tparam Value item type, const for read-only iterators
+    template<typename Chains, typename Node, typename Value>
+    class HashChainsIterator : public std::iterator<std::forward_iterator_tag, typename std::remove_const<Value>::type>
+    {
+    private:
+        Chains* m_chains { nullptr };
+        size_t m_table { std::remove_const<Chains>::type::TableCount };
+        size_t m_bucket { 0 };
+        Node* m_node { nullptr };
+
+        /// Move to the first node at or after current bucket
+        void seek() {
+            for (; m_table < std::remove_const<Chains>::type::TableCount; m_table++, m_bucket = 0)
+            {
+                auto& buckets = m_chains->table(m_table);
+                for (; m_bucket < buckets.size(); m_bucket++)
+                {
+                    m_node = buckets[m_bucket].get();
+                    if (m_node != nullptr)
+                        return;
+                }
+            }
+            m_bucket = 0;
+        }
+
+    public:
+        HashChainsIterator() = default;
+
+        /// @brief Constructor
+        /// @details Null node means the first node at or after the bucket, table equal
+        /// to TableCount is the end.
+        HashChainsIterator(Chains* chains, size_t table, size_t bucket, Node* node)
+            : m_chains(chains), m_table(table), m_bucket(bucket), m_node(node)
+        {
+            if (m_node == nullptr)
+                seek();
+        }
+
+        Value& operator*() const {
+            return m_node->value;
+        }
+        Value* operator->() const {
+            return &m_node->value;
+        }
+
+        HashChainsIterator& operator++() {
+            m_node = m_node->next.get();
+            if (m_node == nullptr)
+            {
+                m_bucket++;
+                seek();
+            }
+            return *this;
+        }
+        HashChainsIterator operator++(int) {
+            HashChainsIterator result(*this);
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const HashChainsIterator& rhs) const {
+            return (m_table == rhs.m_table && m_bucket == rhs.m_bucket && m_node == rhs.m_node);
+        }
+        bool operator!=(const HashChainsIterator& rhs) const {
+            return !(this->operator==(rhs));
+        }
+    };
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+constexpr size_t CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::TableCount;
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::HashChains()
+{
+    m_buckets.push_back(Bucket());
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::HashChains(const HashChains& copy)
+    : m_buckets(copy_buckets(copy.m_buckets)), m_old_buckets(copy_buckets(copy.m_old_buckets)), m_migrated(copy.m_migrated),
+      m_rehash_step(copy.m_rehash_step), m_size(copy.m_size), m_max_load_factor(copy.m_max_load_factor),
+      m_hash(copy.m_hash), m_equal(copy.m_equal)
+{}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::HashChains(HashChains&& move)
+    : m_buckets(std::move(move.m_buckets)), m_old_buckets(std::move(move.m_old_buckets)), m_migrated(move.m_migrated),
+      m_rehash_step(move.m_rehash_step), m_size(move.m_size), m_max_load_factor(move.m_max_load_factor),
+      m_hash(std::move(move.m_hash)), m_equal(std::move(move.m_equal))
+{
+    move.m_migrated = 0;
+    move.m_size = 0;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>& CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::operator=(const HashChains& copy)
+{
+    if (this != &copy)
+        *this = HashChains(copy);
+    return *this;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>& CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::operator=(HashChains&& move)
+{
+    m_buckets = std::move(move.m_buckets);
+    m_old_buckets = std::move(move.m_old_buckets);
+    m_migrated = move.m_migrated;
+    m_rehash_step = move.m_rehash_step;
+    m_size = move.m_size;
+    m_max_load_factor = move.m_max_load_factor;
+    m_hash = std::move(move.m_hash);
+    m_equal = std::move(move.m_equal);
+    move.m_migrated = 0;
+    move.m_size = 0;
+    return *this;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::load_factor() const
+{
+    return bucket_count() == 0 ? 0.0f : static_cast<float>(size()) / bucket_count();
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::set_max_load_factor(float load_factor)
+{
+    m_max_load_factor = load_factor;
+    reserve(size());
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::reserve(size_t count)
+{
+    size_t buckets = buckets_for(count);
+    if (buckets > bucket_count())
+        start_rehash(buckets);
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::reserve_range(InputIt first, InputIt last)
+{
+    reserve_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::rehash(size_t bucket_count)
+{
+    size_t buckets = buckets_for(size());
+    while (buckets < bucket_count)
+        buckets *= 2;
+    if (buckets != this->bucket_count() || rehashing())
+    {
+        // Explicit rehash is done at once
+        start_rehash(buckets);
+        migrate(m_old_buckets.size());
+    }
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::set_rehash_step(size_t buckets)
+{
+    m_rehash_step = buckets;
+    if (m_rehash_step == 0)
+        migrate(m_old_buckets.size());
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::clear()
+{
+    m_buckets = CppADS::Array<Bucket>();
+    m_old_buckets = CppADS::Array<Bucket>();
+    m_buckets.push_back(Bucket());
+    m_migrated = 0;
+    m_size = 0;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::Position CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::locate(const K& key) const
+{
+    return locate(key, hash_mix(m_hash(key)));
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::Position CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::locate(const K& key, size_t hash) const
+{
+    Position position { 0, 0, hash, nullptr };
+    if (m_buckets.size() == 0)
+        return position;
+
+    // Key is in the old bucket until that bucket is drained
+    if (rehashing())
+    {
+        size_t address = Reduction::reduce(hash, m_old_buckets.size());
+        if (address >= m_migrated)
+        {
+            position.table = 1;
+            position.bucket = address;
+        }
+    }
+    if (position.table == 0)
+        position.bucket = Reduction::reduce(hash, m_buckets.size());
+
+    // Buckets are owned by the chains, constness is restored by the public callers
+    Bucket* link = const_cast<Bucket*>(&table(position.table)[position.bucket]);
+    while (*link && !matches(**link, key, hash))
+        link = &(*link)->next;
+    position.link = link;
+    return position;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+bool CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::matches(const Node& node, const K& key, size_t hash) const
+{
+    return node.may_match(hash) && m_equal(KeyOf::get(node.value), key);
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::Position CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::attach(Position position, Bucket&& node)
+{
+    if (position.link == nullptr)
+    {
+        // Moved-from chains without buckets
+        start_rehash(1);
+        return attach(locate(KeyOf::get(node->value), position.hash), std::move(node));
+    }
+
+    node->store(position.hash);
+    const Node* attached = node.get();
+    node->next = std::move(*position.link);
+    *position.link = std::move(node);
+    m_size++;
+
+    // Links move with the bucket arrays, nodes stay in place
+    if (!rehashing() && size() > bucket_count() * max_load_factor())
+    {
+        start_rehash(bucket_count() * 2);
+        position = locate(KeyOf::get(attached->value), position.hash);
+        // Rehashing may reorder nodes with equal keys
+        while (position.link->get() != attached)
+            position.link = &(*position.link)->next;
+    }
+    return position;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::detach(Position& position)
+{
+    *position.link = std::move((*position.link)->next);
+    m_size--;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::node_hash(const Node& node) const
+{
+    return node.get([this, &node]() { return hash_mix(m_hash(KeyOf::get(node.value))); });
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::buckets_for(size_t count) const
+{
+    size_t buckets = 1;
+    while (buckets * max_load_factor() < count)
+        buckets *= 2;
+    return buckets;
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::reserve_range(InputIt, InputIt, std::input_iterator_tag)
+{
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::reserve_range(InputIt first, InputIt last, std::forward_iterator_tag)
+{
+    reserve(size() + static_cast<size_t>(std::distance(first, last)));
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::start_rehash(size_t bucket_count)
+{
+    migrate(m_old_buckets.size());
+
+    m_old_buckets = std::move(m_buckets);
+    m_buckets = CppADS::Array<Bucket>();
+    m_buckets.reserve(bucket_count);
+    while(m_buckets.size() < bucket_count)
+        m_buckets.push_back(Bucket());
+    m_migrated = 0;
+
+    migrate(m_rehash_step == 0 ? m_old_buckets.size() : m_rehash_step);
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::migrate(size_t count)
+{
+    size_t old_count = m_old_buckets.size();
+    if (old_count == 0)
+        return;
+
+    size_t new_count = m_buckets.size();
+    for (; count > 0 && m_migrated < old_count; count--, m_migrated++)
+    {
+        Bucket chain = std::move(m_old_buckets[m_migrated]);
+        while (chain)
+        {
+            Bucket node = std::move(chain);
+            chain = std::move(node->next);
+            Bucket& head = m_buckets[Reduction::reduce(node_hash(*node), new_count)];
+            node->next = std::move(head);
+            head = std::move(node);
+        }
+    }
+
+    if (m_migrated == old_count)
+    {
+        m_old_buckets = CppADS::Array<Bucket>();
+        m_migrated = 0;
+    }
+}
+
+template<typename Value, typename KeyOf, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::Array<typename CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::Bucket> CppADS::HashChains<Value, KeyOf, Hash, KeyEqual, Reduction, StoreHash>::copy_buckets(const CppADS::Array<Bucket>& buckets)
+{
+    CppADS::Array<Bucket> result;
+    result.reserve(buckets.size());
+    for (size_t i = 0; i < buckets.size(); i++)
+    {
+        result.push_back(Bucket());
+        Bucket* tail = &result.back();
+        for (const Node* node = buckets[i].get(); node != nullptr; node = node->next.get())
+        {
+            *tail = Bucket(new Node(node->value));
+            static_cast<StoredHash<StoreHash>&>(**tail) = *node;
+            tail = &(*tail)->next;
+        }
+    }
+    return result;
+}
+
+#endif //HASH_CHAINS_HPP
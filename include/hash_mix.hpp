@@ -0,0 +1,67 @@
+#ifndef HASH_MIX_HPP
+#define HASH_MIX_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CppADS
+{
+#if defined(__SIZEOF_INT128__)
+    /// @brief Unsigned 128-bit integer of the compiler, __extension__ keeps -Wpedantic quiet
+    __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+    /// @brief Spread bits of hash value over the whole word
+    /// @details std::hash of integers is usually identity, so tables which take low bits
+    /// of a hash (power-of-two sizes) or split it into parts need all bits to depend on
+    /// all bits of the key. This is the finalizer of MurmurHash3.
+    /// @param hash hash value
+    /// @return mixed hash value
+    inline size_t hash_mix(size_t hash)
+    {
+        uint64_t value = hash;
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return static_cast<size_t>(value);
+    }
+
+    /// @brief Map mixed hash to bucket index with a bit mask of low bits
+    /// @details Bucket count must be a power of two.
+    struct MaskReduction
+    {
+        static size_t reduce(size_t hash, size_t bucket_count)
+        {
+            return hash & (bucket_count - 1);
+        }
+    };
+
+    /// @brief Map mixed hash to bucket index with a multiplication (fastrange)
+    /// @details Index is the high word (size_t wide) of hash * bucket_count, so it is taken from
+    /// the high bits of the hash and works with any bucket count.
+    struct FastRangeReduction
+    {
+        static size_t reduce(size_t hash, size_t bucket_count)
+        {
+            // With 32-bit size_t the whole product fits into 64 bits
+            if (sizeof(size_t) == 4)
+                return static_cast<size_t>((static_cast<uint64_t>(hash) * bucket_count) >> 32);
+#if defined(__SIZEOF_INT128__)
+            return static_cast<size_t>((static_cast<uint128_t>(hash) * bucket_count) >> 64);
+#else
+            // High word of the 64x64 product from 32-bit halves
+            uint64_t a = hash;
+            uint64_t b = bucket_count;
+            uint64_t low_low = (a & 0xffffffffULL) * (b & 0xffffffffULL);
+            uint64_t high_low = (a >> 32) * (b & 0xffffffffULL);
+            uint64_t low_high = (a & 0xffffffffULL) * (b >> 32);
+            uint64_t cross = (low_low >> 32) + (high_low & 0xffffffffULL) + low_high;
+            return static_cast<size_t>((a >> 32) * (b >> 32) + (high_low >> 32) + (cross >> 32));
+#endif
+        }
+    };
+}
+
+#endif //HASH_MIX_HPP
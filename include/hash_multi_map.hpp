@@ -0,0 +1,390 @@
+#ifndef HASH_MULTI_MAP_HPP
+#define HASH_MULTI_MAP_HPP
+
+#include "container.hpp"
+#include "hash_chains.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Hash multimap class
+    /// @details Map with any number of values per key on the same separate chaining core
+    /// as HashTable (see HashChains). Every value is a node of its own, items with equal
+    /// keys are adjacent in their chain, so equal_range is a single walk and no extra
+    /// container per key is allocated. Order of values of one key is unspecified.
+    /// @tparam Key hashed key type
+    /// @tparam T stored value type
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    /// @tparam Reduction mapping of mixed hash to bucket index (MaskReduction or FastRangeReduction)
+    /// @tparam StoreHash keep hash value in every node: rehashing doesn't call Hash and
+    /// lookups compare keys only if their hashes are equal
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Reduction = MaskReduction, bool StoreHash = false>
+    class HashMultiMap : public IContainer
+    {
+        using Chains = HashChains<std::pair<Key, T>, PairKeyOf, Hash, KeyEqual, Reduction, StoreHash>;
+        using Node = typename Chains::Node;
+        using Position = typename Chains::Position;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<key_type, mapped_type>;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        using iterator = HashChainsIterator<Chains, Node, value_type>;
+        using const_iterator = HashChainsIterator<const Chains, const Node, const value_type>;
+
+        HashMultiMap() = default;                                       ///< Default contructor
+        HashMultiMap(const HashMultiMap& copy) = default;               ///< Copy contructor
+        HashMultiMap(HashMultiMap&& move) = default;                    ///< Move contructor
+        HashMultiMap(std::initializer_list<value_type> init_list);      ///< Contructor from initializer list
+
+        HashMultiMap& operator=(const HashMultiMap& copy) = default;    ///< Copy assignment operator
+        HashMultiMap& operator=(HashMultiMap&& move) = default;         ///< Move assignment operator
+
+        ~HashMultiMap() = default;                                      ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return count of values of all keys
+        size_t size() const override;
+
+        /// @brief Get current number of buckets
+        /// @return number of buckets
+        size_t bucket_count() const;
+
+        /// @brief Get current average number of values per bucket
+        /// @return load factor
+        float load_factor() const;
+
+        /// @}
+        /// @name Hash policy
+        /// @{
+
+        /// @brief Set maximum average number of values per bucket
+        /// @param load_factor new maximum load factor, positive
+        void set_load_factor(float load_factor);
+
+        /// @brief Reserve buckets for specific count of values
+        /// @param count count of values which fit without rehashing
+        void reserve(size_t count);
+
+        /// @brief Set count of old buckets moved by each operation while rehashing
+        /// @param buckets buckets moved per insert, remove or non-const lookup, 0 rehashes at once
+        void set_rehash_step(size_t buckets);
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Add value to the key, existing values are kept
+        /// @param pair key-value pair to insert
+        /// @return iterator to inserted item
+        iterator insert(const value_type& pair);
+        /// @brief Add value to the key, existing values are kept
+        /// @param pair key-value pair to insert
+        /// @return iterator to inserted item
+        iterator insert(value_type&& pair);
+        /// @brief Insert range of key-value pairs
+        /// @details Table is sized once for the whole range if its length is known.
+        /// @param first iterator to the first key-value pair
+        /// @param last iterator after the last key-value pair
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last);
+
+        /// @brief Construct item from arguments and add it
+        /// @param args arguments of key-value pair constructor
+        /// @return iterator to inserted item
+        template<typename... Args>
+        iterator emplace(Args&&... args);
+
+        /// @brief Remove all values of the key
+        /// @param key key to remove
+        /// @return count of removed values
+        size_t remove(const key_type& key);
+
+        /// @}
+        /// @name Lookup
+        /// @{
+
+        /// @brief Search for some value of the key
+        /// @param key key to search for
+        /// @return iterator to found item (end if key not found)
+        iterator find(const key_type& key);
+        /// @brief Search for some value of the key
+        /// @param key key to search for
+        /// @return iterator to found item (end if key not found)
+        const_iterator find(const key_type& key) const;
+
+        /// @brief Get all values of the key
+        /// @param key key to search for
+        /// @return range of items with the key (both end if key not found)
+        std::pair<iterator, iterator> equal_range(const key_type& key);
+        /// @brief Get all values of the key
+        /// @param key key to search for
+        /// @return range of items with the key (both end if key not found)
+        std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const;
+
+        /// @brief Get count of values of the key
+        /// @param key key to search for
+        /// @return count of values
+        size_t count(const key_type& key) const;
+
+        /// @brief Check if container has the key
+        /// @param key key to search for
+        /// @return true if key is found
+        bool contains(const key_type& key) const;
+
+        /// @}
+        /// @name Iterators
+        /// @{
+
+        /// @return read-write iterator to the first element of the container
+        iterator begin();
+        /// @return read-only iterator to the first element of the container
+        const_iterator begin() const;
+        /// @return read-only iterator to the first element of the container
+        const_iterator cbegin() const;
+
+        /// @return read-write iterator to the element after the last element of the container
+        iterator end();
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator end() const;
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator cend() const;
+
+        /// @}
+
+        /// @brief Compare containers, values of a key may be in any order
+        bool operator==(const HashMultiMap& rhs) const;
+        bool operator!=(const HashMultiMap& rhs) const;
+
+    private:
+        Chains m_chains;
+
+        /// @brief Get end of range of items with the key which starts at first
+        template<typename Iterator>
+        Iterator range_end(Iterator first, Iterator last, const key_type& key) const;
+    };
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::HashMultiMap(std::initializer_list<value_type> init_list)
+{
+    insert(init_list.begin(), init_list.end());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::size() const
+{
+    return m_chains.size();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::bucket_count() const
+{
+    return m_chains.bucket_count();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::load_factor() const
+{
+    return m_chains.load_factor();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::set_load_factor(float load_factor)
+{
+    if (!(load_factor > 0.0f))
+        throw std::invalid_argument("CppADS::HashMultiMap::set_load_factor: load factor must be positive");
+    m_chains.set_max_load_factor(load_factor);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::reserve(size_t count)
+{
+    m_chains.reserve(count);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::set_rehash_step(size_t buckets)
+{
+    m_chains.set_rehash_step(buckets);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::clear()
+{
+    m_chains.clear();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(const value_type& pair)
+{
+    return emplace(pair);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(value_type&& pair)
+{
+    return emplace(std::move(pair));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(InputIt first, InputIt last)
+{
+    m_chains.reserve_range(first, last);
+    for (; first != last; ++first)
+        insert(*first);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename... Args>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::emplace(Args&&... args)
+{
+    m_chains.step();
+    std::unique_ptr<Node> node(new Node(std::forward<Args>(args)...));
+    // Linked in front of the first item with the same key
+    Position position = m_chains.attach(m_chains.locate(node->value.first), std::move(node));
+    return iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::remove(const key_type& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    size_t removed = 0;
+    while (position.found() && m_chains.matches(**position.link, key, position.hash))
+    {
+        m_chains.detach(position);
+        removed++;
+    }
+    return removed;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const key_type& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return end();
+    return iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const key_type& key) const
+{
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return cend();
+    return const_iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator> CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::equal_range(const key_type& key)
+{
+    iterator first = find(key);
+    return std::make_pair(first, range_end(first, end(), key));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator, typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator> CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::equal_range(const key_type& key) const
+{
+    const_iterator first = find(key);
+    return std::make_pair(first, range_end(first, cend(), key));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::count(const key_type& key) const
+{
+    auto range = equal_range(key);
+    return static_cast<size_t>(std::distance(range.first, range.second));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::contains(const key_type& key) const
+{
+    return m_chains.locate(key).found();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::begin() {
+    return iterator(&m_chains, 0, 0, nullptr);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::begin() const {
+    return cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::cbegin() const {
+    return const_iterator(&m_chains, 0, 0, nullptr);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::end() {
+    return iterator(&m_chains, Chains::TableCount, 0, nullptr);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::end() const {
+    return cend();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::cend() const {
+    return const_iterator(&m_chains, Chains::TableCount, 0, nullptr);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator==(const HashMultiMap& rhs) const
+{
+    if (size() != rhs.size())
+        return false;
+    for (auto it = cbegin(); it != cend();)
+    {
+        auto range = equal_range(it->first);
+        auto other = rhs.equal_range(it->first);
+        if (!std::is_permutation(range.first, range.second, other.first, other.second))
+            return false;
+        it = range.second;
+    }
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator!=(const HashMultiMap& rhs) const
+{
+    return !(operator==(rhs));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename Iterator>
+Iterator CppADS::HashMultiMap<Key, T, Hash, KeyEqual, Reduction, StoreHash>::range_end(Iterator first, Iterator last, const key_type& key) const
+{
+    while (first != last && m_chains.key_eq()(first->first, key))
+        ++first;
+    return first;
+}
+
+#endif
@@ -0,0 +1,479 @@
+#ifndef HASH_SET_HPP
+#define HASH_SET_HPP
+
+#include "container.hpp"
+#include "hash_chains.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Hash set class
+    /// @details Set of unique keys on the same separate chaining core as HashTable
+    /// (see HashChains), nodes hold only the key. Keys can't be changed in place, so
+    /// all iterators are read-only.
+    /// @tparam Key hashed key type
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    /// @tparam Reduction mapping of mixed hash to bucket index (MaskReduction or FastRangeReduction)
+    /// @tparam StoreHash keep hash value in every node: rehashing doesn't call Hash and
+    /// lookups compare keys only if their hashes are equal
+    template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Reduction = MaskReduction, bool StoreHash = false>
+    class HashSet : public IContainer
+    {
+        using Chains = HashChains<Key, IdentityKeyOf, Hash, KeyEqual, Reduction, StoreHash>;
+        using Node = typename Chains::Node;
+        using Position = typename Chains::Position;
+
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using reference = const value_type&;
+        using const_reference = const value_type&;
+        using pointer = const value_type*;
+        using const_pointer = const value_type*;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        using iterator = HashChainsIterator<const Chains, const Node, const value_type>;
+        using const_iterator = iterator;
+
+        /// @brief Result type R of members which take keys of other types
+        template<typename K, typename R>
+        using if_transparent = typename std::enable_if<TransparentLookup<Hash, KeyEqual, K>::value, R>::type;
+
+        HashSet() = default;                                            ///< Default contructor
+        HashSet(const HashSet& copy) = default;                         ///< Copy contructor
+        HashSet(HashSet&& move) = default;                              ///< Move contructor
+        HashSet(std::initializer_list<value_type> init_list);           ///< Contructor from initializer list
+
+        HashSet& operator=(const HashSet& copy) = default;              ///< Copy assignment operator
+        HashSet& operator=(HashSet&& move) = default;                   ///< Move assignment operator
+
+        ~HashSet() = default;                                           ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get current number of buckets
+        /// @return number of buckets
+        size_t bucket_count() const;
+
+        /// @brief Get maximum average number of elements per bucket
+        /// @return maximum load factor
+        float max_load_factor() const;
+
+        /// @brief Get current average number of elements per bucket
+        /// @return load factor
+        float load_factor() const;
+
+        /// @}
+        /// @name Hash policy
+        /// @{
+
+        /// @brief Set maximum average number of elements per bucket
+        /// @param load_factor new maximum load factor, positive
+        void set_load_factor(float load_factor);
+
+        /// @brief Reserve buckets for specific count of elements
+        /// @param count count of elements which fit without rehashing
+        void reserve(size_t count);
+
+        /// @brief Rebuild the set with specific number of buckets
+        /// @param bucket_count requested number of buckets, rounded up as in HashTable::rehash
+        void rehash(size_t bucket_count);
+
+        /// @brief Set count of old buckets moved by each operation while rehashing
+        /// @param buckets buckets moved per insert, remove or non-const lookup, 0 rehashes at once
+        void set_rehash_step(size_t buckets);
+
+        /// @brief Check if incremental rehashing is in progress
+        /// @return true if old buckets aren't moved yet
+        bool rehashing() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert key if it is missing
+        /// @param key key to insert
+        /// @return iterator to the key and true if the key was inserted
+        std::pair<iterator, bool> insert(const value_type& key);
+        /// @brief Insert key if it is missing
+        /// @param key key to insert
+        /// @return iterator to the key and true if the key was inserted
+        std::pair<iterator, bool> insert(value_type&& key);
+        /// @brief Insert range of keys
+        /// @details Set is sized once for the whole range if its length is known.
+        /// @param first iterator to the first key
+        /// @param last iterator after the last key
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last);
+
+        /// @brief Construct key from arguments and insert it if it is missing
+        /// @param args arguments of key constructor
+        /// @return iterator to the key and true if the key was inserted
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args);
+
+        /// @brief Remove key
+        /// @param key key to remove
+        /// @return true if the key was removed
+        bool remove(const key_type& key);
+        /// @brief Remove key, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return true if the key was removed
+        template<typename K>
+        if_transparent<K, bool> remove(const K& key);
+
+        /// @}
+        /// @name Lookup
+        /// @{
+
+        /// @brief Search for key
+        /// @param key key to search for
+        /// @return iterator to found key (end if key not found)
+        const_iterator find(const key_type& key) const;
+        /// @brief Search for key, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return iterator to found key (end if key not found)
+        template<typename K>
+        if_transparent<K, const_iterator> find(const K& key) const;
+
+        /// @brief Check if set has the key
+        /// @param key key to search for
+        /// @return true if key is found
+        bool contains(const key_type& key) const;
+        /// @brief Check if set has the key, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return true if key is found
+        template<typename K>
+        if_transparent<K, bool> contains(const K& key) const;
+
+        /// @}
+        /// @name Iterators
+        /// @{
+
+        /// @return read-only iterator to the first element of the container
+        const_iterator begin() const;
+        /// @return read-only iterator to the first element of the container
+        const_iterator cbegin() const;
+
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator end() const;
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator cend() const;
+
+        /// @}
+
+        bool operator==(const HashSet& rhs) const;
+        bool operator!=(const HashSet& rhs) const;
+
+    private:
+        Chains m_chains;
+
+        const_iterator make_iterator(const Position& position) const;
+
+        /// @brief Insert node if its key is missing
+        std::pair<iterator, bool> insert_node(std::unique_ptr<Node>&& node);
+
+        template<typename K>
+        bool remove_key(const K& key);
+    };
+
+    /// @brief Union of two sets
+    /// @details The larger set is copied and the keys of the smaller one are inserted.
+    /// @return set with keys of both sets
+    template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> unite(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                             const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs);
+
+    /// @brief Intersection of two sets
+    /// @details Keys of the smaller set are searched in the larger one.
+    /// @return set with keys present in both sets
+    template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> intersect(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                                 const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs);
+
+    /// @brief Difference of two sets
+    /// @details If lhs is smaller its keys are searched in rhs, otherwise lhs is copied
+    /// and the keys of rhs are removed.
+    /// @return set with keys of lhs which are missing in rhs
+    template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> difference(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                                  const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::HashSet(std::initializer_list<value_type> init_list)
+{
+    insert(init_list.begin(), init_list.end());
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::size() const
+{
+    return m_chains.size();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::bucket_count() const
+{
+    return m_chains.bucket_count();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::max_load_factor() const
+{
+    return m_chains.max_load_factor();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::load_factor() const
+{
+    return m_chains.load_factor();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::set_load_factor(float load_factor)
+{
+    if (!(load_factor > 0.0f))
+        throw std::invalid_argument("CppADS::HashSet::set_load_factor: load factor must be positive");
+    m_chains.set_max_load_factor(load_factor);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::reserve(size_t count)
+{
+    m_chains.reserve(count);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::rehash(size_t bucket_count)
+{
+    m_chains.rehash(bucket_count);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::set_rehash_step(size_t buckets)
+{
+    m_chains.set_rehash_step(buckets);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::rehashing() const
+{
+    return m_chains.rehashing();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::clear()
+{
+    m_chains.clear();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::insert(const value_type& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (position.found())
+        return std::make_pair(make_iterator(position), false);
+    return std::make_pair(make_iterator(m_chains.attach(position, std::unique_ptr<Node>(new Node(key)))), true);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::insert(value_type&& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (position.found())
+        return std::make_pair(make_iterator(position), false);
+    return std::make_pair(make_iterator(m_chains.attach(position, std::unique_ptr<Node>(new Node(std::move(key))))), true);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::insert(InputIt first, InputIt last)
+{
+    m_chains.reserve_range(first, last);
+    for (; first != last; ++first)
+        insert(*first);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename... Args>
+std::pair<typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::emplace(Args&&... args)
+{
+    m_chains.step();
+    std::unique_ptr<Node> node(new Node(std::forward<Args>(args)...));
+    Position position = m_chains.locate(node->value);
+    if (position.found())
+        return std::make_pair(make_iterator(position), false);
+    return std::make_pair(make_iterator(m_chains.attach(position, std::move(node))), true);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::remove(const key_type& key)
+{
+    return remove_key(key);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, bool> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::remove(const K& key)
+{
+    return remove_key(key);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::find(const key_type& key) const
+{
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return cend();
+    return make_iterator(position);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::find(const K& key) const
+{
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return cend();
+    return make_iterator(position);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::contains(const key_type& key) const
+{
+    return m_chains.locate(key).found();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, bool> CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::contains(const K& key) const
+{
+    return m_chains.locate(key).found();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::begin() const {
+    return cbegin();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::cbegin() const {
+    return const_iterator(&m_chains, 0, 0, nullptr);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::end() const {
+    return cend();
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::cend() const {
+    return const_iterator(&m_chains, Chains::TableCount, 0, nullptr);
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::operator==(const HashSet& rhs) const
+{
+    if (size() != rhs.size())
+        return false;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        if (!rhs.contains(*it))
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::operator!=(const HashSet& rhs) const
+{
+    return !(operator==(rhs));
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::make_iterator(const Position& position) const
+{
+    return const_iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+bool CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>::remove_key(const K& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return false;
+    m_chains.detach(position);
+    return true;
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> CppADS::unite(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                                         const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs)
+{
+    const auto& larger = lhs.size() >= rhs.size() ? lhs : rhs;
+    const auto& smaller = lhs.size() >= rhs.size() ? rhs : lhs;
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> result(larger);
+    for (const auto& key : smaller)
+        result.insert(key);
+    return result;
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> CppADS::intersect(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                                             const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs)
+{
+    const auto& larger = lhs.size() >= rhs.size() ? lhs : rhs;
+    const auto& smaller = lhs.size() >= rhs.size() ? rhs : lhs;
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> result;
+    result.reserve(smaller.size());
+    for (const auto& key : smaller)
+    {
+        if (larger.contains(key))
+            result.insert(key);
+    }
+    return result;
+}
+
+template<typename Key, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> CppADS::difference(const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& lhs,
+                                                                              const HashSet<Key, Hash, KeyEqual, Reduction, StoreHash>& rhs)
+{
+    if (lhs.size() <= rhs.size())
+    {
+        HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> result;
+        result.reserve(lhs.size());
+        for (const auto& key : lhs)
+        {
+            if (!rhs.contains(key))
+                result.insert(key);
+        }
+        return result;
+    }
+
+    HashSet<Key, Hash, KeyEqual, Reduction, StoreHash> result(lhs);
+    for (const auto& key : rhs)
+        result.remove(key);
+    return result;
+}
+
+#endif
@@ -2,20 +2,41 @@
 #define HASH_TABLE_HPP
 
 #include "container.hpp"
-#include "array.hpp"
-#include "forward_list.hpp"
+#include "hash_chains.hpp"
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace CppADS
 {
     /// @brief Hash table class
-    /// @tparam K hashed key type
+    /// @details Separate chaining over a power-of-two number of buckets. Hash values are
+    /// passed through a mixing finalizer before reduction, so keys with identity hashes
+    /// (integers, enums) spread over all buckets.
+    ///
+    /// Rehashing may be incremental (see set_rehash_step): the old bucket array is kept
+    /// next to the new one and every insert, remove and non-const lookup moves a few old
+    /// buckets, so no single operation pays for the whole table. Nodes are relinked, not
+    /// reallocated, so references to values stay valid; iterators are invalidated by
+    /// insertion, removal and non-const lookup.
+    /// @tparam Key hashed key type
     /// @tparam T stored value type
-    template <typename Key, typename T>
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    /// @tparam Reduction mapping of mixed hash to bucket index (MaskReduction or FastRangeReduction)
+    /// @tparam StoreHash keep hash value in every node: rehashing doesn't call Hash and
+    /// lookups compare keys only if their hashes are equal
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Reduction = MaskReduction, bool StoreHash = false>
     class HashTable : public IContainer
     {
+        using Chains = HashChains<std::pair<Key, T>, PairKeyOf, Hash, KeyEqual, Reduction, StoreHash>;
+        using Node = typename Chains::Node;
+        using Position = typename Chains::Position;
+
     public:
         using key_type = Key;
         using mapped_type = T;
@@ -24,19 +45,25 @@ namespace CppADS
         using const_reference = const value_type&;
         using pointer = value_type*;
         using const_pointer = const value_type*;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        using iterator = HashChainsIterator<Chains, Node, value_type>;
+        using const_iterator = HashChainsIterator<const Chains, const Node, const value_type>;
 
-        class iterator;
-        class const_iterator;
+        /// @brief Result type R of members which take keys of other types
+        template<typename K, typename R>
+        using if_transparent = typename std::enable_if<TransparentLookup<Hash, KeyEqual, K>::value, R>::type;
 
-        HashTable() = default;                                        ///< Default contructor
+        HashTable();                                                    ///< Default contructor
         HashTable(const HashTable& copy);                               ///< Copy contructor
         HashTable(HashTable&& move);                                    ///< Move contructor
-        HashTable(std::initializer_list<value_type> init_list);   ///< Contructor from initializer list
+        HashTable(std::initializer_list<value_type> init_list);         ///< Contructor from initializer list
 
         HashTable& operator=(const HashTable& copy);                    ///< Copy assignment operator
         HashTable& operator=(HashTable&& move);                         ///< Move assignment operator
 
-        ~HashTable() = default;                                       ///< Destructor
+        ~HashTable() = default;                                         ///< Destructor
 
         /// @name Capacity
         /// @{
@@ -49,17 +76,43 @@ namespace CppADS
         /// @return number of buckets
         size_t bucket_count() const;
 
-        /// @brief Get current maximum number of elements per bucket
-        /// @return maximum number of elements per bucket
-        size_t max_load_factor() const;
+        /// @brief Get maximum average number of elements per bucket
+        /// @return maximum load factor
+        float max_load_factor() const;
+
+        /// @brief Get current average number of elements per bucket
+        /// @return load factor
+        float load_factor() const;
 
         /// @}
         /// @name Hash policy
         /// @{
 
-        /// @brief Get current maximum number of elements per bucket
-        /// @param load_factor new maximum number of elements per bucket
-        void set_load_factor(size_t load_factor);
+        /// @brief Set maximum average number of elements per bucket
+        /// @param load_factor new maximum load factor, positive
+        void set_load_factor(float load_factor);
+
+        /// @brief Reserve buckets for specific count of elements
+        /// @param count count of elements which fit without rehashing
+        void reserve(size_t count);
+
+        /// @brief Rebuild the table with specific number of buckets
+        /// @details Count is rounded up to a power of two and to the number of buckets
+        /// required by current size and maximum load factor.
+        /// @param bucket_count requested number of buckets
+        void rehash(size_t bucket_count);
+
+        /// @brief Set count of old buckets moved by each operation while rehashing
+        /// @param buckets buckets moved per insert, remove or non-const lookup, 0 rehashes at once
+        void set_rehash_step(size_t buckets);
+
+        /// @brief Get count of old buckets moved by each operation while rehashing
+        /// @return buckets moved per operation, 0 if rehashing is done at once
+        size_t rehash_step() const;
+
+        /// @brief Check if incremental rehashing is in progress
+        /// @return true if old buckets aren't moved yet
+        bool rehashing() const;
 
         /// @}
         /// @name Modifiers
@@ -68,30 +121,93 @@ namespace CppADS
         /// @brief Remove all data from container
         void clear() override;
 
-        /// @brief Insert value to container
+        /// @brief Insert value to container, existing value of the key is replaced
         /// @param pair key-value pair to insert
-        void insert(const value_type& pair);
-        /// @brief Insert value to container
+        /// @return iterator to the item and true if the key was inserted
+        std::pair<iterator, bool> insert(const value_type& pair);
+        /// @brief Insert value to container, existing value of the key is replaced
         /// @param pair key-value pair to insert
-        void insert(value_type&& pair);
+        /// @return iterator to the item and true if the key was inserted
+        std::pair<iterator, bool> insert(value_type&& pair);
+        /// @brief Insert range of values to container
+        /// @details Table is sized once for the whole range if its length is known.
+        /// @param first iterator to the first key-value pair
+        /// @param last iterator after the last key-value pair
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last);
+
+        /// @brief Construct item from arguments if its key is missing
+        /// @param args arguments of key-value pair constructor
+        /// @return iterator to the item with the key and true if the item was inserted
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args);
+
+        /// @brief Construct value from arguments if the key is missing
+        /// @details Arguments aren't used (moved from) if the key exists.
+        /// @param key item key
+        /// @param args arguments of value constructor
+        /// @return iterator to the item with the key and true if the item was inserted
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args);
+        /// @brief Construct value from arguments if the key is missing
+        /// @details Arguments aren't used (moved from) if the key exists.
+        /// @param key item key
+        /// @param args arguments of value constructor
+        /// @return iterator to the item with the key and true if the item was inserted
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args);
+
+        /// @brief Insert value or assign it to the existing item
+        /// @param key item key
+        /// @param value value to insert or assign
+        /// @return iterator to the item with the key and true if the item was inserted
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value);
+        /// @brief Insert value or assign it to the existing item
+        /// @param key item key
+        /// @param value value to insert or assign
+        /// @return iterator to the item with the key and true if the item was inserted
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& value);
 
         /// @brief Remove values from container
         /// @param key position of item to delete
         void remove(const key_type& key);
+        /// @brief Remove values from container, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        template<typename K>
+        if_transparent<K, void> remove(const K& key);
 
         /// @}
         /// @name Accesors
         /// @{
 
-        /// @brief Access to item
+        /// @brief Access to item, missing item is default constructed
         /// @param key item position
         /// @return reference to value
         mapped_type& operator[](const key_type& key);
+        /// @brief Access to item, missing item is default constructed
+        /// @param key item position
+        /// @return reference to value
+        mapped_type& operator[](key_type&& key);
+        /// @brief Access to item, transparent Hash and KeyEqual only
+        /// @details Key type is constructed from the key only if the item is missing.
+        /// @param key key comparable with key type
+        /// @return reference to value
+        template<typename K>
+        if_transparent<K, mapped_type&> operator[](const K& key);
 
-        /// @brief Access to item
+        /// @brief Access to existing item
         /// @param key item position
         /// @return reference to value
+        /// @throw std::out_of_range if there is no item with the key
         const mapped_type& operator[](const key_type& key) const;
+        /// @brief Access to existing item, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return reference to value
+        /// @throw std::out_of_range if there is no item with the key
+        template<typename K>
+        if_transparent<K, const mapped_type&> operator[](const K& key) const;
 
         /// @brief Search for first item equal value
         /// @param key value search for
@@ -103,6 +219,27 @@ namespace CppADS
         /// @return iterator to found item (end if item not found)
         const_iterator find(const key_type& key) const;
 
+        /// @brief Search for item, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return iterator to found item (end if item not found)
+        template<typename K>
+        if_transparent<K, iterator> find(const K& key);
+        /// @brief Search for item, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return iterator to found item (end if item not found)
+        template<typename K>
+        if_transparent<K, const_iterator> find(const K& key) const;
+
+        /// @brief Check if container has item with key
+        /// @param key key to search for
+        /// @return true if item is found
+        bool contains(const key_type& key) const;
+        /// @brief Check if container has item with key, transparent Hash and KeyEqual only
+        /// @param key key comparable with key type
+        /// @return true if item is found
+        template<typename K>
+        if_transparent<K, bool> contains(const K& key) const;
+
         /// @}
         /// @name Iterators
         /// @{
@@ -123,458 +260,407 @@ namespace CppADS
 
         /// @}
 
-        bool operator==(const HashTable<Key, T>& rhs) const;
-        bool operator!=(const HashTable<Key, T>& rhs) const;
+        bool operator==(const HashTable& rhs) const;
+        bool operator!=(const HashTable& rhs) const;
 
     private:
-        using Bucket = CppADS::ForwardList<value_type>;
-        CppADS::Array<Bucket> m_buckets {Bucket{}};
+        Chains m_chains;
 
-        size_t m_size { 0 };
-        size_t m_max_load_factor { 1 };
+        iterator make_iterator(const Position& position);
+        const_iterator make_iterator(const Position& position) const;
 
-        inline size_t calc_address(Key key) const;
-        void rehash();
-    };
+        /// @brief Insert item with value constructed from arguments if the key is missing
+        template<typename K, typename... Args>
+        std::pair<iterator, bool> emplace_key(K&& key, Args&&... args);
 
-    template<typename Key, typename T>
-    /// @brief Read-write iterator for List container
-    class HashTable<Key, T>::iterator : public std::iterator<std::forward_iterator_tag, value_type>
-    {
-    private:
-        HashTable<Key, T>* m_container;
-        typename Array<Bucket>::iterator m_bucket_it;
-        typename Bucket::iterator        m_cell_it;
+        /// @brief Insert item or assign value to the existing one
+        template<typename K, typename M>
+        std::pair<iterator, bool> assign_key(K&& key, M&& value);
 
-        inline bool is_end_of_bucket()
-        {
-            return (m_cell_it == m_bucket_it->end() && m_bucket_it != (m_container->m_buckets.end()--));
-        }
+        /// @brief Get value of existing item
+        template<typename K>
+        const mapped_type& at_key(const K& key) const;
 
-    public:
-        iterator(typename Array<Bucket>::iterator bucket_it,
-                 typename Bucket::iterator cell_it,
-                 HashTable<Key,T>* container)
-            : m_container(container), m_bucket_it(bucket_it), m_cell_it(cell_it)
-        {
-            if (is_end_of_bucket())
-                this->operator++();
-        }
-        ~iterator() {
-            m_bucket_it = nullptr;
-            m_cell_it = nullptr;
-        }
-
-        HashTable<Key,T>::reference operator*() {
-            return m_cell_it.operator*();
-        }
-        HashTable<Key,T>::pointer operator->() {
-            return m_cell_it.operator->();
-        }
-
-        iterator& operator++() {
-            do
-            {
-                if (is_end_of_bucket())
-                {
-                    m_bucket_it++;
-                    m_cell_it = m_bucket_it->begin();
-                }
-                else
-                    m_cell_it++;
-            }
-            while (is_end_of_bucket());
-            return *this;
-        }
-        iterator& operator++(int) {
-            do
-            {
-                if (is_end_of_bucket())
-                {
-                    m_bucket_it++;
-                    m_cell_it = m_bucket_it->begin();
-                }
-                else
-                    m_cell_it++;
-            }
-            while (is_end_of_bucket());
-            return *this;
-        }
-
-        bool operator==(const iterator& rhs) const {
-            return (m_bucket_it == rhs.m_bucket_it && m_cell_it == rhs.m_cell_it);
-        }
-        bool operator!=(const iterator& rhs) const {
-            return !(this->operator==(rhs));
-        }
-    };
-
-    template<typename Key, typename T>
-    /// @brief Read-only iterator for List container
-    class HashTable<Key, T>::const_iterator : public std::iterator<std::forward_iterator_tag, value_type>
-    {
-    private:
-        const HashTable<Key, T>* m_container;
-        typename Array<Bucket>::const_iterator m_bucket_it;
-        typename Bucket::const_iterator        m_cell_it;
-
-        inline bool is_end_of_bucket()
-        {
-            return (m_cell_it == m_bucket_it->end() && m_bucket_it != (m_container->m_buckets.end()--));
-        }
-
-    public:
-        const_iterator(typename Array<Bucket>::const_iterator bucket_it,
-                       typename Bucket::const_iterator cell_it,
-                       const HashTable<Key, T>* container)
-            : m_container(container), m_bucket_it(bucket_it), m_cell_it(cell_it)
-        {
-            if (is_end_of_bucket())
-                this->operator++();
-        }
-        ~const_iterator() {
-            m_bucket_it = nullptr;
-            m_cell_it = nullptr;
-        }
-
-        HashTable<Key,T>::const_reference operator*() {
-            return m_cell_it.operator*();
-        }
-        HashTable<Key,T>::const_pointer operator->() {
-            return m_cell_it.operator->();
-        }
-
-        const_iterator& operator++() {
-            do
-            {
-                if (is_end_of_bucket())
-                {
-                    m_bucket_it++;
-                    m_cell_it = m_bucket_it->begin();
-                }
-                else
-                    m_cell_it++;
-            }
-            while (is_end_of_bucket());
-            return *this;
-        }
-        const_iterator& operator++(int) {
-            do
-            {
-                if (is_end_of_bucket())
-                {
-                    m_bucket_it++;
-                    m_cell_it = m_bucket_it.begin();
-                }
-                else
-                    m_cell_it++;
-            }
-            while (is_end_of_bucket());
-            return *this;
-        }
-
-        bool operator==(const const_iterator& rhs) const {
-            return (m_bucket_it == rhs.m_bucket_it && m_cell_it == rhs.m_cell_it);
-        }
-        bool operator!=(const const_iterator& rhs) const {
-            return !(this->operator==(rhs));
-        }
+        /// @brief Remove item if it exists
+        template<typename K>
+        void remove_key(const K& key);
     };
 }
 
-template<typename Key, typename T>
-CppADS::HashTable<Key, T>::HashTable(const HashTable& copy)
-    : m_buckets(copy.m_buckets), m_size(copy.m_size), m_max_load_factor(copy.m_max_load_factor)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::HashTable()
 {}
 
-template<typename Key, typename T>
-CppADS::HashTable<Key, T>::HashTable(HashTable&& move)
-    : m_buckets(std::move(move.m_buckets)), m_size(std::move(move.m_size)), m_max_load_factor(move.m_max_load_factor)
-{
-    move.m_size = 0;
-}
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::HashTable(const HashTable& copy)
+    : m_chains(copy.m_chains)
+{}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::HashTable(HashTable&& move)
+    : m_chains(std::move(move.m_chains))
+{}
 
-template<typename Key, typename T>
-CppADS::HashTable<Key, T>::HashTable(std::initializer_list<value_type> init_list)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::HashTable(std::initializer_list<value_type> init_list)
+    : HashTable()
 {
     for(auto it = init_list.begin(); it != init_list.end(); it++)
         insert(*it);
 }
 
-template<typename Key, typename T>
-CppADS::HashTable<Key, T>& CppADS::HashTable<Key, T>::operator=(const HashTable& copy)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator=(const HashTable& copy)
 {
-    clear();
-    m_buckets = copy.m_buckets;
-    m_size = copy.m_size;
-    m_max_load_factor = copy.m_max_load_factor;
+    if (this != &copy)
+        *this = HashTable(copy);
     return *this;
 }
 
-template<typename Key, typename T>
-CppADS::HashTable<Key, T>& CppADS::HashTable<Key, T>::operator=(HashTable&& move)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator=(HashTable&& move)
 {
-    m_buckets = std::move(move.m_buckets);
-    m_size = std::move(move.m_size);
-    m_max_load_factor = std::move(move.m_max_load_factor);
-    move.m_size = 0;
+    m_chains = std::move(move.m_chains);
     return *this;
 }
 
-template<typename Key, typename T>
-size_t CppADS::HashTable<Key, T>::size() const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::size() const
 {
-    return m_size;
+    return m_chains.size();
 }
 
-template<typename Key, typename T>
-size_t CppADS::HashTable<Key, T>::bucket_count() const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::bucket_count() const
 {
-    return m_buckets.size();
+    return m_chains.bucket_count();
 }
 
-template<typename Key, typename T>
-size_t CppADS::HashTable<Key, T>::max_load_factor() const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::max_load_factor() const
 {
-    return m_max_load_factor;
+    return m_chains.max_load_factor();
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::set_load_factor(size_t load_factor)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+float CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::load_factor() const
 {
-    m_max_load_factor = load_factor;
+    return m_chains.load_factor();
+}
 
-    if (bucket_count() != 0 && ((size() / bucket_count()) > max_load_factor()))
-        rehash();
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::set_load_factor(float load_factor)
+{
+    if (!(load_factor > 0.0f))
+        throw std::invalid_argument("CppADS::HashTable::set_load_factor: load factor must be positive");
+    m_chains.set_max_load_factor(load_factor);
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::clear()
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::reserve(size_t count)
 {
-    m_buckets = {Bucket{}};
-    m_size = 0;
+    m_chains.reserve(count);
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::rehash()
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::rehash(size_t bucket_count)
 {
-    size_t old_size = m_buckets.size();
-    CppADS::Array<Bucket> old(std::move(m_buckets));    
-    m_buckets.reserve(old_size * 2 + 1);
-    while(m_buckets.size() < m_buckets.capacity())
-        m_buckets.push_back(Bucket{});
+    m_chains.rehash(bucket_count);
+}
 
-    for(typename CppADS::Array<Bucket>::iterator bucket = old.begin(); bucket != old.end(); bucket++)
-    {
-        for(typename Bucket::iterator cell = (*bucket).begin(); cell != (*bucket).end(); cell++)
-        {
-            m_buckets[calc_address(cell->first)].push_back(std::move(*cell));
-        }
-    }
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::set_rehash_step(size_t buckets)
+{
+    m_chains.set_rehash_step(buckets);
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::insert(const HashTable::value_type& pair)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+size_t CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::rehash_step() const
 {
-    if ((m_buckets.size() == 0) || ((size() + 1) / m_buckets.size() > max_load_factor()))
-        rehash();
+    return m_chains.rehash_step();
+}
 
-    size_t address = calc_address(pair.first);
-    auto item = m_buckets[address].begin();
-    while(item != m_buckets[address].end())
-    {
-        if (item->first == pair.first)
-            break;
-        item++;
-    }
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::rehashing() const
+{
+    return m_chains.rehashing();
+}
 
-    if(item == m_buckets[address].end())
-    {
-        m_buckets[address].push_back(pair);
-        m_size++;
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::clear()
+{
+    m_chains.clear();
+}
 
-        if (m_buckets[address].size() > max_load_factor())
-            rehash();
-    }
-    else
-        item->second = pair.second;
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(const HashTable::value_type& pair)
+{
+    return assign_key(pair.first, pair.second);
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::insert(HashTable::value_type&& pair)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(HashTable::value_type&& pair)
 {
-    if ((m_buckets.size() == 0) || ((size() + 1) / m_buckets.size() > max_load_factor()))
-        rehash();
+    return assign_key(std::move(pair.first), std::move(pair.second));
+}
 
-    size_t address = calc_address(pair.first);
-    auto item = m_buckets[address].begin();
-    while(item != m_buckets[address].end())
-    {
-        if (item->first == pair.first)
-            break;
-        item++;
-    }
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename InputIt>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert(InputIt first, InputIt last)
+{
+    m_chains.reserve_range(first, last);
+    for (; first != last; ++first)
+        insert(*first);
+}
 
-    if(item == m_buckets[address].end())
-    {
-        m_buckets[address].push_back(std::move(pair));
-        m_size++;
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename... Args>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::emplace(Args&&... args)
+{
+    m_chains.step();
+    std::unique_ptr<Node> node(new Node(std::forward<Args>(args)...));
+    Position position = m_chains.locate(node->value.first);
+    if (position.found())
+        return std::make_pair(make_iterator(position), false);
+    return std::make_pair(make_iterator(m_chains.attach(position, std::move(node))), true);
+}
 
-        if (m_buckets[address].size() > max_load_factor())
-            rehash();
-    }
-    else
-        item->second = std::move(pair.second);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename... Args>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::try_emplace(const key_type& key, Args&&... args)
+{
+    return emplace_key(key, std::forward<Args>(args)...);
 }
 
-template<typename Key, typename T>
-void CppADS::HashTable<Key, T>::remove(const HashTable::key_type& key)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename... Args>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::try_emplace(key_type&& key, Args&&... args)
 {
-    size_t address = calc_address(key);
+    return emplace_key(std::move(key), std::forward<Args>(args)...);
+}
 
-    auto item = m_buckets[address].begin();
-    auto remove_after = m_buckets[address].before_begin();
-    while(item != m_buckets[address].end())
-    {
-        if (item->first == key)
-            break;
-        item++;
-        remove_after++;
-    }
-    if (item != m_buckets[address].end())
-        m_buckets[address].remove_after(remove_after);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename M>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert_or_assign(const key_type& key, M&& value)
+{
+    return assign_key(key, std::forward<M>(value));
+}
 
-    m_size--;
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename M>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::insert_or_assign(key_type&& key, M&& value)
+{
+    return assign_key(std::move(key), std::forward<M>(value));
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::mapped_type& CppADS::HashTable<Key, T>::operator[](const HashTable::key_type& key)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::remove(const HashTable::key_type& key)
 {
-    size_t address = calc_address(key);
+    remove_key(key);
+}
 
-    auto bucket_it = m_buckets[address].begin();
-    while (bucket_it != m_buckets[address].end())
-    {
-        if(bucket_it->first == key)
-            break;
-        bucket_it++;
-    }
-    if (bucket_it != m_buckets[address].end())
-    {
-        return (*bucket_it).second;
-    }
-    else
-    {
-        insert({key, T()});
-        return (*find(key)).second;
-    }
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, void> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::remove(const K& key)
+{
+    remove_key(key);
 }
 
-template<typename Key, typename T>
-const typename CppADS::HashTable<Key, T>::mapped_type& CppADS::HashTable<Key, T>::operator[](const HashTable::key_type& key) const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator[](const HashTable::key_type& key)
 {
-    size_t address = calc_address(key);
+    return emplace_key(key).first->second;
+}
 
-    auto bucket_it = m_buckets[address].begin();
-    while (bucket_it != m_buckets[address].end())
-    {
-        if(bucket_it->first == key)
-            break;
-        bucket_it++;
-    }
-    if (bucket_it != m_buckets[address].end())
-    {
-        return *(bucket_it);
-    }
-    else
-    {
-        insert({key, T()});
-        return (*find(key)).second;
-    }
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator[](HashTable::key_type&& key)
+{
+    return emplace_key(std::move(key)).first->second;
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::iterator CppADS::HashTable<Key, T>::find(const HashTable::key_type& key)
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type&> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator[](const K& key)
 {
-    size_t address = calc_address(key);
+    return emplace_key(key).first->second;
+}
 
-    auto bucket_it = m_buckets[address].begin();
-    while (bucket_it != m_buckets[address].end())
-    {
-        if(bucket_it->first == key)
-            break;
-        bucket_it++;
-    }
-    if (bucket_it != m_buckets[address].end())
-        return iterator((m_buckets.begin() + address), bucket_it, this);
-    else
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+const typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator[](const HashTable::key_type& key) const
+{
+    return at_key(key);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, const typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type&> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator[](const K& key) const
+{
+    return at_key(key);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const HashTable::key_type& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (!position.found())
         return end();
+    return make_iterator(position);
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::const_iterator CppADS::HashTable<Key, T>::find(const HashTable::key_type& key) const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const HashTable::key_type& key) const
 {
-    size_t address = calc_address(key);
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return cend();
+    return make_iterator(position);
+}
 
-    auto bucket_it = m_buckets[address].begin();
-    while (bucket_it != m_buckets[address].end())
-    {
-        if(bucket_it->first == key)
-            break;
-        bucket_it++;
-    }
-    if (bucket_it != m_buckets[address].end())
-        return const_iterator((m_buckets.begin() + address), bucket_it, this);
-    else
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const K& key)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        return end();
+    return make_iterator(position);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::find(const K& key) const
+{
+    Position position = m_chains.locate(key);
+    if (!position.found())
         return cend();
+    return make_iterator(position);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::contains(const HashTable::key_type& key) const
+{
+    return m_chains.locate(key).found();
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::iterator CppADS::HashTable<Key, T>::begin() {
-    return iterator(m_buckets.begin(), m_buckets.begin()->begin(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::template if_transparent<K, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::contains(const K& key) const
+{
+    return m_chains.locate(key).found();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::begin() {
+    return iterator(&m_chains, 0, 0, nullptr);
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::const_iterator CppADS::HashTable<Key, T>::begin() const {
-    return const_iterator(m_buckets.cbegin(), m_buckets.cbegin()->cbegin(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::begin() const {
+    return cbegin();
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::const_iterator CppADS::HashTable<Key, T>::cbegin() const {
-    return const_iterator(m_buckets.cbegin(), m_buckets.cbegin()->cbegin(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::cbegin() const {
+    return const_iterator(&m_chains, 0, 0, nullptr);
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::iterator CppADS::HashTable<Key, T>::end() {
-    return iterator(m_buckets.end()--, (m_buckets.end()--)->end(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::end() {
+    return iterator(&m_chains, Chains::TableCount, 0, nullptr);
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::const_iterator CppADS::HashTable<Key, T>::end() const {
-    return const_iterator(m_buckets.cend()--, (m_buckets.cend()--)->cend(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::end() const {
+    return cend();
 }
 
-template<typename Key, typename T>
-typename CppADS::HashTable<Key, T>::const_iterator CppADS::HashTable<Key, T>::cend() const {
-    return const_iterator(m_buckets.cend()--, (m_buckets.cend()--)->cend(), this);
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::cend() const {
+    return const_iterator(&m_chains, Chains::TableCount, 0, nullptr);
 }
 
-template<typename Key, typename T>
-bool CppADS::HashTable<Key, T>::operator==(const HashTable<Key, T> &rhs) const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator==(const HashTable& rhs) const
 {
-    return m_buckets == rhs.m_buckets;
+    if (size() != rhs.size())
+        return false;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        auto found = rhs.find(it->first);
+        if (found == rhs.cend() || !(found->second == it->second))
+            return false;
+    }
+    return true;
 }
 
-template<typename Key, typename T>
-bool CppADS::HashTable<Key, T>::operator!=(const HashTable<Key, T> &rhs) const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+bool CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::operator!=(const HashTable& rhs) const
 {
     return !(operator==(rhs));
 }
 
-template<typename Key, typename T>
-size_t CppADS::HashTable<Key, T>::calc_address(Key key) const
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::make_iterator(const Position& position)
+{
+    return iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::const_iterator CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::make_iterator(const Position& position) const
+{
+    return const_iterator(&m_chains, position.table, position.bucket, position.link->get());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K, typename... Args>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::emplace_key(K&& key, Args&&... args)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (position.found())
+        return std::make_pair(make_iterator(position), false);
+
+    std::unique_ptr<Node> node(new Node(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...)));
+    return std::make_pair(make_iterator(m_chains.attach(position, std::move(node))), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K, typename M>
+std::pair<typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::iterator, bool> CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::assign_key(K&& key, M&& value)
+{
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (position.found())
+    {
+        (*position.link)->value.second = std::forward<M>(value);
+        return std::make_pair(make_iterator(position), false);
+    }
+
+    std::unique_ptr<Node> node(new Node(std::forward<K>(key), std::forward<M>(value)));
+    return std::make_pair(make_iterator(m_chains.attach(position, std::move(node))), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+const typename CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::mapped_type& CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::at_key(const K& key) const
+{
+    Position position = m_chains.locate(key);
+    if (!position.found())
+        throw std::out_of_range("CppADS::HashTable::operator[]: key not found");
+    return (*position.link)->value.second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Reduction, bool StoreHash>
+template<typename K>
+void CppADS::HashTable<Key, T, Hash, KeyEqual, Reduction, StoreHash>::remove_key(const K& key)
 {
-    return std::hash<Key>{}(key) % bucket_count();
+    m_chains.step();
+    Position position = m_chains.locate(key);
+    if (position.found())
+        m_chains.detach(position);
 }
 
 #endif
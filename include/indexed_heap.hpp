@@ -0,0 +1,435 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include "array.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace CppADS
+{
+    /// @brief Addressable d-ary min-heap with stable handles, unlike max-heap PriorityQueue
+    /// @details Items are stored in heap order in Array together with their slots, and
+    /// one more Array maps every slot to the current position of its item. So the key
+    /// of an item can be changed and the item can be removed in O(log n).
+    ///
+    /// With the same std::less the top is the least item, while PriorityQueue gives the
+    /// greatest one: decrease_key() moves an item towards the top as usual for shortest
+    /// paths and timers. A handle stays valid until its item is popped or erased. Slots of
+    /// removed items are reused by next pushes, but every slot counts its releases, so
+    /// stale handles are rejected with std::out_of_range like in PairingHeap.
+    /// @tparam T value type stored in the container
+    /// @tparam Compare strict weak ordering, the top is an item which isn't greater than others
+    /// @tparam Arity count of children of a heap node
+    template<class T, class Compare = std::less<T>, size_t Arity = 2>
+    class IndexedHeap : public IContainer
+    {
+        static_assert(Arity >= 2, "CppADS::IndexedHeap: arity must be at least 2");
+
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using value_compare = Compare;
+
+        /// @brief Stable reference to item in the heap
+        class handle_type
+        {
+        public:
+            handle_type() = default;
+
+            bool operator==(const handle_type& rhs) const { return m_slot == rhs.m_slot && m_generation == rhs.m_generation; }
+            bool operator!=(const handle_type& rhs) const { return !(*this == rhs); }
+
+        private:
+            size_t m_slot { static_cast<size_t>(-1) };
+            size_t m_generation { 0 };      ///< Generation of the slot when the handle was made
+            friend class IndexedHeap;
+
+            handle_type(size_t slot, size_t generation) : m_slot(slot), m_generation(generation) {}
+        };
+
+        IndexedHeap() = default;                                        ///< Default constructor
+        explicit IndexedHeap(const Compare& compare);                   ///< Constructor with comparator
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @return true if heap has no elements
+        bool empty() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container, all handles become invalid
+        /// @details Slots are kept for next pushes, O(count of slots)
+        void clear() override;
+
+        /// @brief Reserve space for specific count of items
+        /// @param count reserved space
+        void reserve(size_t count);
+
+        /// @brief Add value, O(log n)
+        /// @param value added value
+        /// @return handle of the item
+        handle_type push(const T& value);
+
+        /// @brief Add value, O(log n)
+        /// @param value added value
+        /// @return handle of the item
+        handle_type push(T&& value);
+
+        /// @brief Construct value in the heap, O(log n)
+        /// @param args arguments of value's constructor
+        /// @return handle of the item
+        template<typename... Args>
+        handle_type emplace(Args&&... args);
+
+        /// @brief Remove top item, O(log n)
+        void pop();
+
+        /// @brief Remove item, O(log n)
+        /// @param handle handle of the item
+        void erase(handle_type handle);
+
+        /// @brief Set smaller key of item and move it towards the top, O(log n)
+        /// @param handle handle of the item
+        /// @param value new value which isn't greater than the current one
+        void decrease_key(handle_type handle, T value);
+
+        /// @brief Set greater key of item and move it away from the top, O(log n)
+        /// @param handle handle of the item
+        /// @param value new value which isn't less than the current one
+        void increase_key(handle_type handle, T value);
+
+        /// @brief Set key of item in any direction, O(log n)
+        /// @param handle handle of the item
+        /// @param value new value
+        void update(handle_type handle, T value);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Get top item
+        /// @return const reference to the least item
+        const_reference top() const;
+
+        /// @brief Get handle of top item
+        handle_type top_handle() const;
+
+        /// @brief Get value of item
+        /// @param handle handle of the item
+        /// @return const reference to the value
+        const_reference get(handle_type handle) const;
+
+        /// @brief Check whether handle refers to an item in the heap
+        bool contains(handle_type handle) const;
+
+        /// @}
+
+    private:
+        static constexpr size_t Free = static_cast<size_t>(-1);         ///< Position of unused slot
+
+        /// @private
+        struct Entry
+        {
+            T value {};
+            size_t slot { 0 };
+        };
+
+        Array<Entry> m_heap;                ///< Items in heap order
+        Array<size_t> m_positions;          ///< Positions of items by slots
+        Array<size_t> m_generations;        ///< Count of releases of every slot, handles of older items don't match
+        Array<size_t> m_free;               ///< Slots of removed items
+        Compare m_compare {};
+
+        /// @private
+        Entry* entries();
+
+        /// @private
+        /// @brief Get position of item, throws if handle is invalid
+        size_t position(handle_type handle, const char* function) const;
+
+        /// @private
+        /// @brief Take unused slot
+        size_t acquire_slot();
+
+        /// @private
+        /// @brief Make handle of item in slot
+        handle_type make_handle(size_t slot) const;
+
+        /// @private
+        /// @brief Append item and move it up to its place
+        handle_type insert(T&& value);
+
+        /// @private
+        /// @brief Put entry to the hole at index and move it up to its place
+        void sift_up(size_t index, Entry entry);
+
+        /// @private
+        /// @brief Put entry to the hole at index and move it down to its place
+        void sift_down(size_t index, Entry entry);
+
+        /// @private
+        /// @brief Remove item at position and free its slot
+        void remove_at(size_t index);
+    };
+}
+
+template<class T, class Compare, size_t Arity>
+constexpr size_t CppADS::IndexedHeap<T, Compare, Arity>::Free;
+
+template<class T, class Compare, size_t Arity>
+CppADS::IndexedHeap<T, Compare, Arity>::IndexedHeap(const Compare& compare) : m_compare(compare) {}
+
+template<class T, class Compare, size_t Arity>
+size_t CppADS::IndexedHeap<T, Compare, Arity>::size() const
+{
+    return m_heap.size();
+}
+
+template<class T, class Compare, size_t Arity>
+bool CppADS::IndexedHeap<T, Compare, Arity>::empty() const
+{
+    return m_heap.size() == 0;
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::clear()
+{
+    m_heap.clear();
+    m_free.clear();
+    // Slots stay with bumped generations, so handles made before clear don't match new items
+    for (size_t slot = 0; slot < m_positions.size(); slot++)
+    {
+        if (m_positions[slot] != Free)
+        {
+            m_positions[slot] = Free;
+            m_generations[slot]++;
+        }
+        m_free.push_back(slot);
+    }
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::reserve(size_t count)
+{
+    m_heap.reserve(count);
+    m_positions.reserve(count);
+    m_generations.reserve(count);
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::push(const T& value)
+{
+    return insert(T(value));
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::push(T&& value)
+{
+    return insert(std::move(value));
+}
+
+template<class T, class Compare, size_t Arity>
+template<typename... Args>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::emplace(Args&&... args)
+{
+    return insert(T(std::forward<Args>(args)...));
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::pop()
+{
+    if (empty())
+        throw std::out_of_range("CppADS::IndexedHeap<T>::pop: container is empty");
+    remove_at(0);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::erase(handle_type handle)
+{
+    remove_at(position(handle, "erase"));
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::decrease_key(handle_type handle, T value)
+{
+    size_t index = position(handle, "decrease_key");
+    Entry* items = entries();
+    if (m_compare(items[index].value, value))
+        throw std::invalid_argument("CppADS::IndexedHeap<T>::decrease_key: value is greater than the current one");
+    sift_up(index, Entry { std::move(value), handle.m_slot });
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::increase_key(handle_type handle, T value)
+{
+    size_t index = position(handle, "increase_key");
+    Entry* items = entries();
+    if (m_compare(value, items[index].value))
+        throw std::invalid_argument("CppADS::IndexedHeap<T>::increase_key: value is less than the current one");
+    sift_down(index, Entry { std::move(value), handle.m_slot });
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::update(handle_type handle, T value)
+{
+    size_t index = position(handle, "update");
+    Entry* items = entries();
+    if (m_compare(value, items[index].value))
+        sift_up(index, Entry { std::move(value), handle.m_slot });
+    else
+        sift_down(index, Entry { std::move(value), handle.m_slot });
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::const_reference CppADS::IndexedHeap<T, Compare, Arity>::top() const
+{
+    if (empty())
+        throw std::out_of_range("CppADS::IndexedHeap<T>::top: container is empty");
+    return m_heap.front().value;
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::top_handle() const
+{
+    if (empty())
+        throw std::out_of_range("CppADS::IndexedHeap<T>::top_handle: container is empty");
+    return make_handle(m_heap.front().slot);
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::const_reference CppADS::IndexedHeap<T, Compare, Arity>::get(handle_type handle) const
+{
+    return m_heap[position(handle, "get")].value;
+}
+
+template<class T, class Compare, size_t Arity>
+bool CppADS::IndexedHeap<T, Compare, Arity>::contains(handle_type handle) const
+{
+    return handle.m_slot < m_positions.size() && m_positions[handle.m_slot] != Free
+        && m_generations[handle.m_slot] == handle.m_generation;
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::Entry* CppADS::IndexedHeap<T, Compare, Arity>::entries()
+{
+    return &*m_heap.begin();
+}
+
+template<class T, class Compare, size_t Arity>
+size_t CppADS::IndexedHeap<T, Compare, Arity>::position(handle_type handle, const char* function) const
+{
+    if (!contains(handle))
+        throw std::out_of_range(std::string("CppADS::IndexedHeap<T>::") + function + ": handle is invalid");
+    return m_positions[handle.m_slot];
+}
+
+template<class T, class Compare, size_t Arity>
+size_t CppADS::IndexedHeap<T, Compare, Arity>::acquire_slot()
+{
+    if (m_free.size() != 0)
+    {
+        size_t slot = m_free.back();
+        m_free.pop_back();
+        return slot;
+    }
+    m_positions.push_back(Free);
+    m_generations.push_back(0);
+    return m_positions.size() - 1;
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::make_handle(size_t slot) const
+{
+    return handle_type(slot, m_generations[slot]);
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::IndexedHeap<T, Compare, Arity>::handle_type CppADS::IndexedHeap<T, Compare, Arity>::insert(T&& value)
+{
+    size_t slot = acquire_slot();
+    m_heap.push_back(Entry());
+    sift_up(m_heap.size() - 1, Entry { std::move(value), slot });
+    return make_handle(slot);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::sift_up(size_t index, Entry entry)
+{
+    Entry* items = entries();
+    size_t* positions = &*m_positions.begin();
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / Arity;
+        if (!m_compare(entry.value, items[parent].value))
+            break;
+        items[index] = std::move(items[parent]);
+        positions[items[index].slot] = index;
+        index = parent;
+    }
+    positions[entry.slot] = index;
+    items[index] = std::move(entry);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::sift_down(size_t index, Entry entry)
+{
+    Entry* items = entries();
+    size_t* positions = &*m_positions.begin();
+    size_t count = size();
+    while (true)
+    {
+        size_t first_child = Arity * index + 1;
+        if (first_child >= count)
+            break;
+
+        size_t last_child = std::min(first_child + Arity, count);
+        size_t best = first_child;
+        for (size_t child = first_child + 1; child < last_child; child++)
+        {
+            if (m_compare(items[child].value, items[best].value))
+                best = child;
+        }
+
+        if (!m_compare(items[best].value, entry.value))
+            break;
+        items[index] = std::move(items[best]);
+        positions[items[index].slot] = index;
+        index = best;
+    }
+    positions[entry.slot] = index;
+    items[index] = std::move(entry);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::IndexedHeap<T, Compare, Arity>::remove_at(size_t index)
+{
+    Entry* items = entries();
+    size_t slot = items[index].slot;
+    Entry last = std::move(m_heap.back());
+    m_heap.pop_back();
+
+    m_positions[slot] = Free;
+    m_generations[slot]++;
+    m_free.push_back(slot);
+    if (index == m_heap.size())
+        return;
+
+    // Last item may belong to either direction from the hole
+    if (index > 0 && m_compare(last.value, items[(index - 1) / Arity].value))
+        sift_up(index, std::move(last));
+    else
+        sift_down(index, std::move(last));
+}
+
+#endif //INDEXED_HEAP_HPP
@@ -0,0 +1,527 @@
+#ifndef LRU_CACHE_HPP
+#define LRU_CACHE_HPP
+
+#include "container.hpp"
+#include "array.hpp"
+#include "hash_mix.hpp"
+
+#include <functional>
+#include <stdexcept>
+
+namespace CppADS
+{
+    /// @brief Least-recently-used cache with bounded entry count and optional weight limit
+    /// @details All nodes live in a slab allocated at construction. Recency order and the key
+    /// index are both intrusive (linked by slab indices), so get/put/erase never allocate.
+    /// @tparam Key key type
+    /// @tparam T cached value type
+    template<typename Key, typename T>
+    class LruCache : public IContainer
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using weigher_type = std::function<size_t(const Key&, const T&)>;
+
+        /// @brief Construct cache limited by entries count
+        /// @param capacity maximum number of cached entries
+        explicit LruCache(size_t capacity);
+
+        /// @brief Construct cache limited by total weight of entries
+        /// @param capacity maximum number of cached entries (size of the slab)
+        /// @param max_weight maximum total weight of cached entries
+        /// @param weigher function calculating weight (e.g. size in bytes) of an entry
+        LruCache(size_t capacity, size_t max_weight, weigher_type weigher);
+
+        LruCache(const LruCache& copy) = default;               ///< Copy constructor
+        LruCache(LruCache&& move);                              ///< Move constructor
+
+        LruCache& operator=(const LruCache& copy) = default;    ///< Copy assignment operator
+        LruCache& operator=(LruCache&& move);                   ///< Move assignment operator
+
+        ~LruCache() = default;                                  ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get maximum number of entries
+        /// @return size of the slab
+        size_t capacity() const;
+
+        /// @brief Get total weight of cached entries
+        /// @return sum of entries weight (equal to size() if cache isn't weighted)
+        size_t weight() const;
+
+        /// @brief Get maximum total weight of cached entries
+        /// @return weight limit (equal to capacity() if cache isn't weighted)
+        size_t max_weight() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert or update entry and mark it as the most recently used
+        /// @param key key of the entry
+        /// @param value value of the entry
+        /// @return true if new entry was inserted, false if existing one was updated or entry is heavier than max_weight()
+        bool put(const key_type& key, const mapped_type& value);
+        /// @brief Insert or update entry and mark it as the most recently used
+        /// @param key key of the entry
+        /// @param value value of the entry
+        /// @return true if new entry was inserted, false if existing one was updated or entry is heavier than max_weight()
+        bool put(const key_type& key, mapped_type&& value);
+
+        /// @brief Remove entry from cache
+        /// @param key key of the entry
+        /// @return true if entry was removed, false if it wasn't cached
+        bool erase(const key_type& key);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Access to cached value and mark it as the most recently used
+        /// @param key key of the entry
+        /// @return pointer to the cached value, nullptr on miss
+        pointer get(const key_type& key);
+
+        /// @brief Access to cached value without changing recency order and statistics
+        /// @param key key of the entry
+        /// @return pointer to the cached value, nullptr if value isn't cached
+        const_pointer peek(const key_type& key) const;
+
+        /// @brief Check if key is cached without changing recency order and statistics
+        /// @param key key of the entry
+        /// @return true if entry is cached
+        bool contains(const key_type& key) const;
+
+        /// @}
+        /// @name Statistics
+        /// @{
+
+        /// @return count of get() calls which found cached value
+        size_t hits() const;
+        /// @return count of get() calls which didn't find cached value
+        size_t misses() const;
+        /// @return count of entries removed to free space for new ones
+        size_t evictions() const;
+        /// @brief Reset hits, misses and evictions counters
+        void reset_stats();
+
+        /// @}
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct Node;
+
+        Array<Node> m_nodes;                ///< Slab of nodes
+        Array<size_t> m_buckets;            ///< Heads of index chains
+        size_t m_mask { 0 };                ///< Bucket count minus one
+
+        size_t m_head { npos };             ///< Most recently used node
+        size_t m_tail { npos };             ///< Least recently used node
+        size_t m_free { npos };             ///< Head of unused nodes list
+
+        size_t m_size { 0 };
+        size_t m_weight { 0 };
+        size_t m_max_weight { 0 };
+        weigher_type m_weigher;
+
+        size_t m_hits { 0 };
+        size_t m_misses { 0 };
+        size_t m_evictions { 0 };
+
+        inline size_t calc_address(const Key& key) const;
+        size_t find_node(const Key& key) const;
+        size_t calc_weight(const Key& key, const T& value) const;
+
+        void link_front(size_t index);
+        void unlink(size_t index);
+        void unlink_index(size_t index);
+        void release(size_t index);
+        void evict();
+        size_t acquire(const Key& key);
+        void reset_moved();
+
+        template<typename V>
+        bool put_impl(const key_type& key, V&& value);
+    };
+
+    /// @brief Struct representing LruCache's slab cell
+    template<typename Key, typename T>
+    struct LruCache<Key, T>::Node
+    {
+        Key key {};                         ///< @private
+        T value {};                         ///< @private
+        size_t weight { 0 };                ///< @private
+        size_t prev { npos };               ///< Previous node in recency order     @private
+        size_t next { npos };               ///< Next node in recency or free list  @private
+        size_t chain { npos };              ///< Next node in the same bucket       @private
+    };
+}
+
+template<typename Key, typename T>
+constexpr size_t CppADS::LruCache<Key, T>::npos;
+
+template<typename Key, typename T>
+CppADS::LruCache<Key, T>::LruCache(size_t capacity)
+    : LruCache(capacity, capacity, nullptr)
+{}
+
+template<typename Key, typename T>
+CppADS::LruCache<Key, T>::LruCache(size_t capacity, size_t max_weight, weigher_type weigher)
+    : m_max_weight(max_weight), m_weigher(std::move(weigher))
+{
+    if (capacity == 0)
+        throw std::invalid_argument("CppADS::LruCache<Key, T>::LruCache: capacity must be positive");
+
+    size_t bucket_count = 1;
+    while (bucket_count < capacity)
+        bucket_count <<= 1;
+    m_mask = bucket_count - 1;
+
+    m_nodes.reserve(capacity);
+    for (size_t i = 0; i < capacity; i++)
+        m_nodes.push_back(Node{});
+
+    m_buckets.reserve(bucket_count);
+    for (size_t i = 0; i < bucket_count; i++)
+        m_buckets.push_back(npos);
+
+    clear();
+}
+
+template<typename Key, typename T>
+CppADS::LruCache<Key, T>::LruCache(LruCache&& move)
+    : m_nodes(std::move(move.m_nodes)), m_buckets(std::move(move.m_buckets)), m_mask(move.m_mask),
+      m_head(move.m_head), m_tail(move.m_tail), m_free(move.m_free),
+      m_size(move.m_size), m_weight(move.m_weight), m_max_weight(move.m_max_weight), m_weigher(std::move(move.m_weigher)),
+      m_hits(move.m_hits), m_misses(move.m_misses), m_evictions(move.m_evictions)
+{
+    move.reset_moved();
+}
+
+template<typename Key, typename T>
+CppADS::LruCache<Key, T>& CppADS::LruCache<Key, T>::operator=(LruCache&& move)
+{
+    if (this == &move)
+        return *this;
+
+    m_nodes = std::move(move.m_nodes);
+    m_buckets = std::move(move.m_buckets);
+    m_mask = move.m_mask;
+    m_head = move.m_head;
+    m_tail = move.m_tail;
+    m_free = move.m_free;
+    m_size = move.m_size;
+    m_weight = move.m_weight;
+    m_max_weight = move.m_max_weight;
+    m_weigher = std::move(move.m_weigher);
+    m_hits = move.m_hits;
+    m_misses = move.m_misses;
+    m_evictions = move.m_evictions;
+
+    move.reset_moved();
+    return *this;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::size() const
+{
+    return m_size;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::capacity() const
+{
+    return m_nodes.size();
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::weight() const
+{
+    return m_weight;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::max_weight() const
+{
+    return m_max_weight;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::clear()
+{
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        m_nodes[i] = Node{};
+        m_nodes[i].next = (i + 1 < m_nodes.size()) ? i + 1 : npos;
+    }
+    for (auto it = m_buckets.begin(); it != m_buckets.end(); ++it)
+        *it = npos;
+
+    m_head = npos;
+    m_tail = npos;
+    m_free = m_nodes.size() != 0 ? 0 : npos;
+    m_size = 0;
+    m_weight = 0;
+}
+
+template<typename Key, typename T>
+bool CppADS::LruCache<Key, T>::put(const key_type& key, const mapped_type& value)
+{
+    return put_impl(key, value);
+}
+
+template<typename Key, typename T>
+bool CppADS::LruCache<Key, T>::put(const key_type& key, mapped_type&& value)
+{
+    return put_impl(key, std::move(value));
+}
+
+template<typename Key, typename T>
+template<typename V>
+bool CppADS::LruCache<Key, T>::put_impl(const key_type& key, V&& value)
+{
+    // Moved-from cache has no slab to store entries in
+    if (m_nodes.size() == 0)
+        return false;
+
+    size_t weight = calc_weight(key, value);
+    size_t index = find_node(key);
+
+    if (weight > m_max_weight)
+    {
+        if (index != npos)
+            release(index);
+        return false;
+    }
+
+    // Value is assigned before the node is indexed or leaves the recency list,
+    // so a throwing assignment leaves the list, index and weight consistent
+    bool inserted = (index == npos);
+    if (inserted)
+    {
+        if (m_free == npos)
+            evict();
+        m_nodes[m_free].value = std::forward<V>(value);
+        index = acquire(key);
+    }
+    else
+    {
+        m_nodes[index].value = std::forward<V>(value);
+        unlink(index);
+        m_weight -= m_nodes[index].weight;
+    }
+
+    Node& node = m_nodes[index];
+    node.weight = weight;
+    m_weight += weight;
+    link_front(index);
+
+    while (m_weight > m_max_weight)
+        evict();
+
+    return inserted;
+}
+
+template<typename Key, typename T>
+bool CppADS::LruCache<Key, T>::erase(const key_type& key)
+{
+    size_t index = find_node(key);
+    if (index == npos)
+        return false;
+
+    release(index);
+    return true;
+}
+
+template<typename Key, typename T>
+typename CppADS::LruCache<Key, T>::pointer CppADS::LruCache<Key, T>::get(const key_type& key)
+{
+    size_t index = find_node(key);
+    if (index == npos)
+    {
+        m_misses++;
+        return nullptr;
+    }
+
+    m_hits++;
+    if (index != m_head)
+    {
+        unlink(index);
+        link_front(index);
+    }
+    return &m_nodes[index].value;
+}
+
+template<typename Key, typename T>
+typename CppADS::LruCache<Key, T>::const_pointer CppADS::LruCache<Key, T>::peek(const key_type& key) const
+{
+    size_t index = find_node(key);
+    return (index == npos) ? nullptr : &m_nodes[index].value;
+}
+
+template<typename Key, typename T>
+bool CppADS::LruCache<Key, T>::contains(const key_type& key) const
+{
+    return find_node(key) != npos;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::hits() const
+{
+    return m_hits;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::misses() const
+{
+    return m_misses;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::evictions() const
+{
+    return m_evictions;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::reset_stats()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::calc_address(const Key& key) const
+{
+    return hash_mix(std::hash<Key>{}(key)) & m_mask;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::find_node(const Key& key) const
+{
+    if (m_buckets.size() == 0)
+        return npos;
+
+    size_t index = m_buckets[calc_address(key)];
+    while (index != npos && !(m_nodes[index].key == key))
+        index = m_nodes[index].chain;
+    return index;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::calc_weight(const Key& key, const T& value) const
+{
+    return m_weigher ? m_weigher(key, value) : 1;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::link_front(size_t index)
+{
+    Node& node = m_nodes[index];
+    node.prev = npos;
+    node.next = m_head;
+    if (m_head != npos)
+        m_nodes[m_head].prev = index;
+    else
+        m_tail = index;
+    m_head = index;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::unlink(size_t index)
+{
+    Node& node = m_nodes[index];
+    if (node.prev != npos)
+        m_nodes[node.prev].next = node.next;
+    else
+        m_head = node.next;
+
+    if (node.next != npos)
+        m_nodes[node.next].prev = node.prev;
+    else
+        m_tail = node.prev;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::unlink_index(size_t index)
+{
+    size_t* link = &m_buckets[calc_address(m_nodes[index].key)];
+    while (*link != index)
+        link = &m_nodes[*link].chain;
+    *link = m_nodes[index].chain;
+}
+
+template<typename Key, typename T>
+size_t CppADS::LruCache<Key, T>::acquire(const Key& key)
+{
+    size_t index = m_free;
+    Node& node = m_nodes[index];
+    node.key = key;
+    size_t& bucket = m_buckets[calc_address(key)];
+
+    // Node leaves the free list only when nothing can throw
+    m_free = node.next;
+    node.chain = bucket;
+    bucket = index;
+
+    m_size++;
+    return index;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::release(size_t index)
+{
+    unlink(index);
+    unlink_index(index);
+
+    Node& node = m_nodes[index];
+    m_weight -= node.weight;
+    node.key = Key{};
+    node.value = T{};
+    node.weight = 0;
+    node.prev = npos;
+    node.chain = npos;
+    node.next = m_free;
+    m_free = index;
+
+    m_size--;
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::reset_moved()
+{
+    m_nodes.clear();
+    m_buckets.clear();
+    m_mask = 0;
+    m_head = npos;
+    m_tail = npos;
+    m_free = npos;
+    m_size = 0;
+    m_weight = 0;
+    m_max_weight = 0;
+    m_weigher = nullptr;
+    reset_stats();
+}
+
+template<typename Key, typename T>
+void CppADS::LruCache<Key, T>::evict()
+{
+    release(m_tail);
+    m_evictions++;
+}
+
+#endif //LRU_CACHE_HPP
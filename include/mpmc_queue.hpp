@@ -0,0 +1,422 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include "concurrency.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace CppADS
+{
+    /// @brief Bounded lock-free FIFO queue for multiple producers and multiple consumers
+    /// @details Values are stored in a power of two ring of cells, each cell has a sequence
+    /// number telling which ticket may use it next. Cell for ticket t is free for producer
+    /// when its sequence equals t and holds a value for consumer when its sequence equals
+    /// t + 1. Producers and consumers take tickets by CAS on their own position counter,
+    /// so the only shared write per operation is one CAS and one store to the cell.
+    ///
+    /// Blocking methods spin with backoff first and then sleep on condition variable;
+    /// non-blocking methods take the mutex of sleeping threads only when somebody sleeps.
+    /// @tparam T value type stored in the container
+    template<typename T>
+    class MpmcQueue
+    {
+    public:
+        using value_type = T;
+
+        /// @brief Constructor
+        /// @param capacity minimum count of elements, rounded up to power of two
+        explicit MpmcQueue(size_t capacity);
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        ~MpmcQueue() = default;                         ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of elements
+        /// @details Exact only when there are no concurrent operations
+        /// @return element's count
+        size_t size() const;
+
+        /// @brief Get maximum count of elements
+        /// @return buffer size
+        size_t capacity() const;
+
+        /// @return true if queue has no elements
+        bool empty() const;
+
+        /// @}
+        /// @name Producers
+        /// @{
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        /// @return false if queue is full
+        bool try_enqueue(const T& value);
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        /// @return false if queue is full
+        bool try_enqueue(T&& value);
+
+        /// @brief Add value to tail of queue, wait while queue is full
+        /// @param value added value
+        void enqueue(const T& value);
+
+        /// @brief Add value to tail of queue, wait while queue is full
+        /// @param value added value
+        void enqueue(T&& value);
+
+        /// @brief Add several values to tail of queue claiming all of their cells at once
+        /// @param first iterator to the first added value
+        /// @param count maximum count of added values
+        /// @return count of added values, they are taken from the beginning of range
+        template<typename InputIt>
+        size_t try_enqueue_bulk(InputIt first, size_t count);
+
+        /// @}
+        /// @name Consumers
+        /// @{
+
+        /// @brief Move front value out of queue
+        /// @param value destination
+        /// @return false if queue is empty
+        bool try_dequeue(T& value);
+
+        /// @brief Move front value out of queue, wait while queue is empty
+        /// @param value destination
+        void dequeue(T& value);
+
+        /// @brief Move several front values out of queue claiming all of their cells at once
+        /// @param out output iterator receiving removed values
+        /// @param count maximum count of removed values
+        /// @return count of removed values
+        template<typename OutputIt>
+        size_t try_dequeue_bulk(OutputIt out, size_t count);
+
+        /// @}
+
+    private:
+        /// @private
+        /// @brief Storage slot
+        struct Cell
+        {
+            std::atomic<size_t> sequence { 0 };         ///< Ticket allowed to use the cell next
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> m_buffer { nullptr };   ///< Ring of cells
+        size_t m_mask { 0 };                            ///< Ring size minus one
+
+        alignas(CacheLineSize) std::atomic<size_t> m_enqueue_pos { 0 };    ///< Next producer's ticket
+        alignas(CacheLineSize) std::atomic<size_t> m_dequeue_pos { 0 };    ///< Next consumer's ticket
+
+        alignas(CacheLineSize) std::atomic<size_t> m_sleeping_producers { 0 };
+        std::atomic<size_t> m_sleeping_consumers { 0 };
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+
+        /// @private
+        /// @brief Claim cell for producer
+        /// @return cell or nullptr if queue is full
+        Cell* acquire_enqueue(size_t& ticket);
+
+        /// @private
+        /// @brief Claim cell for consumer
+        /// @return cell or nullptr if queue is empty
+        Cell* acquire_dequeue(size_t& ticket);
+
+        /// @private
+        /// @brief Wake up threads sleeping in the opposite blocking method
+        void notify(std::atomic<size_t>& sleeping, std::condition_variable& condition);
+
+        /// @private
+        /// @return true if the next producer's cell looks free
+        bool enqueue_ready() const;
+
+        /// @private
+        /// @return true if the next consumer's cell looks published
+        bool dequeue_ready() const;
+
+        /// @private
+        /// @brief Repeat attempt until it succeeds, first spinning and then sleeping
+        /// @param attempt non-blocking operation
+        /// @param ready check whether attempt may succeed, must not take any locks
+        template<typename Attempt, typename Ready>
+        void wait(Attempt attempt, Ready ready, std::atomic<size_t>& sleeping, std::condition_variable& condition);
+    };
+}
+
+template<typename T>
+CppADS::MpmcQueue<T>::MpmcQueue(size_t capacity)
+{
+    if (capacity < 2)
+        throw std::invalid_argument("CppADS::MpmcQueue<T>::MpmcQueue: capacity must be at least 2");
+
+    size_t storage_size = 1;
+    while (storage_size < capacity)
+        storage_size <<= 1;
+
+    m_buffer = std::make_unique<Cell[]>(storage_size);
+    for (size_t i = 0; i < storage_size; i++)
+        m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+    m_mask = storage_size - 1;
+}
+
+template<typename T>
+size_t CppADS::MpmcQueue<T>::size() const
+{
+    size_t head = m_dequeue_pos.load(std::memory_order_acquire);
+    size_t tail = m_enqueue_pos.load(std::memory_order_acquire);
+    return (tail >= head) ? tail - head : 0;
+}
+
+template<typename T>
+size_t CppADS::MpmcQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T>
+typename CppADS::MpmcQueue<T>::Cell* CppADS::MpmcQueue<T>::acquire_enqueue(size_t& ticket)
+{
+    ticket = m_enqueue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell* cell = &m_buffer[ticket & m_mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket);
+        if (diff == 0)
+        {
+            if (m_enqueue_pos.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if (diff < 0)
+        {
+            return nullptr;
+        }
+        else
+        {
+            ticket = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+typename CppADS::MpmcQueue<T>::Cell* CppADS::MpmcQueue<T>::acquire_dequeue(size_t& ticket)
+{
+    ticket = m_dequeue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell* cell = &m_buffer[ticket & m_mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket + 1);
+        if (diff == 0)
+        {
+            if (m_dequeue_pos.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed))
+                return cell;
+        }
+        else if (diff < 0)
+        {
+            return nullptr;
+        }
+        else
+        {
+            ticket = m_dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename T>
+void CppADS::MpmcQueue<T>::notify(std::atomic<size_t>& sleeping, std::condition_variable& condition)
+{
+    // Pairs with the fence in wait(): either sleeper sees published cell or we see sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // Sleeper checks the queue and goes to sleep under the mutex, so taking it here
+    // guarantees that notification isn't lost between its check and its wait
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    condition.notify_all();
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::enqueue_ready() const
+{
+    size_t ticket = m_enqueue_pos.load(std::memory_order_relaxed);
+    size_t sequence = m_buffer[ticket & m_mask].sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket) >= 0;
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::dequeue_ready() const
+{
+    size_t ticket = m_dequeue_pos.load(std::memory_order_relaxed);
+    size_t sequence = m_buffer[ticket & m_mask].sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(ticket + 1) >= 0;
+}
+
+template<typename T>
+template<typename Attempt, typename Ready>
+void CppADS::MpmcQueue<T>::wait(Attempt attempt, Ready ready, std::atomic<size_t>& sleeping, std::condition_variable& condition)
+{
+    Backoff backoff;
+    while (!backoff.exhausted())
+    {
+        if (attempt())
+            return;
+        backoff.pause();
+    }
+
+    // attempt() notifies the opposite side and may take the mutex itself,
+    // so under the mutex only the lock-free readiness check is done
+    while (!attempt())
+    {
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!ready())
+            condition.wait(lock);
+        sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::try_enqueue(const T& value)
+{
+    size_t ticket;
+    Cell* cell = acquire_enqueue(ticket);
+    if (cell == nullptr)
+        return false;
+
+    cell->value = value;
+    cell->sequence.store(ticket + 1, std::memory_order_release);
+    notify(m_sleeping_consumers, m_not_empty);
+    return true;
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::try_enqueue(T&& value)
+{
+    size_t ticket;
+    Cell* cell = acquire_enqueue(ticket);
+    if (cell == nullptr)
+        return false;
+
+    cell->value = std::move(value);
+    cell->sequence.store(ticket + 1, std::memory_order_release);
+    notify(m_sleeping_consumers, m_not_empty);
+    return true;
+}
+
+template<typename T>
+void CppADS::MpmcQueue<T>::enqueue(const T& value)
+{
+    wait([this, &value]() { return try_enqueue(value); },
+         [this]() { return enqueue_ready(); }, m_sleeping_producers, m_not_full);
+}
+
+template<typename T>
+void CppADS::MpmcQueue<T>::enqueue(T&& value)
+{
+    // try_enqueue moves from value only on success
+    wait([this, &value]() { return try_enqueue(std::move(value)); },
+         [this]() { return enqueue_ready(); }, m_sleeping_producers, m_not_full);
+}
+
+template<typename T>
+template<typename InputIt>
+size_t CppADS::MpmcQueue<T>::try_enqueue_bulk(InputIt first, size_t count)
+{
+    size_t ticket = m_enqueue_pos.load(std::memory_order_relaxed);
+    size_t claimed;
+    do
+    {
+        // Cell with sequence equal to its ticket can't be taken by anybody else
+        // without moving m_enqueue_pos, which makes the CAS below fail
+        claimed = 0;
+        while (claimed < count &&
+               m_buffer[(ticket + claimed) & m_mask].sequence.load(std::memory_order_acquire) == ticket + claimed)
+            claimed++;
+        if (claimed == 0)
+            return 0;
+    }
+    while (!m_enqueue_pos.compare_exchange_weak(ticket, ticket + claimed, std::memory_order_relaxed));
+
+    for (size_t i = 0; i < claimed; i++, ++first)
+    {
+        Cell& cell = m_buffer[(ticket + i) & m_mask];
+        cell.value = *first;
+        cell.sequence.store(ticket + i + 1, std::memory_order_release);
+    }
+    notify(m_sleeping_consumers, m_not_empty);
+    return claimed;
+}
+
+template<typename T>
+bool CppADS::MpmcQueue<T>::try_dequeue(T& value)
+{
+    size_t ticket;
+    Cell* cell = acquire_dequeue(ticket);
+    if (cell == nullptr)
+        return false;
+
+    value = std::move(cell->value);
+    cell->sequence.store(ticket + m_mask + 1, std::memory_order_release);
+    notify(m_sleeping_producers, m_not_full);
+    return true;
+}
+
+template<typename T>
+void CppADS::MpmcQueue<T>::dequeue(T& value)
+{
+    wait([this, &value]() { return try_dequeue(value); },
+         [this]() { return dequeue_ready(); }, m_sleeping_consumers, m_not_empty);
+}
+
+template<typename T>
+template<typename OutputIt>
+size_t CppADS::MpmcQueue<T>::try_dequeue_bulk(OutputIt out, size_t count)
+{
+    size_t ticket = m_dequeue_pos.load(std::memory_order_relaxed);
+    size_t claimed;
+    do
+    {
+        // Only published values are claimed, so consumer never waits for producer
+        claimed = 0;
+        while (claimed < count &&
+               m_buffer[(ticket + claimed) & m_mask].sequence.load(std::memory_order_acquire) == ticket + claimed + 1)
+            claimed++;
+        if (claimed == 0)
+            return 0;
+    }
+    while (!m_dequeue_pos.compare_exchange_weak(ticket, ticket + claimed, std::memory_order_relaxed));
+
+    for (size_t i = 0; i < claimed; i++, ++out)
+    {
+        Cell& cell = m_buffer[(ticket + i) & m_mask];
+        *out = std::move(cell.value);
+        cell.sequence.store(ticket + i + m_mask + 1, std::memory_order_release);
+    }
+    notify(m_sleeping_producers, m_not_full);
+    return claimed;
+}
+
+#endif //MPMC_QUEUE_HPP
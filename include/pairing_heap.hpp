@@ -0,0 +1,522 @@
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+#include "container.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Addressable pairing min-heap with stable handles, unlike max-heap PriorityQueue
+    /// @details Heap-ordered multiway tree kept as left-child / right-sibling nodes. Push,
+    /// meld and decrease_key only link trees in O(1), pop merges children of the root in
+    /// two passes in O(log n) amortized time. A handle points to the node of its item and
+    /// stays valid until the item is popped or erased. Nodes count their reuses, so stale
+    /// handles are rejected with std::out_of_range even when their node holds a new item.
+    ///
+    /// Like IndexedHeap it is a min-heap: the top is the least item according to Compare.
+    /// Removed nodes are kept in a free list and reused by next pushes.
+    /// @tparam T value type stored in the container
+    /// @tparam Compare strict weak ordering, the top is an item which isn't greater than others
+    template<class T, class Compare = std::less<T>>
+    class PairingHeap : public IContainer
+    {
+        struct Node;
+
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using value_compare = Compare;
+
+        /// @brief Stable reference to item in the heap
+        class handle_type
+        {
+        public:
+            handle_type() = default;
+
+            bool operator==(const handle_type& rhs) const { return m_node == rhs.m_node && m_generation == rhs.m_generation; }
+            bool operator!=(const handle_type& rhs) const { return !(*this == rhs); }
+
+        private:
+            Node* m_node { nullptr };
+            size_t m_generation { 0 };      ///< Generation of the node when the handle was made
+            friend class PairingHeap;
+
+            explicit handle_type(Node* node) : m_node(node), m_generation(node->generation) {}
+        };
+
+        PairingHeap() = default;                                        ///< Default constructor
+        explicit PairingHeap(const Compare& compare);                   ///< Constructor with comparator
+        PairingHeap(PairingHeap&& move);                                ///< Move contructor
+        PairingHeap& operator=(PairingHeap&& move);                     ///< Move assignment operator
+
+        PairingHeap(const PairingHeap&) = delete;
+        PairingHeap& operator=(const PairingHeap&) = delete;
+
+        ~PairingHeap();                                                 ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @return true if heap has no elements
+        bool empty() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container, all handles become invalid
+        void clear() override;
+
+        /// @brief Add value, O(1)
+        /// @param value added value
+        /// @return handle of the item
+        handle_type push(const T& value);
+
+        /// @brief Add value, O(1)
+        /// @param value added value
+        /// @return handle of the item
+        handle_type push(T&& value);
+
+        /// @brief Construct value in the heap, O(1)
+        /// @param args arguments of value's constructor
+        /// @return handle of the item
+        template<typename... Args>
+        handle_type emplace(Args&&... args);
+
+        /// @brief Move all items of other heap into this one, O(1)
+        /// @details Handles of moved items stay valid
+        /// @param other merged heap, becomes empty
+        void merge(PairingHeap& other);
+
+        /// @brief Remove top item, O(log n) amortized
+        void pop();
+
+        /// @brief Remove item, O(log n) amortized
+        /// @param handle handle of the item
+        void erase(handle_type handle);
+
+        /// @brief Set smaller key of item and move it towards the top, O(1) link, restructuring is left to pop()
+        /// @param handle handle of the item
+        /// @param value new value which isn't greater than the current one
+        void decrease_key(handle_type handle, T value);
+
+        /// @brief Set greater key of item and move it away from the top, O(log n) amortized
+        /// @param handle handle of the item
+        /// @param value new value which isn't less than the current one
+        void increase_key(handle_type handle, T value);
+
+        /// @brief Set key of item in any direction
+        /// @param handle handle of the item
+        /// @param value new value
+        void update(handle_type handle, T value);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Get top item
+        /// @return const reference to the least item
+        const_reference top() const;
+
+        /// @brief Get handle of top item
+        handle_type top_handle() const;
+
+        /// @brief Get value of item
+        /// @param handle handle of the item
+        /// @return const reference to the value
+        const_reference get(handle_type handle) const;
+
+        /// @}
+
+    private:
+        /// @private
+        struct Node
+        {
+            T value {};
+            Node* child { nullptr };        ///< The first child
+            Node* next { nullptr };         ///< Next sibling, or next free node
+            Node* prev { nullptr };         ///< Previous sibling, or parent for the first child
+            size_t generation { 0 };        ///< Count of releases, handles of older items don't match
+        };
+
+        Node* m_root { nullptr };
+        Node* m_free { nullptr };           ///< List of removed nodes linked by next
+        size_t m_size { 0 };
+        Compare m_compare {};
+
+        /// @private
+        Node* check(handle_type handle, const char* function) const;
+
+        /// @private
+        /// @brief Create a single node tree
+        Node* make_node(T&& value);
+
+        /// @private
+        /// @brief Add node to free list
+        void release_node(Node* node);
+
+        /// @private
+        /// @brief Link two trees, the root with greater value becomes the first child of the other
+        Node* meld(Node* first, Node* second);
+
+        /// @private
+        /// @brief Unlink subtree of non-root node from its parent and siblings
+        void cut(Node* node);
+
+        /// @private
+        /// @brief Merge list of sibling trees into one tree (two-pass pairing)
+        Node* merge_pairs(Node* first);
+
+        /// @private
+        /// @brief Unlink node from the heap and put its children back
+        void detach(Node* node);
+
+        /// @private
+        /// @brief Release list of nodes linked by next and their subtrees to free list
+        void release_all(Node* first);
+
+        /// @private
+        /// @brief Delete list of nodes linked by next and their subtrees
+        static void destroy(Node* first);
+    };
+}
+
+template<class T, class Compare>
+CppADS::PairingHeap<T, Compare>::PairingHeap(const Compare& compare) : m_compare(compare) {}
+
+template<class T, class Compare>
+CppADS::PairingHeap<T, Compare>::PairingHeap(PairingHeap&& move)
+    : m_root(move.m_root), m_free(move.m_free), m_size(move.m_size), m_compare(std::move(move.m_compare))
+{
+    move.m_root = nullptr;
+    move.m_free = nullptr;
+    move.m_size = 0;
+}
+
+template<class T, class Compare>
+CppADS::PairingHeap<T, Compare>& CppADS::PairingHeap<T, Compare>::operator=(PairingHeap&& move)
+{
+    if (this == &move)
+        return *this;
+
+    destroy(m_root);
+    destroy(m_free);
+    m_root = move.m_root;
+    m_free = move.m_free;
+    m_size = move.m_size;
+    m_compare = std::move(move.m_compare);
+    move.m_root = nullptr;
+    move.m_free = nullptr;
+    move.m_size = 0;
+    return *this;
+}
+
+template<class T, class Compare>
+CppADS::PairingHeap<T, Compare>::~PairingHeap()
+{
+    destroy(m_root);
+    destroy(m_free);
+}
+
+template<class T, class Compare>
+size_t CppADS::PairingHeap<T, Compare>::size() const
+{
+    return m_size;
+}
+
+template<class T, class Compare>
+bool CppADS::PairingHeap<T, Compare>::empty() const
+{
+    return m_size == 0;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::clear()
+{
+    // Nodes are kept, so handles of cleared items are detected as stale
+    release_all(m_root);
+    m_root = nullptr;
+    m_size = 0;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::handle_type CppADS::PairingHeap<T, Compare>::push(const T& value)
+{
+    return emplace(value);
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::handle_type CppADS::PairingHeap<T, Compare>::push(T&& value)
+{
+    Node* node = make_node(std::move(value));
+    m_root = meld(m_root, node);
+    m_size++;
+    return handle_type(node);
+}
+
+template<class T, class Compare>
+template<typename... Args>
+typename CppADS::PairingHeap<T, Compare>::handle_type CppADS::PairingHeap<T, Compare>::emplace(Args&&... args)
+{
+    return push(T(std::forward<Args>(args)...));
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::merge(PairingHeap& other)
+{
+    if (this == &other)
+        return;
+    m_root = meld(m_root, other.m_root);
+    m_size += other.m_size;
+    other.m_root = nullptr;
+    other.m_size = 0;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::pop()
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PairingHeap<T>::pop: container is empty");
+    erase(handle_type(m_root));
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::erase(handle_type handle)
+{
+    Node* node = check(handle, "erase");
+    detach(node);
+    release_node(node);
+    m_size--;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::decrease_key(handle_type handle, T value)
+{
+    Node* node = check(handle, "decrease_key");
+    if (m_compare(node->value, value))
+        throw std::invalid_argument("CppADS::PairingHeap<T>::decrease_key: value is greater than the current one");
+
+    node->value = std::move(value);
+    if (node == m_root)
+        return;
+
+    // Subtree stays heap-ordered, only its link to the parent may break
+    cut(node);
+    m_root = meld(m_root, node);
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::increase_key(handle_type handle, T value)
+{
+    Node* node = check(handle, "increase_key");
+    if (m_compare(value, node->value))
+        throw std::invalid_argument("CppADS::PairingHeap<T>::increase_key: value is less than the current one");
+
+    detach(node);
+    node->value = std::move(value);
+    m_root = meld(m_root, node);
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::update(handle_type handle, T value)
+{
+    Node* node = check(handle, "update");
+    if (m_compare(value, node->value))
+        decrease_key(handle, std::move(value));
+    else
+        increase_key(handle, std::move(value));
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::const_reference CppADS::PairingHeap<T, Compare>::top() const
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PairingHeap<T>::top: container is empty");
+    return m_root->value;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::handle_type CppADS::PairingHeap<T, Compare>::top_handle() const
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PairingHeap<T>::top_handle: container is empty");
+    return handle_type(m_root);
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::const_reference CppADS::PairingHeap<T, Compare>::get(handle_type handle) const
+{
+    return check(handle, "get")->value;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::Node* CppADS::PairingHeap<T, Compare>::check(handle_type handle, const char* function) const
+{
+    if (handle.m_node == nullptr || handle.m_node->generation != handle.m_generation)
+        throw std::out_of_range(std::string("CppADS::PairingHeap<T>::") + function + ": handle is invalid");
+    return handle.m_node;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::Node* CppADS::PairingHeap<T, Compare>::make_node(T&& value)
+{
+    Node* node = m_free;
+    if (node != nullptr)
+    {
+        m_free = node->next;
+        node->next = nullptr;
+    }
+    else
+    {
+        node = new Node();
+    }
+    node->value = std::move(value);
+    return node;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::release_node(Node* node)
+{
+    node->value = T();
+    node->child = nullptr;
+    node->prev = nullptr;
+    node->next = m_free;
+    node->generation++;
+    m_free = node;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::Node* CppADS::PairingHeap<T, Compare>::meld(Node* first, Node* second)
+{
+    if (first == nullptr)
+        return second;
+    if (second == nullptr)
+        return first;
+    if (m_compare(second->value, first->value))
+        std::swap(first, second);
+
+    second->prev = first;
+    second->next = first->child;
+    if (first->child != nullptr)
+        first->child->prev = second;
+    first->child = second;
+    return first;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::cut(Node* node)
+{
+    if (node->prev->child == node)
+        node->prev->child = node->next;
+    else
+        node->prev->next = node->next;
+    if (node->next != nullptr)
+        node->next->prev = node->prev;
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+template<class T, class Compare>
+typename CppADS::PairingHeap<T, Compare>::Node* CppADS::PairingHeap<T, Compare>::merge_pairs(Node* first)
+{
+    if (first == nullptr)
+        return nullptr;
+
+    // The first pass melds pairs left to right and stacks the results through next
+    Node* paired = nullptr;
+    while (first != nullptr)
+    {
+        Node* left = first;
+        Node* right = left->next;
+        first = (right != nullptr) ? right->next : nullptr;
+
+        left->prev = left->next = nullptr;
+        if (right != nullptr)
+            right->prev = right->next = nullptr;
+
+        Node* tree = meld(left, right);
+        tree->next = paired;
+        paired = tree;
+    }
+
+    // The second pass melds them right to left into one tree
+    Node* result = paired;
+    paired = paired->next;
+    result->next = nullptr;
+    while (paired != nullptr)
+    {
+        Node* tree = paired;
+        paired = paired->next;
+        tree->next = nullptr;
+        result = meld(result, tree);
+    }
+    return result;
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::detach(Node* node)
+{
+    Node* children = merge_pairs(node->child);
+    node->child = nullptr;
+    if (node == m_root)
+    {
+        m_root = children;
+        return;
+    }
+    cut(node);
+    m_root = meld(m_root, children);
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::release_all(Node* first)
+{
+    // Children are pushed to the pending list before their parent is released
+    while (first != nullptr)
+    {
+        Node* node = first;
+        first = node->next;
+        if (node->child != nullptr)
+        {
+            Node* last = node->child;
+            while (last->next != nullptr)
+                last = last->next;
+            last->next = first;
+            first = node->child;
+        }
+        release_node(node);
+    }
+}
+
+template<class T, class Compare>
+void CppADS::PairingHeap<T, Compare>::destroy(Node* first)
+{
+    // Subtrees are spliced into the list instead of recursion, so deep trees are safe
+    while (first != nullptr)
+    {
+        Node* node = first;
+        if (node->child != nullptr)
+        {
+            Node* last = node->child;
+            while (last->next != nullptr)
+                last = last->next;
+            last->next = node->next;
+            first = node->child;
+        }
+        else
+        {
+            first = node->next;
+        }
+        delete node;
+    }
+}
+
+#endif //PAIRING_HEAP_HPP
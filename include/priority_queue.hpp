@@ -0,0 +1,370 @@
+#ifndef PRIORITY_QUEUE_HPP
+#define PRIORITY_QUEUE_HPP
+
+#include "array.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+namespace CppADS
+{
+    /// @brief Priority queue on implicit d-ary heap
+    /// @details Values are stored in Array in heap order, children of item i are items
+    /// Arity * i + 1 ... Arity * i + Arity. The top is the greatest item according to Compare
+    /// (std::less gives max-heap). Wider nodes make the heap shallower, so sift-down touches
+    /// fewer cache lines on large heaps at the cost of more comparisons per level.
+    /// @tparam T value type stored in the container
+    /// @tparam Compare strict weak ordering, the top is an item which isn't less than others
+    /// @tparam Arity count of children of a heap node
+    template<class T, class Compare = std::less<T>, size_t Arity = 2>
+    class PriorityQueue : private Array<T>
+    {
+        static_assert(Arity >= 2, "CppADS::PriorityQueue: arity must be at least 2");
+
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using value_compare = Compare;
+
+        PriorityQueue() = default;                                      ///< Default constructor
+        explicit PriorityQueue(const Compare& compare);                 ///< Constructor with comparator
+        PriorityQueue(const PriorityQueue& copy);                       ///< Copy contructor
+        PriorityQueue(PriorityQueue&& move);                            ///< Move contructor
+        PriorityQueue(std::initializer_list<T> init_list, const Compare& compare = Compare()); ///< Contructor from initializer list
+
+        /// @brief Build heap from range in O(n)
+        /// @param first iterator to the first value
+        /// @param last iterator to the element after the last value
+        /// @param compare comparator
+        template<typename InputIt>
+        PriorityQueue(InputIt first, InputIt last, const Compare& compare = Compare());
+
+        PriorityQueue& operator=(const PriorityQueue& copy);            ///< Copy assignment operator
+        PriorityQueue& operator=(PriorityQueue&& move);                 ///< Move assignment operator
+
+        ~PriorityQueue() = default;                                     ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @return true if queue has no elements
+        bool empty() const;
+
+        /// @brief Get reserved size for container's data
+        /// @return Current queue's capacity
+        size_t capacity() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Reserve space for specific count of items
+        /// @param count reserved space
+        void reserve(size_t count);
+
+        /// @brief Add value, O(log n)
+        /// @param value added value
+        void push(const T& value);
+
+        /// @brief Add value, O(log n)
+        /// @param value added value
+        void push(T&& value);
+
+        /// @brief Construct value in the queue, O(log n)
+        /// @param args arguments of value's constructor
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        /// @brief Add range of values
+        /// @details Values are appended and the heap is rebuilt in O(n + k) when the range
+        /// is at least as large as the queue, otherwise they are pushed one by one
+        /// @param first iterator to the first value
+        /// @param last iterator to the element after the last value
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
+        /// @brief Remove top item, O(log n)
+        void pop();
+
+        /// @brief Add value and remove top item in one sift
+        /// @details Faster than push() followed by pop(), value is returned back without
+        /// touching the heap if it would be the top
+        /// @param value added value
+        /// @return removed top item
+        T push_pop(T value);
+
+        /// @brief Remove top item and add value in one sift
+        /// @details Unlike push_pop() the removed item is the top before value is added
+        /// @param value added value
+        /// @return removed top item
+        T replace_top(T value);
+
+        ///@}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Get top item
+        /// @return const reference to the greatest item
+        const_reference top() const;
+
+        /// @}
+
+    private:
+        Compare m_compare {};
+
+        /// @private
+        T* data();
+
+        /// @private
+        /// @brief Move item at index up to its place
+        void sift_up(size_t index);
+
+        /// @private
+        /// @brief Put value to the hole at index and move it down to its place
+        void sift_down(size_t index, T value);
+
+        /// @private
+        /// @brief Restore heap order of all items
+        void heapify();
+    };
+}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>::PriorityQueue(const Compare& compare) : m_compare(compare) {}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>::PriorityQueue(const PriorityQueue& copy)
+    : Array<T>(copy), m_compare(copy.m_compare) {}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>::PriorityQueue(PriorityQueue&& move)
+    : Array<T>(std::move(move)), m_compare(std::move(move.m_compare)) {}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>::PriorityQueue(std::initializer_list<T> init_list, const Compare& compare)
+    : Array<T>(init_list), m_compare(compare)
+{
+    heapify();
+}
+
+template<class T, class Compare, size_t Arity>
+template<typename InputIt>
+CppADS::PriorityQueue<T, Compare, Arity>::PriorityQueue(InputIt first, InputIt last, const Compare& compare)
+    : m_compare(compare)
+{
+    push_range(first, last);
+}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>& CppADS::PriorityQueue<T, Compare, Arity>::operator=(const PriorityQueue& copy)
+{
+    Array<T>::operator=(copy);
+    m_compare = copy.m_compare;
+    return *this;
+}
+
+template<class T, class Compare, size_t Arity>
+CppADS::PriorityQueue<T, Compare, Arity>& CppADS::PriorityQueue<T, Compare, Arity>::operator=(PriorityQueue&& move)
+{
+    Array<T>::operator=(std::move(move));
+    m_compare = std::move(move.m_compare);
+    return *this;
+}
+
+template<class T, class Compare, size_t Arity>
+size_t CppADS::PriorityQueue<T, Compare, Arity>::size() const
+{
+    return Array<T>::size();
+}
+
+template<class T, class Compare, size_t Arity>
+bool CppADS::PriorityQueue<T, Compare, Arity>::empty() const
+{
+    return Array<T>::size() == 0;
+}
+
+template<class T, class Compare, size_t Arity>
+size_t CppADS::PriorityQueue<T, Compare, Arity>::capacity() const
+{
+    return Array<T>::capacity();
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::clear()
+{
+    Array<T>::clear();
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::reserve(size_t count)
+{
+    Array<T>::reserve(count);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::push(const T& value)
+{
+    Array<T>::push_back(value);
+    sift_up(size() - 1);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::push(T&& value)
+{
+    Array<T>::push_back(std::move(value));
+    sift_up(size() - 1);
+}
+
+template<class T, class Compare, size_t Arity>
+template<typename... Args>
+void CppADS::PriorityQueue<T, Compare, Arity>::emplace(Args&&... args)
+{
+    Array<T>::push_back(T(std::forward<Args>(args)...));
+    sift_up(size() - 1);
+}
+
+template<class T, class Compare, size_t Arity>
+template<typename InputIt>
+void CppADS::PriorityQueue<T, Compare, Arity>::push_range(InputIt first, InputIt last)
+{
+    size_t old_size = size();
+    for (; first != last; ++first)
+        Array<T>::push_back(*first);
+
+    size_t added = size() - old_size;
+    if (added >= old_size)
+    {
+        heapify();
+        return;
+    }
+    for (size_t index = old_size; index < size(); index++)
+        sift_up(index);
+}
+
+template<class T, class Compare, size_t Arity>
+typename CppADS::PriorityQueue<T, Compare, Arity>::const_reference CppADS::PriorityQueue<T, Compare, Arity>::top() const
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PriorityQueue<T>::top: container is empty");
+    return Array<T>::front();
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::pop()
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PriorityQueue<T>::pop: container is empty");
+
+    T last = std::move(Array<T>::back());
+    Array<T>::pop_back();
+    if (!empty())
+        sift_down(0, std::move(last));
+}
+
+template<class T, class Compare, size_t Arity>
+T CppADS::PriorityQueue<T, Compare, Arity>::push_pop(T value)
+{
+    if (empty() || !m_compare(value, Array<T>::front()))
+        return value;
+
+    T result = std::move(data()[0]);
+    sift_down(0, std::move(value));
+    return result;
+}
+
+template<class T, class Compare, size_t Arity>
+T CppADS::PriorityQueue<T, Compare, Arity>::replace_top(T value)
+{
+    if (empty())
+        throw std::out_of_range("CppADS::PriorityQueue<T>::replace_top: container is empty");
+
+    T result = std::move(data()[0]);
+    sift_down(0, std::move(value));
+    return result;
+}
+
+template<class T, class Compare, size_t Arity>
+T* CppADS::PriorityQueue<T, Compare, Arity>::data()
+{
+    return &*Array<T>::begin();
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::sift_up(size_t index)
+{
+    T* items = data();
+    T value = std::move(items[index]);
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / Arity;
+        if (!m_compare(items[parent], value))
+            break;
+        items[index] = std::move(items[parent]);
+        index = parent;
+    }
+    items[index] = std::move(value);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::sift_down(size_t index, T value)
+{
+    T* items = data();
+    size_t count = size();
+    while (true)
+    {
+        size_t first_child = Arity * index + 1;
+        if (first_child >= count)
+            break;
+
+        // Greatest of the children, a full node is the common case and has a fixed loop
+        size_t best = first_child;
+        if (first_child + Arity <= count)
+        {
+            for (size_t child = first_child + 1; child < first_child + Arity; child++)
+            {
+                if (m_compare(items[best], items[child]))
+                    best = child;
+            }
+        }
+        else
+        {
+            for (size_t child = first_child + 1; child < count; child++)
+            {
+                if (m_compare(items[best], items[child]))
+                    best = child;
+            }
+        }
+
+        if (!m_compare(value, items[best]))
+            break;
+        items[index] = std::move(items[best]);
+        index = best;
+    }
+    items[index] = std::move(value);
+}
+
+template<class T, class Compare, size_t Arity>
+void CppADS::PriorityQueue<T, Compare, Arity>::heapify()
+{
+    size_t count = size();
+    if (count < 2)
+        return;
+
+    T* items = data();
+    for (size_t index = (count - 2) / Arity + 1; index-- > 0;)
+        sift_down(index, std::move(items[index]));
+}
+
+#endif //PRIORITY_QUEUE_HPP
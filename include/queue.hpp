@@ -1,14 +1,22 @@
 #ifndef QUEUE_HPP
 #define QUEUE_HPP
 
-#include "forward_list.hpp"
+#include "container.hpp"
+
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
 
 namespace CppADS
 {
     /// @brief FIFO data structure class
+    /// @details Values are stored in a contiguous circular buffer which doubles its
+    /// capacity when full, so enqueue/dequeue don't allocate per element. Unused slots
+    /// of the buffer are uninitialized, so T needn't be default constructible.
     /// @tparam T value type stored in the container
     template<class T>
-    class Queue : private ForwardList<T>
+    class Queue : public IContainer
     {
     public:
         using value_type = T;
@@ -25,7 +33,7 @@ namespace CppADS
         Queue& operator=(const Queue<T>& copy);         ///< Copy assignment operator
         Queue& operator=(Queue<T>&& move);              ///< Move assignment operator
 
-        ~Queue() = default;                             ///< Destructor
+        ~Queue();                                       ///< Destructor
 
         /// @name Capacity
         /// @{
@@ -34,6 +42,10 @@ namespace CppADS
         /// @return element's count
         size_t size() const override;
 
+        /// @brief Get reserved size for container's data
+        /// @return Current buffer's capacity
+        size_t capacity() const;
+
         /// @}
         /// @name Modifiers
         /// @{
@@ -41,6 +53,10 @@ namespace CppADS
         /// @brief Remove all data from container
         void clear() override;
 
+        /// @brief Reserve space for specific count of items
+        /// @param count reserved space
+        void reserve(size_t count);
+
         /// @brief Add value to tail of queue
         /// @param value added value
         void enqueue(const T& value);
@@ -49,9 +65,27 @@ namespace CppADS
         /// @param value added value
         void enqueue(T&& value);
 
+        /// @brief Construct value in the tail of queue
+        /// @param args arguments of value's constructor
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        /// @brief Add range of values to tail of queue
+        /// @param first iterator to the first added value
+        /// @param last iterator to the element after the last added value
+        template<typename InputIt>
+        void enqueue_bulk(InputIt first, InputIt last);
+
         /// @brief Remove front element
         void dequeue();
 
+        /// @brief Move front elements out of queue
+        /// @param out output iterator receiving removed values
+        /// @param count maximum count of removed values
+        /// @return count of removed values
+        template<typename OutputIt>
+        size_t dequeue_bulk(OutputIt out, size_t count);
+
         ///@}
         /// @name Accesors
         /// @{
@@ -64,72 +98,277 @@ namespace CppADS
         const_reference front() const;
 
         /// @}
+
+    private:
+        T* m_data { nullptr };                      ///< Circular buffer of uninitialized slots
+        size_t m_capacity { 0 };                    ///< Buffer size (power of two)
+        size_t m_head { 0 };                        ///< Position of the first element
+        size_t m_size { 0 };                        ///< Count of elements
+
+        inline T& at(size_t index);
+        inline const T& at(size_t index) const;
+
+        /// @private
+        /// @brief Get size of the buffer which fits given count of items
+        /// @param count items count
+        /// @return power of two capacity
+        size_t calc_capacity(size_t count) const;
+
+        /// @private
+        /// @brief Move data into new buffer and release the old one
+        /// @param data new buffer
+        /// @param capacity new buffer size (power of two)
+        void relocate(T* data, size_t capacity);
+
+        template<typename InputIt>
+        void reserve_range(InputIt first, InputIt last, std::input_iterator_tag);
+        template<typename ForwardIt>
+        void reserve_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
     };
 }
 
 template<typename T>
-CppADS::Queue<T>::Queue(const Queue<T>& copy) : ForwardList<T>(copy) {}
+CppADS::Queue<T>::Queue(const Queue<T>& copy)
+{
+    reserve(copy.m_size);
+    for (size_t i = 0; i < copy.m_size; i++)
+        enqueue(copy.at(i));
+}
 
 template<typename T>
-CppADS::Queue<T>::Queue(Queue<T>&& move) : ForwardList<T>(std::move(move)) {}
+CppADS::Queue<T>::Queue(Queue<T>&& move)
+    : m_data(move.m_data), m_capacity(move.m_capacity), m_head(move.m_head), m_size(move.m_size)
+{
+    move.m_data = nullptr;
+    move.m_capacity = 0;
+    move.m_head = 0;
+    move.m_size = 0;
+}
 
 template<typename T>
-CppADS::Queue<T>::Queue(std::initializer_list<T> init_list) : ForwardList<T>(init_list) {}
+CppADS::Queue<T>::Queue(std::initializer_list<T> init_list)
+{
+    enqueue_bulk(init_list.begin(), init_list.end());
+}
+
+template<typename T>
+CppADS::Queue<T>::~Queue()
+{
+    clear();
+}
 
 template<typename T>
 CppADS::Queue<T>& CppADS::Queue<T>::operator=(const Queue<T>& copy)
 {
-    ForwardList<T>::operator=(copy);
+    if (this == &copy)
+        return *this;
+
+    clear();
+    reserve(copy.m_size);
+    for (size_t i = 0; i < copy.m_size; i++)
+        enqueue(copy.at(i));
     return *this;
 }
 
 template<typename T>
 CppADS::Queue<T>& CppADS::Queue<T>::operator=(Queue<T>&& move)
 {
-    ForwardList<T>::operator=(std::move(move));
+    if (this == &move)
+        return *this;
+
+    clear();
+    m_data = move.m_data;
+    m_capacity = move.m_capacity;
+    m_head = move.m_head;
+    m_size = move.m_size;
+
+    move.m_data = nullptr;
+    move.m_capacity = 0;
+    move.m_head = 0;
+    move.m_size = 0;
     return *this;
 }
 
 template<typename T>
 size_t CppADS::Queue<T>::size() const
 {
-    return ForwardList<T>::size();
+    return m_size;
+}
+
+template<typename T>
+size_t CppADS::Queue<T>::capacity() const
+{
+    return m_capacity;
 }
 
 template<typename T>
 void CppADS::Queue<T>::clear()
 {
-    ForwardList<T>::clear();
+    for (size_t i = 0; i < m_size; i++)
+        at(i).~T();
+    if (m_data != nullptr)
+        std::allocator<T>().deallocate(m_data, m_capacity);
+
+    m_data = nullptr;
+    m_capacity = 0;
+    m_head = 0;
+    m_size = 0;
+}
+
+template<typename T>
+void CppADS::Queue<T>::reserve(size_t count)
+{
+    if (count <= m_capacity)
+        return;
+
+    size_t capacity = calc_capacity(count);
+    relocate(std::allocator<T>().allocate(capacity), capacity);
 }
 
 template<typename T>
 void CppADS::Queue<T>::enqueue(const T& value)
 {
-    ForwardList<T>::push_back(value);
+    emplace(value);
 }
 
 template<typename T>
 void CppADS::Queue<T>::enqueue(T&& value)
 {
-    ForwardList<T>::push_back(std::move(value));
+    emplace(std::move(value));
+}
+
+template<typename T>
+template<typename... Args>
+void CppADS::Queue<T>::emplace(Args&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        // Arguments may refer to elements of this queue, so the new value is
+        // constructed before the old buffer is released
+        size_t capacity = calc_capacity(m_size + 1);
+        T* data = std::allocator<T>().allocate(capacity);
+        try
+        {
+            new (data + m_size) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator<T>().deallocate(data, capacity);
+            throw;
+        }
+        relocate(data, capacity);
+    }
+    else
+    {
+        new (&at(m_size)) T(std::forward<Args>(args)...);
+    }
+    m_size++;
+}
+
+template<typename T>
+template<typename InputIt>
+void CppADS::Queue<T>::enqueue_bulk(InputIt first, InputIt last)
+{
+    reserve_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    for (; first != last; ++first)
+        enqueue(*first);
 }
 
 template<typename T>
 void CppADS::Queue<T>::dequeue()
 {
-    ForwardList<T>::pop_front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Queue<T>::dequeue: container is empty");
+
+    at(0).~T();
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_size--;
+}
+
+template<typename T>
+template<typename OutputIt>
+size_t CppADS::Queue<T>::dequeue_bulk(OutputIt out, size_t count)
+{
+    if (count > m_size)
+        count = m_size;
+
+    for (size_t i = 0; i < count; i++, ++out)
+    {
+        *out = std::move(at(i));
+        at(i).~T();
+    }
+
+    if (count != 0)
+    {
+        m_head = (m_head + count) & (m_capacity - 1);
+        m_size -= count;
+    }
+    return count;
 }
 
 template<typename T>
 typename CppADS::Queue<T>::reference CppADS::Queue<T>::front()
 {
-    return ForwardList<T>::front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Queue<T>::front: container is empty");
+    return at(0);
 }
 
 template<typename T>
 typename CppADS::Queue<T>::const_reference CppADS::Queue<T>::front() const
 {
-    return ForwardList<T>::front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Queue<T>::front: container is empty");
+    return at(0);
+}
+
+template<typename T>
+T& CppADS::Queue<T>::at(size_t index)
+{
+    return m_data[(m_head + index) & (m_capacity - 1)];
+}
+
+template<typename T>
+const T& CppADS::Queue<T>::at(size_t index) const
+{
+    return m_data[(m_head + index) & (m_capacity - 1)];
+}
+
+template<typename T>
+size_t CppADS::Queue<T>::calc_capacity(size_t count) const
+{
+    size_t capacity = (m_capacity == 0) ? 8 : m_capacity;
+    while (capacity < count)
+        capacity <<= 1;
+    return capacity;
+}
+
+template<typename T>
+void CppADS::Queue<T>::relocate(T* data, size_t capacity)
+{
+    for (size_t i = 0; i < m_size; i++)
+    {
+        new (data + i) T(std::move(at(i)));
+        at(i).~T();
+    }
+    if (m_data != nullptr)
+        std::allocator<T>().deallocate(m_data, m_capacity);
+
+    m_data = data;
+    m_capacity = capacity;
+    m_head = 0;
+}
+
+template<typename T>
+template<typename InputIt>
+void CppADS::Queue<T>::reserve_range(InputIt, InputIt, std::input_iterator_tag)
+{}
+
+template<typename T>
+template<typename ForwardIt>
+void CppADS::Queue<T>::reserve_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    reserve(m_size + std::distance(first, last));
 }
 
 #endif //QUEUE_HPP
@@ -0,0 +1,376 @@
+#ifndef READ_MOSTLY_HASH_MAP_HPP
+#define READ_MOSTLY_HASH_MAP_HPP
+
+#include "concurrency.hpp"
+#include "hash_mix.hpp"
+#include "reclamation.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Hash map for concurrent use with rare updates and frequent lookups
+    /// @details Lookups are wait-free: a reader enters an EpochDomain guard (a store and
+    /// a fence), loads the published bucket array and walks one chain, without locks,
+    /// read-modify-write operations or retries. Writers are serialized by a mutex and
+    /// never modify what readers may see, RCU style:
+    /// - insertion publishes a new node at the head of its chain;
+    /// - assignment publishes a copy of the node with the new value in place of the old;
+    /// - removal unlinks the node;
+    /// - growth builds a new bucket array with copies of all nodes and publishes it
+    ///   with a single pointer store.
+    ///
+    /// Replaced nodes and bucket arrays are retired to the epoch domain and destroyed
+    /// when no reader can hold them. Every update allocates, so the map suits data
+    /// which is read much more often than written.
+    /// @tparam Key hashed key type
+    /// @tparam T stored value type, must be copy constructible
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class ReadMostlyHashMap
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<key_type, mapped_type>;
+
+        ReadMostlyHashMap();                            ///< Default constructor
+
+        ReadMostlyHashMap(const ReadMostlyHashMap&) = delete;
+        ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+
+        /// @brief Destructor
+        /// @details No thread may use the map
+        ~ReadMostlyHashMap();
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of items
+        /// @return item's count
+        size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+        /// @return true if map has no items
+        bool empty() const { return size() == 0; }
+
+        /// @brief Get count of buckets of published bucket array
+        /// @return bucket's count
+        size_t bucket_count() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Insert item if its key is missing
+        /// @param value inserted item
+        /// @return true if item was inserted
+        bool insert(const value_type& value);
+
+        /// @brief Insert item or replace value of existing one
+        /// @details Readers see either the old or the new value, never a partially
+        /// assigned one.
+        /// @param key item's key
+        /// @param value new value
+        /// @return true if item was inserted, false if assigned
+        template<typename M>
+        bool insert_or_assign(const key_type& key, M&& value);
+
+        /// @brief Remove item
+        /// @param key item's key
+        /// @return true if item was removed
+        bool remove(const key_type& key);
+
+        /// @brief Remove all items
+        void clear();
+
+        /// @}
+        /// @name Lookup
+        /// @{
+
+        /// @brief Copy value of item, wait-free
+        /// @param key item's key
+        /// @param value destination, unchanged if key is missing
+        /// @return true if item was found
+        bool find(const key_type& key, mapped_type& value) const;
+
+        /// @brief Check if map has item with key, wait-free
+        /// @param key item's key
+        /// @return true if item is found
+        bool contains(const key_type& key) const;
+
+        /// @brief Call function for value of item without copying it, wait-free
+        /// @details The value stays valid while the function runs even if it is replaced
+        /// or removed concurrently.
+        /// @param key item's key
+        /// @param function function called as function(const mapped_type&)
+        /// @return true if item was found
+        template<typename F>
+        bool visit(const key_type& key, F function) const;
+
+        /// @brief Visit all items of published bucket array
+        /// @details Items changed during the pass may be seen either way.
+        /// @param function function called as function(const value_type&)
+        template<typename F>
+        void for_each(F function) const;
+
+        /// @}
+
+    private:
+        /// @private
+        struct Node
+        {
+            value_type value;
+            size_t hash;
+            std::atomic<Node*> next { nullptr };
+
+            template<typename... Args>
+            Node(size_t hash, Args&&... args) : value(std::forward<Args>(args)...), hash(hash) {}
+        };
+
+        /// @private
+        /// @brief Bucket array, owns the nodes linked from it
+        struct Table
+        {
+            size_t bucket_count;
+            std::unique_ptr<std::atomic<Node*>[]> buckets;
+
+            explicit Table(size_t count) : bucket_count(count), buckets(new std::atomic<Node*>[count]()) {}
+            ~Table();
+
+            std::atomic<Node*>& bucket(size_t hash) const
+            {
+                return buckets[MaskReduction::reduce(hash, bucket_count)];
+            }
+        };
+
+        mutable EpochDomain m_domain;
+        std::atomic<Table*> m_table { nullptr };
+        alignas(CacheLineSize) std::mutex m_write_mutex;
+        std::atomic<size_t> m_size { 0 };
+        Hash m_hash {};
+        KeyEqual m_equal {};
+
+        /// @brief Find node of key in the table, nullptr if missing
+        const Node* search(const Table& table, const key_type& key, size_t hash) const;
+
+        /// @brief Find link to node of key or to the end of its chain, writers only
+        std::atomic<Node*>* locate(const Table& table, const key_type& key, size_t hash) const;
+
+        /// @brief Publish node, growing the table if needed, writers only
+        void publish(Table* table, Node* node);
+
+        /// @brief Retire replaced object and let the domain destroy old ones
+        template<typename U>
+        void retire(U* object);
+    };
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::Table::~Table()
+{
+    for (size_t i = 0; i < bucket_count; i++)
+    {
+        Node* node = buckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr)
+        {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::ReadMostlyHashMap()
+{
+    m_table.store(new Table(1), std::memory_order_release);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::~ReadMostlyHashMap()
+{
+    // Retired objects are destroyed by the domain destructor
+    delete m_table.load(std::memory_order_relaxed);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::bucket_count() const
+{
+    EpochDomain::Guard guard(m_domain);
+    return m_table.load(std::memory_order_acquire)->bucket_count;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::insert(const value_type& value)
+{
+    size_t hash = hash_mix(m_hash(value.first));
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if (locate(*table, value.first, hash)->load(std::memory_order_relaxed) != nullptr)
+        return false;
+    publish(table, new Node(hash, value));
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename M>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::insert_or_assign(const key_type& key, M&& value)
+{
+    size_t hash = hash_mix(m_hash(key));
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    std::atomic<Node*>* link = locate(*table, key, hash);
+    Node* old = link->load(std::memory_order_relaxed);
+    if (old == nullptr)
+    {
+        publish(table, new Node(hash, key, std::forward<M>(value)));
+        return true;
+    }
+
+    // Copy takes the place of the old node, readers see one of them
+    Node* node = new Node(hash, key, std::forward<M>(value));
+    node->next.store(old->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    link->store(node, std::memory_order_release);
+    retire(old);
+    return false;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::remove(const key_type& key)
+{
+    size_t hash = hash_mix(m_hash(key));
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    std::atomic<Node*>* link = locate(*table, key, hash);
+    Node* old = link->load(std::memory_order_relaxed);
+    if (old == nullptr)
+        return false;
+
+    link->store(old->next.load(std::memory_order_relaxed), std::memory_order_release);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    retire(old);
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::clear()
+{
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    Table* old = m_table.exchange(new Table(1), std::memory_order_acq_rel);
+    m_size.store(0, std::memory_order_relaxed);
+    retire(old);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::find(const key_type& key, mapped_type& value) const
+{
+    return visit(key, [&value](const mapped_type& found) { value = found; });
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::contains(const key_type& key) const
+{
+    return visit(key, [](const mapped_type&) {});
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F>
+bool CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::visit(const key_type& key, F function) const
+{
+    size_t hash = hash_mix(m_hash(key));
+    EpochDomain::Guard guard(m_domain);
+    const Node* node = search(*m_table.load(std::memory_order_acquire), key, hash);
+    if (node == nullptr)
+        return false;
+    function(node->value.second);
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename F>
+void CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::for_each(F function) const
+{
+    EpochDomain::Guard guard(m_domain);
+    const Table* table = m_table.load(std::memory_order_acquire);
+    for (size_t i = 0; i < table->bucket_count; i++)
+    {
+        for (const Node* node = table->buckets[i].load(std::memory_order_acquire); node != nullptr;
+             node = node->next.load(std::memory_order_acquire))
+            function(static_cast<const value_type&>(node->value));
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const typename CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::Node* CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::search(const Table& table, const key_type& key, size_t hash) const
+{
+    const Node* node = table.bucket(hash).load(std::memory_order_acquire);
+    while (node != nullptr && !(node->hash == hash && m_equal(node->value.first, key)))
+        node = node->next.load(std::memory_order_acquire);
+    return node;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+std::atomic<typename CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::Node*>* CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::locate(const Table& table, const key_type& key, size_t hash) const
+{
+    std::atomic<Node*>* link = &table.bucket(hash);
+    Node* node = link->load(std::memory_order_relaxed);
+    while (node != nullptr && !(node->hash == hash && m_equal(node->value.first, key)))
+    {
+        link = &node->next;
+        node = link->load(std::memory_order_relaxed);
+    }
+    return link;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::publish(Table* table, Node* node)
+{
+    size_t count = m_size.load(std::memory_order_relaxed) + 1;
+    if (count <= table->bucket_count)
+    {
+        // Node is complete before it becomes reachable
+        std::atomic<Node*>& head = table->bucket(node->hash);
+        node->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head.store(node, std::memory_order_release);
+        m_size.store(count, std::memory_order_relaxed);
+        return;
+    }
+
+    // Readers may walk the old chains, so the new array gets copies of the nodes
+    Table* grown = new Table(table->bucket_count * 2);
+    for (size_t i = 0; i < table->bucket_count; i++)
+    {
+        for (Node* item = table->buckets[i].load(std::memory_order_relaxed); item != nullptr;
+             item = item->next.load(std::memory_order_relaxed))
+        {
+            Node* copy = new Node(item->hash, item->value);
+            std::atomic<Node*>& head = grown->bucket(copy->hash);
+            copy->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            head.store(copy, std::memory_order_relaxed);
+        }
+    }
+    std::atomic<Node*>& head = grown->bucket(node->hash);
+    node->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    head.store(node, std::memory_order_relaxed);
+
+    m_table.store(grown, std::memory_order_release);
+    m_size.store(count, std::memory_order_relaxed);
+    retire(table);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+template<typename U>
+void CppADS::ReadMostlyHashMap<Key, T, Hash, KeyEqual>::retire(U* object)
+{
+    // Updates are rare, so old objects are collected on every update instead of
+    // waiting for the domain threshold
+    m_domain.retire(object);
+    m_domain.collect();
+}
+
+#endif //READ_MOSTLY_HASH_MAP_HPP
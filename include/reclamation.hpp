@@ -0,0 +1,542 @@
+#ifndef RECLAMATION_HPP
+#define RECLAMATION_HPP
+
+#include "concurrency.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace CppADS
+{
+    /// @brief Object waiting for reclamation
+    struct RetiredObject
+    {
+        void* pointer { nullptr };
+        void (*deleter)(void*) { nullptr };
+
+        /// @brief Destroy object
+        void reclaim() const {
+            deleter(pointer);
+        }
+    };
+
+    /// @brief Default deleter of retired objects
+    template<typename T>
+    void delete_retired(void* pointer)
+    {
+        delete static_cast<T*>(pointer);
+    }
+
+    /// @brief List of per-thread records shared by domain and threads using it
+    /// @details Every thread gets its own record on the first use of a domain. The record
+    /// is returned to the domain when the thread exits and is reused by another thread.
+    /// Records are freed when both the domain and all threads which used it are gone.
+    /// @tparam Record record type with `std::atomic<bool> in_use` and `Record* next` members
+    template<typename Record>
+    class RecordRegistry
+    {
+    public:
+        RecordRegistry() : m_state(std::make_shared<State>()) {}
+
+        RecordRegistry(const RecordRegistry&) = delete;
+        RecordRegistry& operator=(const RecordRegistry&) = delete;
+
+        ~RecordRegistry()
+        {
+            m_state->alive.store(false, std::memory_order_release);
+        }
+
+        /// @brief Get record of calling thread
+        Record& local()
+        {
+            ThreadCache& cache = thread_cache();
+            if (cache.last_state == m_state.get())
+                return *cache.last_record;
+
+            for (auto& entry : cache.entries)
+            {
+                if (entry.state == m_state)
+                {
+                    cache.last_state = m_state.get();
+                    cache.last_record = entry.record;
+                    return *entry.record;
+                }
+            }
+
+            // Entries of destroyed domains are dropped here
+            cache.entries.erase(std::remove_if(cache.entries.begin(), cache.entries.end(), [](const Entry& entry) {
+                return !entry.state->alive.load(std::memory_order_acquire);
+            }), cache.entries.end());
+
+            Record* record = acquire();
+            cache.entries.push_back(Entry { m_state, record });
+            cache.last_state = m_state.get();
+            cache.last_record = record;
+            return *record;
+        }
+
+        /// @brief Get the first record, records are linked by their `next` members
+        Record* head() const
+        {
+            return m_state->head.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct State
+        {
+            std::atomic<Record*> head { nullptr };
+            std::atomic<bool> alive { true };
+
+            ~State()
+            {
+                Record* record = head.load(std::memory_order_relaxed);
+                while (record != nullptr)
+                {
+                    Record* next = record->next;
+                    delete record;
+                    record = next;
+                }
+            }
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<State> state;
+            Record* record;
+        };
+
+        struct ThreadCache
+        {
+            std::vector<Entry> entries;
+            State* last_state { nullptr };
+            Record* last_record { nullptr };
+
+            ~ThreadCache()
+            {
+                for (auto& entry : entries)
+                    entry.record->in_use.store(false, std::memory_order_release);
+            }
+        };
+
+        std::shared_ptr<State> m_state;
+
+        static ThreadCache& thread_cache()
+        {
+            static thread_local ThreadCache cache;
+            return cache;
+        }
+
+        Record* acquire()
+        {
+            for (Record* record = head(); record != nullptr; record = record->next)
+            {
+                bool in_use = false;
+                if (!record->in_use.load(std::memory_order_relaxed) &&
+                    record->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                    return record;
+            }
+
+            Record* record = new Record();
+            record->in_use.store(true, std::memory_order_relaxed);
+            record->next = m_state->head.load(std::memory_order_relaxed);
+            while (!m_state->head.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed))
+                ;
+            return record;
+        }
+    };
+
+    /// @brief Epoch-based memory reclamation
+    /// @details Readers access shared objects inside a Guard which publishes the global epoch
+    /// observed on entry. Removed objects are retired into per-thread lists tagged with the
+    /// current epoch. Global epoch advances only when every thread inside a guard has seen
+    /// it, so objects retired in epoch e are unreachable for all readers once the epoch
+    /// is e + 2 and are destroyed then.
+    ///
+    /// Guards are cheap (a store and a fence), but a thread stalled inside a guard blocks
+    /// reclamation for everybody. Use HazardDomain when memory must stay bounded.
+    class EpochDomain
+    {
+    public:
+        class Guard;
+
+        /// @brief Constructor
+        /// @param threshold count of retired objects per thread which triggers collection
+        explicit EpochDomain(size_t threshold = 64) : m_threshold(threshold) {}
+
+        EpochDomain(const EpochDomain&) = delete;
+        EpochDomain& operator=(const EpochDomain&) = delete;
+
+        /// @brief Destructor, destroys all retired objects
+        /// @details No thread may be inside a guard of the domain
+        ~EpochDomain();
+
+        /// @brief Schedule destruction of object removed from shared structure
+        /// @param pointer removed object
+        /// @param deleter function destroying object
+        void retire(void* pointer, void (*deleter)(void*));
+
+        /// @brief Schedule deletion of object removed from shared structure
+        /// @param pointer removed object
+        template<typename T>
+        void retire(T* pointer)
+        {
+            retire(pointer, &delete_retired<T>);
+        }
+
+        /// @brief Try to advance epoch and destroy objects retired by calling thread
+        void collect();
+
+        /// @brief Get count of retired objects which aren't destroyed yet
+        /// @return approximate count for all threads
+        size_t pending() const;
+
+    private:
+        /// @private
+        struct Record
+        {
+            std::atomic<uint64_t> epoch { 0 };          ///< Observed epoch, 0 outside guards
+            size_t nesting { 0 };                       ///< Depth of nested guards
+            std::vector<RetiredObject> retired[3];      ///< Retired objects by epoch modulo 3
+            uint64_t retired_epoch[3] { 0, 0, 0 };      ///< Epoch of objects in each list
+            std::atomic<size_t> retired_count { 0 };
+            std::atomic<bool> in_use { false };
+            Record* next { nullptr };
+        };
+
+        alignas(CacheLineSize) std::atomic<uint64_t> m_epoch { 1 };    ///< Global epoch
+        size_t m_threshold;
+        RecordRegistry<Record> m_records;
+
+        /// @private
+        /// @brief Advance global epoch if all active threads have observed it
+        bool try_advance(uint64_t epoch);
+
+        /// @private
+        /// @brief Destroy objects of record which are safe for the observed epoch
+        void reclaim(Record& record, uint64_t epoch);
+
+        /// @private
+        static void reclaim_list(Record& record, size_t list);
+    };
+
+    /// @brief Critical section of EpochDomain
+    /// @details Pointers read from shared structure inside a guard stay valid until the
+    /// guard is destroyed. Guards may be nested.
+    class EpochDomain::Guard
+    {
+    public:
+        explicit Guard(EpochDomain& domain);
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard();
+
+    private:
+        Record& m_record;
+    };
+
+    /// @brief Hazard pointer memory reclamation
+    /// @details Before dereferencing a shared pointer the reader publishes it in a hazard slot
+    /// of its thread and checks that the pointer is still current. Retired objects are
+    /// destroyed by a scan of all hazard slots when a thread accumulates enough of them,
+    /// so the count of not destroyed objects is bounded regardless of stalled readers.
+    class HazardDomain
+    {
+    public:
+        class Guard;
+
+        /// @brief Count of hazard slots in a thread
+        static constexpr size_t SlotsPerThread = 8;
+
+        /// @brief Constructor
+        /// @param threshold minimum count of retired objects per thread which triggers scan
+        explicit HazardDomain(size_t threshold = 64) : m_threshold(threshold) {}
+
+        HazardDomain(const HazardDomain&) = delete;
+        HazardDomain& operator=(const HazardDomain&) = delete;
+
+        /// @brief Destructor, destroys all retired objects
+        /// @details No thread may hold a guard of the domain
+        ~HazardDomain();
+
+        /// @brief Schedule destruction of object removed from shared structure
+        /// @param pointer removed object
+        /// @param deleter function destroying object
+        void retire(void* pointer, void (*deleter)(void*));
+
+        /// @brief Schedule deletion of object removed from shared structure
+        /// @param pointer removed object
+        template<typename T>
+        void retire(T* pointer)
+        {
+            retire(pointer, &delete_retired<T>);
+        }
+
+        /// @brief Destroy objects retired by calling thread which aren't protected
+        void collect();
+
+        /// @brief Get count of retired objects which aren't destroyed yet
+        /// @return approximate count for all threads
+        size_t pending() const;
+
+    private:
+        /// @private
+        struct Record
+        {
+            std::atomic<void*> hazards[SlotsPerThread] {};
+            unsigned used_slots { 0 };                  ///< Bit mask of slots given to guards
+            std::vector<RetiredObject> retired;
+            std::atomic<size_t> retired_count { 0 };
+            std::atomic<bool> in_use { false };
+            Record* next { nullptr };
+        };
+
+        size_t m_threshold;
+        RecordRegistry<Record> m_records;
+    };
+
+    /// @brief Hazard slot of calling thread
+    /// @details Object published by protect() isn't destroyed until the guard is reset,
+    /// protects another pointer or is destroyed.
+    class HazardDomain::Guard
+    {
+    public:
+        explicit Guard(HazardDomain& domain);
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        ~Guard();
+
+        /// @brief Read and protect pointer
+        /// @param source shared pointer
+        /// @return protected value of source
+        template<typename T>
+        T* protect(const std::atomic<T*>& source)
+        {
+            T* pointer = source.load(std::memory_order_relaxed);
+            while (true)
+            {
+                m_slot.store(pointer, std::memory_order_seq_cst);
+                T* current = source.load(std::memory_order_seq_cst);
+                if (current == pointer)
+                    return pointer;
+                pointer = current;
+            }
+        }
+
+        /// @brief Stop protecting object
+        void reset()
+        {
+            m_slot.store(nullptr, std::memory_order_release);
+        }
+
+    private:
+        Record& m_record;
+        unsigned m_index;
+        std::atomic<void*>& m_slot;
+
+        /// @private
+        /// @brief Find free hazard slot of thread and mark it used
+        static unsigned take_slot(Record& record);
+    };
+}
+
+constexpr size_t CppADS::HazardDomain::SlotsPerThread;
+
+inline CppADS::EpochDomain::~EpochDomain()
+{
+    for (Record* record = m_records.head(); record != nullptr; record = record->next)
+    {
+        for (size_t list = 0; list < 3; list++)
+            reclaim_list(*record, list);
+    }
+}
+
+inline void CppADS::EpochDomain::retire(void* pointer, void (*deleter)(void*))
+{
+    Record& record = m_records.local();
+
+    // Object is unlinked before this fence, so a reader which still sees it
+    // has published its epoch before the epoch is read here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+    size_t list = epoch % 3;
+
+    // List of the same residue holds objects of epoch - 3 or older, which are safe
+    if (record.retired_epoch[list] != epoch)
+    {
+        reclaim_list(record, list);
+        record.retired_epoch[list] = epoch;
+    }
+    record.retired[list].push_back(RetiredObject { pointer, deleter });
+    size_t count = record.retired_count.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    if (count >= m_threshold)
+        collect();
+}
+
+inline void CppADS::EpochDomain::collect()
+{
+    Record& record = m_records.local();
+    uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+    if (try_advance(epoch))
+        epoch++;
+    reclaim(record, epoch);
+}
+
+inline size_t CppADS::EpochDomain::pending() const
+{
+    size_t count = 0;
+    for (Record* record = m_records.head(); record != nullptr; record = record->next)
+        count += record->retired_count.load(std::memory_order_relaxed);
+    return count;
+}
+
+inline bool CppADS::EpochDomain::try_advance(uint64_t epoch)
+{
+    for (Record* record = m_records.head(); record != nullptr; record = record->next)
+    {
+        uint64_t observed = record->epoch.load(std::memory_order_seq_cst);
+        if (observed != 0 && observed != epoch)
+            return false;
+    }
+    return m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+}
+
+inline void CppADS::EpochDomain::reclaim(Record& record, uint64_t epoch)
+{
+    for (size_t list = 0; list < 3; list++)
+    {
+        if (!record.retired[list].empty() && record.retired_epoch[list] + 2 <= epoch)
+            reclaim_list(record, list);
+    }
+}
+
+inline void CppADS::EpochDomain::reclaim_list(Record& record, size_t list)
+{
+    std::vector<RetiredObject> objects;
+    objects.swap(record.retired[list]);
+    record.retired_count.fetch_sub(objects.size(), std::memory_order_relaxed);
+    for (const RetiredObject& object : objects)
+        object.reclaim();
+
+    // Keep allocated storage for the next objects
+    objects.clear();
+    if (record.retired[list].empty())
+        record.retired[list].swap(objects);
+}
+
+inline CppADS::EpochDomain::Guard::Guard(EpochDomain& domain)
+    : m_record(domain.m_records.local())
+{
+    if (m_record.nesting++ == 0)
+    {
+        m_record.epoch.store(domain.m_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline CppADS::EpochDomain::Guard::~Guard()
+{
+    if (--m_record.nesting == 0)
+        m_record.epoch.store(0, std::memory_order_release);
+}
+
+inline CppADS::HazardDomain::~HazardDomain()
+{
+    for (Record* record = m_records.head(); record != nullptr; record = record->next)
+    {
+        for (const RetiredObject& object : record->retired)
+            object.reclaim();
+        record->retired.clear();
+        record->retired_count.store(0, std::memory_order_relaxed);
+    }
+}
+
+inline void CppADS::HazardDomain::retire(void* pointer, void (*deleter)(void*))
+{
+    Record& record = m_records.local();
+    record.retired.push_back(RetiredObject { pointer, deleter });
+    record.retired_count.store(record.retired.size(), std::memory_order_relaxed);
+
+    // Scan costs O(threads * slots), so it is amortized over proportional count of objects
+    size_t threads = 0;
+    for (Record* item = m_records.head(); item != nullptr; item = item->next)
+        threads++;
+    if (record.retired.size() >= std::max(m_threshold, 2 * threads * SlotsPerThread))
+        collect();
+}
+
+inline void CppADS::HazardDomain::collect()
+{
+    Record& record = m_records.local();
+    if (record.retired.empty())
+        return;
+
+    // Pairs with the seq_cst store in Guard::protect(): either the reader sees
+    // the object unlinked and retries, or the scan sees its hazard
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::vector<void*> hazards;
+    for (Record* item = m_records.head(); item != nullptr; item = item->next)
+    {
+        for (size_t slot = 0; slot < SlotsPerThread; slot++)
+        {
+            void* hazard = item->hazards[slot].load(std::memory_order_seq_cst);
+            if (hazard != nullptr)
+                hazards.push_back(hazard);
+        }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::vector<RetiredObject> kept;
+    std::vector<RetiredObject> objects;
+    objects.swap(record.retired);
+    for (const RetiredObject& object : objects)
+    {
+        if (std::binary_search(hazards.begin(), hazards.end(), object.pointer))
+            kept.push_back(object);
+        else
+            object.reclaim();
+    }
+    record.retired.swap(kept);
+    record.retired_count.store(record.retired.size(), std::memory_order_relaxed);
+}
+
+inline size_t CppADS::HazardDomain::pending() const
+{
+    size_t count = 0;
+    for (Record* record = m_records.head(); record != nullptr; record = record->next)
+        count += record->retired_count.load(std::memory_order_relaxed);
+    return count;
+}
+
+inline CppADS::HazardDomain::Guard::Guard(HazardDomain& domain)
+    : m_record(domain.m_records.local()), m_index(take_slot(m_record)), m_slot(m_record.hazards[m_index])
+{
+}
+
+inline unsigned CppADS::HazardDomain::Guard::take_slot(Record& record)
+{
+    unsigned index = 0;
+    while (index < SlotsPerThread && (record.used_slots & (1u << index)) != 0)
+        index++;
+    if (index == SlotsPerThread)
+        throw std::length_error("CppADS::HazardDomain::Guard::Guard: all hazard slots of thread are used");
+
+    record.used_slots |= 1u << index;
+    return index;
+}
+
+inline CppADS::HazardDomain::Guard::~Guard()
+{
+    m_slot.store(nullptr, std::memory_order_release);
+    m_record.used_slots &= ~(1u << m_index);
+}
+
+#endif //RECLAMATION_HPP
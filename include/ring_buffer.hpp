@@ -0,0 +1,577 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include "container.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace CppADS
+{
+    /// @brief Behaviour of bounded container on insertion into full container
+    enum class OverflowPolicy
+    {
+        Reject,     ///< New value is rejected
+        Overwrite   ///< Value on the opposite end is overwritten
+    };
+
+    /// @brief Fixed-capacity circular buffer
+    /// @details Storage is allocated once at construction with power of two size, so
+    /// positions are wrapped by masking and no operation allocates afterwards.
+    /// Can be used both as FIFO (push_back/pop_front) and LIFO (push_back/pop_back).
+    /// @tparam T value type stored in the container
+    /// @tparam Policy behaviour on insertion into full buffer
+    template<typename T, OverflowPolicy Policy = OverflowPolicy::Reject>
+    class RingBuffer : public IContainer
+    {
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+
+        /// @brief Constructor
+        /// @param capacity maximum count of elements
+        explicit RingBuffer(size_t capacity);
+        RingBuffer(const RingBuffer& copy);                 ///< Copy constructor
+        RingBuffer(RingBuffer&& move);                      ///< Move constructor
+
+        RingBuffer& operator=(const RingBuffer& copy);      ///< Copy assignment operator
+        RingBuffer& operator=(RingBuffer&& move);           ///< Move assignment operator
+
+        ~RingBuffer() = default;                            ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get maximum count of elements
+        /// @return capacity passed to constructor
+        size_t capacity() const;
+
+        /// @return true if container has no elements
+        bool empty() const;
+
+        /// @return true if count of elements reached capacity
+        bool full() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert value to the end
+        /// @param value inserted value
+        /// @return false if buffer is full and value was rejected
+        bool push_back(const T& value);
+        /// @brief Insert value to the end
+        /// @param value inserted value
+        /// @return false if buffer is full and value was rejected
+        bool push_back(T&& value);
+
+        /// @brief Insert value to the beginning
+        /// @param value inserted value
+        /// @return false if buffer is full and value was rejected
+        bool push_front(const T& value);
+        /// @brief Insert value to the beginning
+        /// @param value inserted value
+        /// @return false if buffer is full and value was rejected
+        bool push_front(T&& value);
+
+        /// @brief Remove first element
+        void pop_front();
+
+        /// @brief Remove last element
+        void pop_back();
+
+        /// @brief Copy values to the end using at most two contiguous copies
+        /// @param values pointer to the first value
+        /// @param count count of values
+        /// @return count of values inserted (all of them for OverflowPolicy::Overwrite)
+        size_t push_n(const T* values, size_t count);
+
+        /// @brief Move values from the beginning using at most two contiguous moves
+        /// @param values pointer to destination
+        /// @param count maximum count of values
+        /// @return count of values removed
+        size_t pop_n(T* values, size_t count);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Access to item
+        /// @param index item position counting from the first element
+        /// @return reference to value
+        reference operator[](size_t index);
+
+        /// @brief Access to item
+        /// @param index item position counting from the first element
+        /// @return const reference to value
+        const_reference operator[](size_t index) const;
+
+        /// @brief Access to the first element
+        /// @return reference to the first element
+        reference front();
+        /// @brief Access to the first element
+        /// @return const reference to the first element
+        const_reference front() const;
+
+        /// @brief Access to the last element
+        /// @return reference to the last element
+        reference back();
+        /// @brief Access to the last element
+        /// @return const reference to the last element
+        const_reference back() const;
+
+        /// @}
+
+    protected:
+        /// @brief Constructor over external storage
+        /// @param storage pointer to storage of power of two size
+        /// @param capacity size of storage
+        RingBuffer(T* storage, size_t capacity);
+
+        /// @brief Replace content with copies of values from other buffer
+        /// @param copy source buffer
+        void copy_from(const RingBuffer& copy);
+
+    private:
+        std::unique_ptr<T[]> m_storage { nullptr };     ///< Owned storage (empty for external storage)
+        T* m_data { nullptr };                          ///< Pointer to storage
+        size_t m_mask { 0 };                            ///< Storage size minus one
+        size_t m_capacity { 0 };                        ///< Maximum count of elements
+        size_t m_head { 0 };                            ///< Storage position of the first element
+        size_t m_size { 0 };                            ///< Count of elements
+
+        inline T& at(size_t index);
+        inline const T& at(size_t index) const;
+
+        /// @private
+        /// @brief Make room for new value at the end
+        /// @return false if value must be rejected
+        bool reserve_back();
+        /// @private
+        /// @brief Make room for new value at the beginning
+        /// @return false if value must be rejected
+        bool reserve_front();
+    };
+
+    /// @brief Fixed-capacity circular buffer with inline storage
+    /// @details RingBuffer is a private base: its move operations take the storage
+    /// pointer, which must never point into inline storage of another buffer.
+    /// @tparam T value type stored in the container
+    /// @tparam N capacity (power of two)
+    /// @tparam Policy behaviour on insertion into full buffer
+    template<typename T, size_t N, OverflowPolicy Policy = OverflowPolicy::Reject>
+    class StaticRingBuffer : private RingBuffer<T, Policy>
+    {
+        static_assert(N != 0 && (N & (N - 1)) == 0, "StaticRingBuffer capacity must be power of two");
+
+        using Base = RingBuffer<T, Policy>;
+
+    public:
+        using typename Base::value_type;
+        using typename Base::reference;
+        using typename Base::const_reference;
+        using typename Base::pointer;
+        using typename Base::const_pointer;
+
+        using Base::size;
+        using Base::capacity;
+        using Base::empty;
+        using Base::full;
+        using Base::clear;
+        using Base::push_back;
+        using Base::push_front;
+        using Base::pop_front;
+        using Base::pop_back;
+        using Base::push_n;
+        using Base::pop_n;
+        using Base::operator[];
+        using Base::front;
+        using Base::back;
+
+        StaticRingBuffer();                                         ///< Default constructor
+        StaticRingBuffer(const StaticRingBuffer& copy);             ///< Copy constructor
+
+        StaticRingBuffer& operator=(const StaticRingBuffer& copy);  ///< Copy assignment operator
+
+        ~StaticRingBuffer() = default;                              ///< Destructor
+
+    private:
+        T m_inline_storage[N];
+    };
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>::RingBuffer(size_t capacity)
+    : m_capacity(capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("CppADS::RingBuffer<T>::RingBuffer: capacity must be positive");
+
+    size_t storage_size = 1;
+    while (storage_size < capacity)
+        storage_size <<= 1;
+
+    m_storage = std::make_unique<T[]>(storage_size);
+    m_data = m_storage.get();
+    m_mask = storage_size - 1;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>::RingBuffer(T* storage, size_t capacity)
+    : m_data(storage), m_mask(capacity - 1), m_capacity(capacity)
+{}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>::RingBuffer(const RingBuffer& copy)
+{
+    // Moved-from buffer has no storage, its copy stays empty too
+    if (copy.m_capacity == 0)
+        return;
+
+    *this = RingBuffer(copy.m_capacity);
+    copy_from(copy);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>::RingBuffer(RingBuffer&& move)
+    : m_storage(std::move(move.m_storage)), m_data(move.m_data), m_mask(move.m_mask),
+      m_capacity(move.m_capacity), m_head(move.m_head), m_size(move.m_size)
+{
+    move.m_data = nullptr;
+    move.m_mask = 0;
+    move.m_capacity = 0;
+    move.m_head = 0;
+    move.m_size = 0;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>& CppADS::RingBuffer<T, Policy>::operator=(const RingBuffer& copy)
+{
+    if (this == &copy)
+        return *this;
+
+    if (copy.m_capacity == 0 || m_storage == nullptr || m_mask < copy.m_capacity - 1)
+    {
+        RingBuffer tmp(copy);
+        *this = std::move(tmp);
+        return *this;
+    }
+
+    m_capacity = copy.m_capacity;
+    copy_from(copy);
+    return *this;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+CppADS::RingBuffer<T, Policy>& CppADS::RingBuffer<T, Policy>::operator=(RingBuffer&& move)
+{
+    m_storage = std::move(move.m_storage);
+    m_data = move.m_data;
+    m_mask = move.m_mask;
+    m_capacity = move.m_capacity;
+    m_head = move.m_head;
+    m_size = move.m_size;
+
+    move.m_data = nullptr;
+    move.m_mask = 0;
+    move.m_capacity = 0;
+    move.m_head = 0;
+    move.m_size = 0;
+    return *this;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+void CppADS::RingBuffer<T, Policy>::copy_from(const RingBuffer& copy)
+{
+    clear();
+    for (size_t i = 0; i < copy.m_size; i++)
+        m_data[i] = copy.at(i);
+    m_size = copy.m_size;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+size_t CppADS::RingBuffer<T, Policy>::size() const
+{
+    return m_size;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+size_t CppADS::RingBuffer<T, Policy>::capacity() const
+{
+    return m_capacity;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::empty() const
+{
+    return m_size == 0;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::full() const
+{
+    return m_size == m_capacity;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+void CppADS::RingBuffer<T, Policy>::clear()
+{
+    while (m_size != 0)
+        pop_back();
+    m_head = 0;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::push_back(const T& value)
+{
+    // Value may refer to the element overwritten in full buffer, so it's copied first
+    if (Policy == OverflowPolicy::Overwrite && m_size == m_capacity && m_capacity != 0)
+        return push_back(T(value));
+    if (!reserve_back())
+        return false;
+    at(m_size - 1) = value;
+    return true;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::push_back(T&& value)
+{
+    if (Policy == OverflowPolicy::Overwrite && m_size == m_capacity && m_capacity != 0)
+    {
+        T tmp(std::move(value));
+        reserve_back();
+        at(m_size - 1) = std::move(tmp);
+        return true;
+    }
+    if (!reserve_back())
+        return false;
+    at(m_size - 1) = std::move(value);
+    return true;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::push_front(const T& value)
+{
+    if (Policy == OverflowPolicy::Overwrite && m_size == m_capacity && m_capacity != 0)
+        return push_front(T(value));
+    if (!reserve_front())
+        return false;
+    at(0) = value;
+    return true;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::push_front(T&& value)
+{
+    if (Policy == OverflowPolicy::Overwrite && m_size == m_capacity && m_capacity != 0)
+    {
+        T tmp(std::move(value));
+        reserve_front();
+        at(0) = std::move(tmp);
+        return true;
+    }
+    if (!reserve_front())
+        return false;
+    at(0) = std::move(value);
+    return true;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+void CppADS::RingBuffer<T, Policy>::pop_front()
+{
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::RingBuffer<T>::pop_front: container is empty");
+
+    at(0) = T();
+    m_head = (m_head + 1) & m_mask;
+    m_size--;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+void CppADS::RingBuffer<T, Policy>::pop_back()
+{
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::RingBuffer<T>::pop_back: container is empty");
+
+    m_size--;
+    at(m_size) = T();
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+size_t CppADS::RingBuffer<T, Policy>::push_n(const T* values, size_t count)
+{
+    // Moved-from buffer has no storage
+    if (m_capacity == 0)
+        return 0;
+
+    size_t accepted = count;
+    if (Policy == OverflowPolicy::Overwrite)
+    {
+        // Values which would be overwritten by the same call aren't copied at all
+        if (count > m_capacity)
+        {
+            values += count - m_capacity;
+            count = m_capacity;
+        }
+        size_t overflow = (m_size + count > m_capacity) ? m_size + count - m_capacity : 0;
+        // Dropped slots are reused by new values only if storage size equals capacity
+        if (m_mask + 1 != m_capacity)
+        {
+            for (size_t i = 0; i < overflow; i++)
+                at(i) = T();
+        }
+        m_head = (m_head + overflow) & m_mask;
+        m_size -= overflow;
+    }
+    else
+    {
+        count = std::min(count, m_capacity - m_size);
+        accepted = count;
+    }
+
+    size_t tail = (m_head + m_size) & m_mask;
+    size_t first = std::min(count, m_mask + 1 - tail);
+    std::copy(values, values + first, m_data + tail);
+    std::copy(values + first, values + count, m_data);
+    m_size += count;
+
+    return accepted;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+size_t CppADS::RingBuffer<T, Policy>::pop_n(T* values, size_t count)
+{
+    count = std::min(count, m_size);
+
+    size_t first = std::min(count, m_mask + 1 - m_head);
+    std::move(m_data + m_head, m_data + m_head + first, values);
+    std::move(m_data, m_data + (count - first), values + first);
+    // Release resources of moved-from values like pop_front does
+    std::fill(m_data + m_head, m_data + m_head + first, T());
+    std::fill(m_data, m_data + (count - first), T());
+
+    m_head = (m_head + count) & m_mask;
+    m_size -= count;
+    return count;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::reference CppADS::RingBuffer<T, Policy>::operator[](size_t index)
+{
+    if (index >= m_size)
+        throw std::out_of_range("CppADS::RingBuffer<T>::operator[]: index is out of range");
+    return at(index);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::const_reference CppADS::RingBuffer<T, Policy>::operator[](size_t index) const
+{
+    if (index >= m_size)
+        throw std::out_of_range("CppADS::RingBuffer<T>::operator[]: index is out of range");
+    return at(index);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::reference CppADS::RingBuffer<T, Policy>::front()
+{
+    return operator[](0);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::const_reference CppADS::RingBuffer<T, Policy>::front() const
+{
+    return operator[](0);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::reference CppADS::RingBuffer<T, Policy>::back()
+{
+    return operator[](m_size - 1);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+typename CppADS::RingBuffer<T, Policy>::const_reference CppADS::RingBuffer<T, Policy>::back() const
+{
+    return operator[](m_size - 1);
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+T& CppADS::RingBuffer<T, Policy>::at(size_t index)
+{
+    return m_data[(m_head + index) & m_mask];
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+const T& CppADS::RingBuffer<T, Policy>::at(size_t index) const
+{
+    return m_data[(m_head + index) & m_mask];
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::reserve_back()
+{
+    // Moved-from buffer has no storage to overwrite
+    if (m_capacity == 0)
+        return false;
+    if (m_size == m_capacity)
+    {
+        if (Policy == OverflowPolicy::Reject)
+            return false;
+        at(0) = T();
+        m_head = (m_head + 1) & m_mask;
+        m_size--;
+    }
+    m_size++;
+    return true;
+}
+
+template<typename T, CppADS::OverflowPolicy Policy>
+bool CppADS::RingBuffer<T, Policy>::reserve_front()
+{
+    // Moved-from buffer has no storage to overwrite
+    if (m_capacity == 0)
+        return false;
+    if (m_size == m_capacity)
+    {
+        if (Policy == OverflowPolicy::Reject)
+            return false;
+        m_size--;
+        at(m_size) = T();
+    }
+    m_head = (m_head - 1) & m_mask;
+    m_size++;
+    return true;
+}
+
+template<typename T, size_t N, CppADS::OverflowPolicy Policy>
+CppADS::StaticRingBuffer<T, N, Policy>::StaticRingBuffer()
+    : RingBuffer<T, Policy>(m_inline_storage, N)
+{}
+
+template<typename T, size_t N, CppADS::OverflowPolicy Policy>
+CppADS::StaticRingBuffer<T, N, Policy>::StaticRingBuffer(const StaticRingBuffer& copy)
+    : RingBuffer<T, Policy>(m_inline_storage, N)
+{
+    this->copy_from(copy);
+}
+
+template<typename T, size_t N, CppADS::OverflowPolicy Policy>
+CppADS::StaticRingBuffer<T, N, Policy>& CppADS::StaticRingBuffer<T, N, Policy>::operator=(const StaticRingBuffer& copy)
+{
+    if (this != &copy)
+        this->copy_from(copy);
+    return *this;
+}
+
+#endif //RING_BUFFER_HPP
@@ -0,0 +1,617 @@
+#ifndef ROBIN_HOOD_HASH_TABLE_HPP
+#define ROBIN_HOOD_HASH_TABLE_HPP
+
+#include "container.hpp"
+#include "array.hpp"
+#include "hash_mix.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility>
+
+namespace CppADS
+{
+    /// @brief Open-addressing hash table with Robin Hood linear probing
+    /// @details Entries are stored inline in one flat Array of slots together with their
+    /// probe sequence length (distance from the home slot). An inserted entry takes the
+    /// slot of a resident which is closer to its home ("takes from the rich"), so probe
+    /// lengths stay short and even, and a lookup stops as soon as it meets an entry closer
+    /// to home than the searched key would be. Removal shifts the following entries of
+    /// the cluster one slot back, so there are no tombstones.
+    ///
+    /// Slot count is a power of two. Iterators and references are invalidated by insertion
+    /// and removal.
+    /// @tparam Key hashed key type
+    /// @tparam T stored value type
+    /// @tparam Hash hash function of keys
+    /// @tparam KeyEqual equality of keys
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class RobinHoodHashTable : public IContainer
+    {
+        struct Slot;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<key_type, mapped_type>;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        class iterator;
+        class const_iterator;
+
+        RobinHoodHashTable() = default;                                             ///< Default contructor
+        RobinHoodHashTable(const RobinHoodHashTable& copy) = default;               ///< Copy contructor
+        RobinHoodHashTable(RobinHoodHashTable&& move);                              ///< Move contructor
+        RobinHoodHashTable(std::initializer_list<value_type> init_list);            ///< Contructor from initializer list
+
+        RobinHoodHashTable& operator=(const RobinHoodHashTable& copy) = default;    ///< Copy assignment operator
+        RobinHoodHashTable& operator=(RobinHoodHashTable&& move);                   ///< Move assignment operator
+
+        ~RobinHoodHashTable() = default;                                            ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get size of container
+        /// @return element's count
+        size_t size() const override;
+
+        /// @brief Get current number of slots
+        /// @return number of slots
+        size_t bucket_count() const;
+
+        /// @brief Get maximum ratio of elements to slots
+        /// @return maximum load factor
+        float max_load_factor() const;
+
+        /// @brief Get current ratio of elements to slots
+        /// @return load factor
+        float load_factor() const;
+
+        /// @}
+        /// @name Hash policy
+        /// @{
+
+        /// @brief Set maximum ratio of elements to slots
+        /// @param load_factor new maximum load factor in (0, 1)
+        void set_load_factor(float load_factor);
+
+        /// @brief Reserve slots for specific count of elements
+        /// @param count count of elements which fit without rehashing
+        void reserve(size_t count);
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Remove all data from container
+        void clear() override;
+
+        /// @brief Insert value to container, existing value of the key is replaced
+        /// @param pair key-value pair to insert
+        void insert(const value_type& pair);
+        /// @brief Insert value to container, existing value of the key is replaced
+        /// @param pair key-value pair to insert
+        void insert(value_type&& pair);
+
+        /// @brief Remove value from container
+        /// @param key key of item to delete
+        /// @return true if item was removed
+        bool remove(const key_type& key);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @brief Access to item, missing item is default constructed
+        /// @param key item key
+        /// @return reference to value
+        mapped_type& operator[](const key_type& key);
+
+        /// @brief Access to existing item
+        /// @param key item key
+        /// @return reference to value
+        const mapped_type& operator[](const key_type& key) const;
+
+        /// @brief Search for item with key
+        /// @param key key to search for
+        /// @return iterator to found item (end if item not found)
+        iterator find(const key_type& key);
+
+        /// @brief Search for item with key
+        /// @param key key to search for
+        /// @return iterator to found item (end if item not found)
+        const_iterator find(const key_type& key) const;
+
+        /// @}
+        /// @name Iterators
+        /// @{
+
+        /// @return read-write iterator to the first element of the container
+        iterator begin();
+        /// @return read-only iterator to the first element of the container
+        const_iterator begin() const;
+        /// @return read-only iterator to the first element of the container
+        const_iterator cbegin() const;
+
+        /// @return read-write iterator to the element after the last element of the container
+        iterator end();
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator end() const;
+        /// @return read-only iterator to the element after the last element of the container
+        const_iterator cend() const;
+
+        /// @}
+
+        bool operator==(const RobinHoodHashTable& rhs) const;
+        bool operator!=(const RobinHoodHashTable& rhs) const;
+
+    private:
+        static constexpr size_t MinSlots = 16;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        /// @private
+        struct Slot
+        {
+            value_type value {};
+            uint32_t distance { 0 };    ///< Probe sequence length + 1, 0 for empty slot
+        };
+
+        Array<Slot> m_slots;
+        size_t m_size { 0 };
+        size_t m_mask { 0 };
+        size_t m_grow_at { 0 };         ///< Size which triggers growth
+        float m_max_load_factor { 0.875f };
+        Hash m_hash {};
+        KeyEqual m_equal {};
+
+        /// @private
+        Slot* slots();
+        /// @private
+        const Slot* slots() const;
+
+        /// @private
+        size_t home(const key_type& key) const;
+
+        /// @private
+        /// @brief Get index of slot with key
+        /// @return slot index or npos
+        size_t lookup(const key_type& key) const;
+
+        /// @private
+        /// @brief Insert entry or find existing entry of its key
+        /// @return slot index of the entry with the key
+        size_t emplace_slot(value_type&& value, bool assign);
+
+        /// @private
+        /// @brief Move entries to a new array of slots
+        void rehash(size_t slot_count);
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    /// @brief Read-write iterator for RobinHoodHashTable container
+    class RobinHoodHashTable<Key, T, Hash, KeyEqual>::iterator : public std::iterator<std::forward_iterator_tag, value_type>
+    {
+    private:
+        Slot* m_slot { nullptr };
+        Slot* m_end { nullptr };
+        friend class RobinHoodHashTable;
+
+        void skip_empty() {
+            while (m_slot != m_end && m_slot->distance == 0)
+                m_slot++;
+        }
+
+    public:
+        iterator(Slot* slot = nullptr, Slot* end = nullptr) : m_slot(slot), m_end(end) {
+            skip_empty();
+        }
+
+        reference operator*() {
+            return m_slot->value;
+        }
+        pointer operator->() {
+            return &m_slot->value;
+        }
+
+        iterator& operator++() {
+            m_slot++;
+            skip_empty();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator result(*this);
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& rhs) const {
+            return m_slot == rhs.m_slot;
+        }
+        bool operator!=(const iterator& rhs) const {
+            return m_slot != rhs.m_slot;
+        }
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    /// @brief Read-only iterator for RobinHoodHashTable container
+    class RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator : public std::iterator<std::forward_iterator_tag, value_type>
+    {
+    private:
+        const Slot* m_slot { nullptr };
+        const Slot* m_end { nullptr };
+
+        void skip_empty() {
+            while (m_slot != m_end && m_slot->distance == 0)
+                m_slot++;
+        }
+
+    public:
+        const_iterator(const Slot* slot = nullptr, const Slot* end = nullptr) : m_slot(slot), m_end(end) {
+            skip_empty();
+        }
+
+        const_reference operator*() {
+            return m_slot->value;
+        }
+        const_pointer operator->() {
+            return &m_slot->value;
+        }
+
+        const_iterator& operator++() {
+            m_slot++;
+            skip_empty();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator result(*this);
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const const_iterator& rhs) const {
+            return m_slot == rhs.m_slot;
+        }
+        bool operator!=(const const_iterator& rhs) const {
+            return m_slot != rhs.m_slot;
+        }
+    };
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+constexpr size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::npos;
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(RobinHoodHashTable&& move)
+    : m_slots(std::move(move.m_slots)), m_size(move.m_size), m_mask(move.m_mask), m_grow_at(move.m_grow_at),
+      m_max_load_factor(move.m_max_load_factor), m_hash(std::move(move.m_hash)), m_equal(std::move(move.m_equal))
+{
+    move.m_size = 0;
+    move.m_mask = 0;
+    move.m_grow_at = 0;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(std::initializer_list<value_type> init_list)
+{
+    reserve(init_list.size());
+    for (auto it = init_list.begin(); it != init_list.end(); it++)
+        insert(*it);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>& CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator=(RobinHoodHashTable&& move)
+{
+    m_slots = std::move(move.m_slots);
+    m_size = move.m_size;
+    m_mask = move.m_mask;
+    m_grow_at = move.m_grow_at;
+    m_max_load_factor = move.m_max_load_factor;
+    m_hash = std::move(move.m_hash);
+    m_equal = std::move(move.m_equal);
+    move.m_size = 0;
+    move.m_mask = 0;
+    move.m_grow_at = 0;
+    return *this;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::size() const
+{
+    return m_size;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::bucket_count() const
+{
+    return m_slots.size();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+float CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::max_load_factor() const
+{
+    return m_max_load_factor;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+float CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::load_factor() const
+{
+    return bucket_count() == 0 ? 0.0f : static_cast<float>(size()) / bucket_count();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::set_load_factor(float load_factor)
+{
+    if (!(load_factor > 0.0f && load_factor < 1.0f))
+        throw std::invalid_argument("CppADS::RobinHoodHashTable::set_load_factor: load factor must be in (0, 1)");
+
+    m_max_load_factor = load_factor;
+    m_grow_at = static_cast<size_t>(bucket_count() * m_max_load_factor);
+    if (size() > m_grow_at)
+        reserve(size());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::reserve(size_t count)
+{
+    size_t slot_count = MinSlots;
+    while (static_cast<size_t>(slot_count * m_max_load_factor) < count)
+        slot_count *= 2;
+    if (slot_count > bucket_count())
+        rehash(slot_count);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::clear()
+{
+    m_slots.clear();
+    m_size = 0;
+    m_mask = 0;
+    m_grow_at = 0;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::insert(const value_type& pair)
+{
+    emplace_slot(value_type(pair), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::insert(value_type&& pair)
+{
+    emplace_slot(std::move(pair), true);
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::remove(const key_type& key)
+{
+    size_t index = lookup(key);
+    if (index == npos)
+        return false;
+
+    // Backward shift: following entries of the cluster move one slot closer to home
+    Slot* items = slots();
+    size_t next = (index + 1) & m_mask;
+    while (items[next].distance > 1)
+    {
+        items[index].value = std::move(items[next].value);
+        items[index].distance = items[next].distance - 1;
+        index = next;
+        next = (next + 1) & m_mask;
+    }
+    items[index].value = value_type();
+    items[index].distance = 0;
+    m_size--;
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::mapped_type& CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key)
+{
+    size_t index = lookup(key);
+    if (index == npos)
+        index = emplace_slot(value_type(key, T()), false);
+    return slots()[index].value.second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::mapped_type& CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key) const
+{
+    size_t index = lookup(key);
+    if (index == npos)
+        throw std::out_of_range("CppADS::RobinHoodHashTable::operator[]: key not found");
+    return slots()[index].value.second;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key)
+{
+    size_t index = lookup(key);
+    if (index == npos)
+        return end();
+    return iterator(slots() + index, slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+{
+    size_t index = lookup(key);
+    if (index == npos)
+        return cend();
+    return const_iterator(slots() + index, slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::begin()
+{
+    return iterator(slots(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::begin() const
+{
+    return cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::cbegin() const
+{
+    return const_iterator(slots(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::end()
+{
+    return iterator(slots() + bucket_count(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::end() const
+{
+    return cend();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::const_iterator CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::cend() const
+{
+    return const_iterator(slots() + bucket_count(), slots() + bucket_count());
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator==(const RobinHoodHashTable& rhs) const
+{
+    if (size() != rhs.size())
+        return false;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        size_t index = rhs.lookup(it->first);
+        if (index == npos || !(rhs.slots()[index].value.second == it->second))
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+bool CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator!=(const RobinHoodHashTable& rhs) const
+{
+    return !(operator==(rhs));
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::Slot* CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::slots()
+{
+    return bucket_count() == 0 ? nullptr : &*m_slots.begin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+const typename CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::Slot* CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::slots() const
+{
+    return bucket_count() == 0 ? nullptr : &*m_slots.cbegin();
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::home(const key_type& key) const
+{
+    return hash_mix(m_hash(key)) & m_mask;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::lookup(const key_type& key) const
+{
+    if (m_size == 0)
+        return npos;
+
+    const Slot* items = slots();
+    size_t index = home(key);
+    for (uint32_t distance = 1; ; distance++)
+    {
+        // Searched key would have displaced an entry closer to its home
+        if (items[index].distance < distance)
+            return npos;
+        if (items[index].distance == distance && m_equal(items[index].value.first, key))
+            return index;
+        index = (index + 1) & m_mask;
+    }
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+size_t CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::emplace_slot(value_type&& value, bool assign)
+{
+    if (m_size >= m_grow_at)
+    {
+        // Replacing value of existing key doesn't need more space
+        size_t existing = lookup(value.first);
+        if (existing != npos)
+        {
+            if (assign)
+                slots()[existing].value.second = std::move(value.second);
+            return existing;
+        }
+        rehash(bucket_count() == 0 ? MinSlots : bucket_count() * 2);
+    }
+
+    Slot* items = slots();
+    size_t index = home(value.first);
+    uint32_t distance = 1;
+
+    // Until the first displacement the key may already be in the table
+    while (items[index].distance >= distance)
+    {
+        if (items[index].distance == distance && m_equal(items[index].value.first, value.first))
+        {
+            if (assign)
+                items[index].value.second = std::move(value.second);
+            return index;
+        }
+        index = (index + 1) & m_mask;
+        distance++;
+    }
+
+    size_t result = index;
+    m_size++;
+    while (items[index].distance != 0)
+    {
+        std::swap(items[index].value, value);
+        std::swap(items[index].distance, distance);
+        do
+        {
+            index = (index + 1) & m_mask;
+            distance++;
+        }
+        while (items[index].distance >= distance);
+    }
+    items[index].value = std::move(value);
+    items[index].distance = distance;
+    return result;
+}
+
+template<typename Key, typename T, typename Hash, typename KeyEqual>
+void CppADS::RobinHoodHashTable<Key, T, Hash, KeyEqual>::rehash(size_t slot_count)
+{
+    Array<Slot> old(std::move(m_slots));
+    size_t old_count = m_mask == 0 ? 0 : m_mask + 1;
+
+    m_slots = Array<Slot>();
+    m_slots.reserve(slot_count);
+    for (size_t i = 0; i < slot_count; i++)
+        m_slots.push_back(Slot());
+    m_mask = slot_count - 1;
+    m_grow_at = static_cast<size_t>(slot_count * m_max_load_factor);
+    m_size = 0;
+
+    for (size_t i = 0; i < old_count; i++)
+    {
+        if (old[i].distance != 0)
+            emplace_slot(std::move(old[i].value), false);
+    }
+}
+
+#endif //ROBIN_HOOD_HASH_TABLE_HPP
@@ -0,0 +1,263 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include "concurrency.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace CppADS
+{
+    /// @brief Bounded lock-free FIFO queue for single producer and single consumer
+    /// @details Values are stored in a power of two ring buffer allocated at construction.
+    /// Producer owns the tail index and consumer owns the head index; each of them
+    /// publishes its index with release store and reads the opposite one with acquire load.
+    /// The opposite index is cached locally and re-read only when the cached value
+    /// says that the queue is full (for producer) or empty (for consumer), so in the
+    /// steady state the threads don't touch each other's cache lines.
+    ///
+    /// Push methods must be called from one thread and pop methods from one
+    /// (possibly other) thread.
+    /// @tparam T value type stored in the container
+    template<typename T>
+    class SpscQueue
+    {
+    public:
+        using value_type = T;
+
+        /// @brief Constructor
+        /// @param capacity minimum count of elements, rounded up to power of two
+        explicit SpscQueue(size_t capacity);
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        ~SpscQueue() = default;                         ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of elements
+        /// @details Exact only when neither producer nor consumer are running
+        /// @return element's count
+        size_t size() const;
+
+        /// @brief Get maximum count of elements
+        /// @return buffer size
+        size_t capacity() const;
+
+        /// @return true if queue has no elements
+        bool empty() const;
+
+        /// @}
+        /// @name Producer
+        /// @{
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        /// @return false if queue is full
+        bool try_push(const T& value);
+
+        /// @brief Add value to tail of queue
+        /// @param value added value
+        /// @return false if queue is full
+        bool try_push(T&& value);
+
+        /// @brief Construct value in the tail of queue
+        /// @param args arguments of value's constructor
+        /// @return false if queue is full
+        template<typename... Args>
+        bool try_emplace(Args&&... args);
+
+        /// @brief Copy values to tail of queue using at most two contiguous copies
+        /// @details All added values are published at once
+        /// @param values pointer to the first value
+        /// @param count count of values
+        /// @return count of added values
+        size_t try_push_n(const T* values, size_t count);
+
+        /// @}
+        /// @name Consumer
+        /// @{
+
+        /// @brief Move front value out of queue
+        /// @param value destination
+        /// @return false if queue is empty
+        bool try_pop(T& value);
+
+        /// @brief Move front values out of queue using at most two contiguous moves
+        /// @param values pointer to destination
+        /// @param count maximum count of values
+        /// @return count of removed values
+        size_t try_pop_n(T* values, size_t count);
+
+        /// @}
+
+    private:
+        std::unique_ptr<T[]> m_data { nullptr };        ///< Ring buffer
+        size_t m_mask { 0 };                            ///< Buffer size minus one
+
+        alignas(CacheLineSize) std::atomic<size_t> m_head { 0 }; ///< Count of popped values
+        size_t m_cached_tail { 0 };                     ///< Consumer's copy of m_tail
+
+        alignas(CacheLineSize) std::atomic<size_t> m_tail { 0 }; ///< Count of pushed values
+        size_t m_cached_head { 0 };                     ///< Producer's copy of m_head
+
+        /// @private
+        /// @brief Get count of free slots from producer side
+        /// @param tail current tail
+        /// @param required count of slots enough to stop re-reading head
+        size_t free_slots(size_t tail, size_t required);
+
+        /// @private
+        /// @brief Get count of stored values from consumer side
+        /// @param head current head
+        /// @param required count of values enough to stop re-reading tail
+        size_t used_slots(size_t head, size_t required);
+    };
+}
+
+template<typename T>
+CppADS::SpscQueue<T>::SpscQueue(size_t capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("CppADS::SpscQueue<T>::SpscQueue: capacity must be positive");
+
+    size_t storage_size = 1;
+    while (storage_size < capacity)
+        storage_size <<= 1;
+
+    m_data = std::make_unique<T[]>(storage_size);
+    m_mask = storage_size - 1;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::size() const
+{
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    return (tail >= head) ? tail - head : 0;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::capacity() const
+{
+    return m_mask + 1;
+}
+
+template<typename T>
+bool CppADS::SpscQueue<T>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::free_slots(size_t tail, size_t required)
+{
+    size_t free = m_mask + 1 - (tail - m_cached_head);
+    if (free < required)
+    {
+        m_cached_head = m_head.load(std::memory_order_acquire);
+        free = m_mask + 1 - (tail - m_cached_head);
+    }
+    return free;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::used_slots(size_t head, size_t required)
+{
+    size_t used = m_cached_tail - head;
+    if (used < required)
+    {
+        m_cached_tail = m_tail.load(std::memory_order_acquire);
+        used = m_cached_tail - head;
+    }
+    return used;
+}
+
+template<typename T>
+bool CppADS::SpscQueue<T>::try_push(const T& value)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0)
+        return false;
+
+    m_data[tail & m_mask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool CppADS::SpscQueue<T>::try_push(T&& value)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0)
+        return false;
+
+    m_data[tail & m_mask] = std::move(value);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+template<typename... Args>
+bool CppADS::SpscQueue<T>::try_emplace(Args&&... args)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0)
+        return false;
+
+    m_data[tail & m_mask] = T(std::forward<Args>(args)...);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::try_push_n(const T* values, size_t count)
+{
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    count = std::min(count, free_slots(tail, count));
+    if (count == 0)
+        return 0;
+
+    size_t position = tail & m_mask;
+    size_t first = std::min(count, m_mask + 1 - position);
+    std::copy(values, values + first, m_data.get() + position);
+    std::copy(values + first, values + count, m_data.get());
+
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template<typename T>
+bool CppADS::SpscQueue<T>::try_pop(T& value)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (used_slots(head, 1) == 0)
+        return false;
+
+    value = std::move(m_data[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+size_t CppADS::SpscQueue<T>::try_pop_n(T* values, size_t count)
+{
+    size_t head = m_head.load(std::memory_order_relaxed);
+    count = std::min(count, used_slots(head, count));
+    if (count == 0)
+        return 0;
+
+    size_t position = head & m_mask;
+    size_t first = std::min(count, m_mask + 1 - position);
+    std::move(m_data.get() + position, m_data.get() + position + first, values);
+    std::move(m_data.get(), m_data.get() + count - first, values + first);
+
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+#endif //SPSC_QUEUE_HPP
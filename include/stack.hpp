@@ -1,14 +1,22 @@
 #ifndef STACK_H
 #define STACK_H
 
-#include "forward_list.hpp"
+#include "container.hpp"
+
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
 
 namespace CppADS
 {
     /// @brief LIFO data structure class
+    /// @details Values are stored contiguously in a growable buffer, top of the stack is the
+    /// last item. Unused slots of the buffer are uninitialized, so T needn't be default
+    /// constructible.
     /// @tparam T value type stored in the container
     template<class T>
-    class Stack : private ForwardList<T>
+    class Stack : public IContainer
     {
     public:
         using value_type = T;
@@ -25,7 +33,7 @@ namespace CppADS
         Stack<T>& operator=(const Stack<T>& copy);  ///< Copy assignment operator
         Stack<T>& operator=(Stack<T>&& move);       ///< Move assignment operator
 
-        ~Stack() = default;                         ///< Destructor
+        ~Stack();                                   ///< Destructor
 
         /// @name Capacity
         /// @{
@@ -34,6 +42,10 @@ namespace CppADS
         /// @return element's count
         size_t size() const override;
 
+        /// @brief Get reserved size for container's data
+        /// @return Current stack's capacity
+        size_t capacity() const;
+
         /// @}
         /// @name Modifiers
         /// @{
@@ -41,6 +53,10 @@ namespace CppADS
         /// @brief Remove all data from container
         void clear() override;
 
+        /// @brief Reserve space for specific count of items
+        /// @param count reserved space
+        void reserve(size_t count);
+
         /// @brief Push value on top of the stack
         /// @param value added value
         void push(const T& value);
@@ -49,9 +65,32 @@ namespace CppADS
         /// @param value added value
         void push(T&& value);
 
+        /// @brief Construct value on top of the stack
+        /// @param args arguments of value's constructor
+        template<typename... Args>
+        void emplace(Args&&... args);
+
+        /// @brief Push range of values, the last one ends up on top
+        /// @param first iterator to the first pushed value
+        /// @param last iterator to the element after the last pushed value
+        template<typename InputIt>
+        void push_range(InputIt first, InputIt last);
+
         /// @brief Remove top item
         void pop();
 
+        /// @brief Remove several top items
+        /// @param count maximum count of removed items
+        /// @return count of removed items
+        size_t pop_n(size_t count);
+
+        /// @brief Move several top items out of the stack
+        /// @param out output iterator receiving removed values (the top one first)
+        /// @param count maximum count of removed items
+        /// @return count of removed items
+        template<typename OutputIt>
+        size_t pop_n(OutputIt out, size_t count);
+
         ///@}
         /// @name Accesors
         /// @{
@@ -65,71 +104,256 @@ namespace CppADS
         const_reference top() const;
 
         /// @}
+
+    private:
+        T* m_data { nullptr };                      ///< Buffer of uninitialized slots
+        size_t m_capacity { 0 };                    ///< Buffer size
+        size_t m_size { 0 };                        ///< Count of elements
+
+        /// @private
+        /// @brief Get size of the buffer which fits given count of items
+        /// @param count items count
+        /// @return power of two capacity
+        static size_t calc_capacity(size_t count);
+
+        /// @private
+        /// @brief Move data into new buffer and release the old one
+        /// @param data new buffer
+        /// @param capacity new buffer size
+        void relocate(T* data, size_t capacity);
+
+        template<typename InputIt>
+        void reserve_range(InputIt first, InputIt last, std::input_iterator_tag);
+        template<typename ForwardIt>
+        void reserve_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
     };
 }
 
 template<class T>
-CppADS::Stack<T>::Stack(const Stack<T>& copy) : ForwardList<T>(copy) {}
+CppADS::Stack<T>::Stack(const Stack<T>& copy)
+{
+    reserve(copy.m_size);
+    for (; m_size < copy.m_size; m_size++)
+        new (m_data + m_size) T(copy.m_data[m_size]);
+}
 
 template<class T>
-CppADS::Stack<T>::Stack(Stack<T>&& move) : ForwardList<T>(std::move(move)) {}
+CppADS::Stack<T>::Stack(Stack<T>&& move)
+    : m_data(move.m_data), m_capacity(move.m_capacity), m_size(move.m_size)
+{
+    move.m_data = nullptr;
+    move.m_capacity = 0;
+    move.m_size = 0;
+}
 
 template<class T>
-CppADS::Stack<T>::Stack(std::initializer_list<T> init_list) : ForwardList<T>(init_list) {}
+CppADS::Stack<T>::Stack(std::initializer_list<T> init_list)
+{
+    push_range(init_list.begin(), init_list.end());
+}
+
+template<class T>
+CppADS::Stack<T>::~Stack()
+{
+    clear();
+}
 
 template<class T>
 CppADS::Stack<T>& CppADS::Stack<T>::operator=(const Stack<T>& copy)
 {
-    ForwardList<T>::operator=(copy);
+    if (this == &copy)
+        return *this;
+
+    pop_n(m_size);
+    reserve(copy.m_size);
+    for (size_t i = 0; i < copy.m_size; i++)
+        push(copy.m_data[i]);
     return *this;
 }
 
 template<class T>
 CppADS::Stack<T>& CppADS::Stack<T>::operator=(Stack<T>&& move)
 {
-    ForwardList<T>::operator=(std::move(move));
+    if (this == &move)
+        return *this;
+
+    clear();
+    m_data = move.m_data;
+    m_capacity = move.m_capacity;
+    m_size = move.m_size;
+
+    move.m_data = nullptr;
+    move.m_capacity = 0;
+    move.m_size = 0;
     return *this;
 }
 
 template<class T>
 void CppADS::Stack<T>::clear()
 {
-    ForwardList<T>::clear();
+    pop_n(m_size);
+    if (m_data != nullptr)
+        std::allocator<T>().deallocate(m_data, m_capacity);
+
+    m_data = nullptr;
+    m_capacity = 0;
 }
 
 template<class T>
 size_t CppADS::Stack<T>::size() const
 {
-    return ForwardList<T>::size();
+    return m_size;
+}
+
+template<class T>
+size_t CppADS::Stack<T>::capacity() const
+{
+    return m_capacity;
+}
+
+template<class T>
+void CppADS::Stack<T>::reserve(size_t count)
+{
+    if (count <= m_capacity)
+        return;
+    relocate(std::allocator<T>().allocate(count), count);
 }
 
 template<class T>
 void CppADS::Stack<T>::push(const T& value)
 {
-    ForwardList<T>::push_front(value);
+    emplace(value);
 }
 
 template<class T>
 void CppADS::Stack<T>::push(T&& value)
 {
-    ForwardList<T>::push_front(std::move(value));
+    emplace(std::move(value));
+}
+
+template<class T>
+template<typename... Args>
+void CppADS::Stack<T>::emplace(Args&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        // Arguments may refer to elements of this stack, so the new value is
+        // constructed before the old buffer is released
+        size_t capacity = calc_capacity(m_size + 1);
+        T* data = std::allocator<T>().allocate(capacity);
+        try
+        {
+            new (data + m_size) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator<T>().deallocate(data, capacity);
+            throw;
+        }
+        relocate(data, capacity);
+    }
+    else
+    {
+        new (m_data + m_size) T(std::forward<Args>(args)...);
+    }
+    m_size++;
+}
+
+template<class T>
+template<typename InputIt>
+void CppADS::Stack<T>::push_range(InputIt first, InputIt last)
+{
+    reserve_range(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+    for (; first != last; ++first)
+        push(*first);
 }
 
 template<class T>
 typename CppADS::Stack<T>::reference CppADS::Stack<T>::top()
 {
-    return ForwardList<T>::front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Stack<T>::top: container is empty");
+    return m_data[m_size - 1];
 }
 
 template<class T>
 typename CppADS::Stack<T>::const_reference CppADS::Stack<T>::top() const
 {
-    return ForwardList<T>::front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Stack<T>::top: container is empty");
+    return m_data[m_size - 1];
 }
 
 template<class T>
 void CppADS::Stack<T>::pop()
 {
-    ForwardList<T>::pop_front();
+    if (m_size == 0)
+        throw std::out_of_range("CppADS::Stack<T>::pop: container is empty");
+    m_size--;
+    m_data[m_size].~T();
+}
+
+template<class T>
+size_t CppADS::Stack<T>::pop_n(size_t count)
+{
+    if (count > m_size)
+        count = m_size;
+    for (size_t i = 0; i < count; i++)
+    {
+        m_size--;
+        m_data[m_size].~T();
+    }
+    return count;
+}
+
+template<class T>
+template<typename OutputIt>
+size_t CppADS::Stack<T>::pop_n(OutputIt out, size_t count)
+{
+    if (count > m_size)
+        count = m_size;
+    for (size_t i = 0; i < count; i++, ++out)
+    {
+        m_size--;
+        *out = std::move(m_data[m_size]);
+        m_data[m_size].~T();
+    }
+    return count;
+}
+
+template<class T>
+size_t CppADS::Stack<T>::calc_capacity(size_t count)
+{
+    size_t capacity = 1;
+    while (capacity < count)
+        capacity <<= 1;
+    return capacity;
+}
+
+template<class T>
+void CppADS::Stack<T>::relocate(T* data, size_t capacity)
+{
+    for (size_t i = 0; i < m_size; i++)
+    {
+        new (data + i) T(std::move(m_data[i]));
+        m_data[i].~T();
+    }
+    if (m_data != nullptr)
+        std::allocator<T>().deallocate(m_data, m_capacity);
+
+    m_data = data;
+    m_capacity = capacity;
+}
+
+template<class T>
+template<typename InputIt>
+void CppADS::Stack<T>::reserve_range(InputIt, InputIt, std::input_iterator_tag)
+{}
+
+template<class T>
+template<typename ForwardIt>
+void CppADS::Stack<T>::reserve_range(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    reserve(m_size + std::distance(first, last));
 }
 #endif //STACK_H
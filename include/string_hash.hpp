@@ -0,0 +1,86 @@
+#ifndef STRING_HASH_HPP
+#define STRING_HASH_HPP
+
+#include "hash_mix.hpp"
+
+#include <cstring>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace CppADS
+{
+    /// @brief Hash bytes of memory block, 8 bytes per step
+    /// @param data pointer to the first byte
+    /// @param size count of bytes
+    /// @return hash value
+    inline size_t hash_bytes(const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        uint64_t hash = 0x9e3779b97f4a7c15ULL ^ size;
+        uint64_t word = 0;
+        if (size >= 8)
+        {
+            for (; size > 8; bytes += 8, size -= 8)
+            {
+                std::memcpy(&word, bytes, 8);
+                hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+                hash ^= hash >> 32;
+            }
+            // Last word overlaps the previous one instead of reading bytes one by one
+            std::memcpy(&word, bytes + size - 8, 8);
+        }
+        else if (size >= 4)
+        {
+            uint32_t low, high;
+            std::memcpy(&low, bytes, 4);
+            std::memcpy(&high, bytes + size - 4, 4);
+            word = (static_cast<uint64_t>(high) << 32) | low;
+        }
+        else if (size > 0)
+        {
+            word = (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[size / 2]) << 8) | bytes[size - 1];
+        }
+        hash = (hash ^ word) * 0xc4ceb9fe1a85ec53ULL;
+        return hash_mix(static_cast<size_t>(hash));
+    }
+
+    /// @brief Transparent hash of std::string keys
+    /// @details Gives the same value for std::string and C string with the same
+    /// characters, so tables can be searched with C strings without building a
+    /// temporary std::string.
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const std::string& key) const
+        {
+            return hash_bytes(key.data(), key.size());
+        }
+        size_t operator()(const char* key) const
+        {
+            return hash_bytes(key, std::strlen(key));
+        }
+    };
+
+    /// @brief Transparent equality of std::string keys and C strings
+    struct StringEqual
+    {
+        using is_transparent = void;
+
+        bool operator()(const std::string& lhs, const std::string& rhs) const
+        {
+            return lhs == rhs;
+        }
+        bool operator()(const std::string& lhs, const char* rhs) const
+        {
+            return lhs.compare(rhs) == 0;
+        }
+        bool operator()(const char* lhs, const std::string& rhs) const
+        {
+            return rhs.compare(lhs) == 0;
+        }
+    };
+}
+
+#endif //STRING_HASH_HPP
@@ -0,0 +1,467 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "array.hpp"
+#include "concurrency.hpp"
+#include "queue.hpp"
+#include "work_stealing_deque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace CppADS
+{
+    /// @brief Counter of unfinished tasks
+    /// @details Tasks submitted with a group increment the counter and decrement it when
+    /// they finish. ThreadPool::wait() lets a worker execute other tasks while it waits,
+    /// so tasks may wait for their own subtasks without blocking the pool. The first
+    /// exception thrown by a task of the group is kept and rethrown by ThreadPool::wait().
+    class WaitGroup
+    {
+    public:
+        WaitGroup() = default;                          ///< Default constructor
+
+        WaitGroup(const WaitGroup&) = delete;
+        WaitGroup& operator=(const WaitGroup&) = delete;
+
+        /// @brief Increase count of unfinished tasks
+        /// @param count count of added tasks
+        void add(size_t count = 1)
+        {
+            m_count.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        /// @brief Mark one task as finished
+        void done()
+        {
+            size_t count = m_count.load(std::memory_order_relaxed);
+            while (count > 1)
+            {
+                if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    return;
+            }
+
+            // The last decrement is done under the mutex, so a waiter which saw zero
+            // can't destroy the group before this call stops touching it
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_count.fetch_sub(1, std::memory_order_acq_rel);
+            m_finished.notify_all();
+        }
+
+        /// @return true if all tasks are finished
+        bool finished() const
+        {
+            return m_count.load(std::memory_order_acquire) == 0;
+        }
+
+        /// @brief Block calling thread until all tasks are finished
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_finished.wait(lock, [this]() { return finished(); });
+        }
+
+        /// @brief Keep exception of a failed task, only the first one is kept
+        /// @details Must be called before done() of the failed task.
+        /// @param exception exception thrown by the task
+        void fail(std::exception_ptr exception)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception)
+                m_exception = std::move(exception);
+        }
+
+        /// @brief Rethrow kept exception of a failed task and forget it
+        void rethrow()
+        {
+            std::exception_ptr exception;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::swap(exception, m_exception);
+            }
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+
+    private:
+        std::atomic<size_t> m_count { 0 };
+        std::mutex m_mutex;
+        std::condition_variable m_finished;
+        std::exception_ptr m_exception;                 ///< First exception of failed tasks
+    };
+
+    /// @brief Pool of threads executing tasks with work stealing
+    /// @details Every worker has its own WorkStealingDeque. Tasks submitted from a worker go
+    /// to the bottom of its deque and are executed in LIFO order, which keeps recursive
+    /// fork/join computations cache friendly. Idle workers steal the oldest tasks from
+    /// random victims. Tasks submitted from other threads go through a shared queue.
+    class ThreadPool
+    {
+    public:
+        /// @brief Constructor
+        /// @param threads count of worker threads, 0 means count of hardware threads
+        explicit ThreadPool(size_t threads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// @brief Destructor, waits for all submitted tasks
+        ~ThreadPool();
+
+        /// @brief Get count of worker threads
+        /// @return threads count
+        size_t size() const;
+
+        /// @brief Schedule task
+        /// @details Exception thrown by the task is discarded, submit it with a group
+        /// to get the exception from wait().
+        /// @param task function to execute
+        void submit(std::function<void()> task);
+
+        /// @brief Schedule task belonging to group
+        /// @param group group which counts the task as unfinished until it returns
+        /// @param task function to execute
+        void submit(WaitGroup& group, std::function<void()> task);
+
+        /// @brief Wait until all tasks of the group are finished
+        /// @details Worker threads execute other tasks while waiting. If some task of the
+        /// group has thrown, the first exception is rethrown after all tasks are finished.
+        /// @param group waited group
+        void wait(WaitGroup& group);
+
+        /// @brief Call body for each index of range in parallel and wait for completion
+        /// @param first first index
+        /// @param last index after the last one
+        /// @param body function called as body(index)
+        /// @param grain count of indexes in one task, 0 chooses it by count of workers
+        template<typename Function>
+        void parallel_for(size_t first, size_t last, Function body, size_t grain = 0);
+
+        /// @brief Call body for each item of the array range in parallel and wait for completion
+        /// @param array processed array
+        /// @param first index of the first item
+        /// @param last index after the last item
+        /// @param body function called as body(item)
+        /// @param grain count of items in one task, 0 chooses it by count of workers
+        template<typename T, typename Function>
+        void parallel_for(Array<T>& array, size_t first, size_t last, Function body, size_t grain = 0);
+
+    private:
+        /// @private
+        /// @brief Scheduled function
+        struct Task
+        {
+            std::function<void()> function;
+            WaitGroup* group { nullptr };
+        };
+
+        /// @private
+        /// @brief State of worker thread
+        struct Worker
+        {
+            WorkStealingDeque<Task*> tasks;
+            uint64_t random_state { 0 };                ///< State of victim selection generator
+        };
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_injection_mutex;
+        Queue<Task*> m_injection;                       ///< Tasks submitted from other threads
+        std::atomic<size_t> m_injected { 0 };           ///< Size of m_injection
+
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_wake;
+        std::atomic<size_t> m_sleeping { 0 };
+        std::atomic<bool> m_stop { false };
+
+        /// @private
+        /// @brief Get worker of calling thread
+        /// @return worker or nullptr if calling thread doesn't belong to the pool
+        Worker* current_worker() const;
+
+        /// @private
+        /// @return reference to worker of calling thread and its pool
+        static std::pair<const ThreadPool*, Worker*>& thread_worker();
+
+        /// @private
+        /// @brief Put task to deque of calling worker or to shared queue
+        void schedule(Task* task);
+
+        /// @private
+        /// @brief Take task from own deque, shared queue or deque of other worker
+        /// @return task or nullptr if nothing was found
+        Task* find_task(Worker* worker);
+
+        /// @private
+        /// @return true if some queue looks non-empty
+        bool has_tasks() const;
+
+        /// @private
+        /// @brief Run task and destroy it
+        void execute(Task* task);
+
+        /// @private
+        /// @brief Wake up one sleeping worker if there is any
+        void notify();
+
+        /// @private
+        /// @brief Worker thread function
+        void run(size_t index);
+    };
+}
+
+inline CppADS::ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->random_state = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    for (size_t i = 0; i < threads; i++)
+        m_threads.emplace_back(&ThreadPool::run, this, i);
+}
+
+inline CppADS::ThreadPool::~ThreadPool()
+{
+    m_stop.store(true, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_wake.notify_all();
+    }
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+inline size_t CppADS::ThreadPool::size() const
+{
+    return m_workers.size();
+}
+
+inline void CppADS::ThreadPool::submit(std::function<void()> task)
+{
+    schedule(new Task { std::move(task), nullptr });
+}
+
+inline void CppADS::ThreadPool::submit(WaitGroup& group, std::function<void()> task)
+{
+    group.add();
+    schedule(new Task { std::move(task), &group });
+}
+
+inline void CppADS::ThreadPool::wait(WaitGroup& group)
+{
+    Worker* worker = current_worker();
+    if (worker == nullptr)
+    {
+        group.wait();
+        group.rethrow();
+        return;
+    }
+
+    Backoff backoff;
+    while (!group.finished())
+    {
+        Task* task = find_task(worker);
+        if (task != nullptr)
+        {
+            execute(task);
+            backoff.reset();
+        }
+        else
+        {
+            backoff.pause();
+        }
+    }
+    // Synchronize with the last done() before the group may be destroyed
+    group.wait();
+    group.rethrow();
+}
+
+template<typename Function>
+void CppADS::ThreadPool::parallel_for(size_t first, size_t last, Function body, size_t grain)
+{
+    if (first >= last)
+        return;
+    if (grain == 0)
+        grain = std::max<size_t>(1, (last - first) / (8 * size()));
+
+    WaitGroup group;
+    for (size_t begin = first; begin < last; begin += grain)
+    {
+        size_t end = std::min(last, begin + grain);
+        submit(group, [&body, begin, end]() {
+            for (size_t i = begin; i < end; i++)
+                body(i);
+        });
+    }
+    wait(group);
+}
+
+template<typename T, typename Function>
+void CppADS::ThreadPool::parallel_for(Array<T>& array, size_t first, size_t last, Function body, size_t grain)
+{
+    if (last > array.size())
+        throw std::out_of_range("CppADS::ThreadPool::parallel_for: range is out of array");
+    if (first >= last)
+        return;
+
+    T* data = &array[first];
+    parallel_for(first, last, [&body, data, first](size_t index) {
+        body(data[index - first]);
+    }, grain);
+}
+
+inline std::pair<const CppADS::ThreadPool*, CppADS::ThreadPool::Worker*>& CppADS::ThreadPool::thread_worker()
+{
+    static thread_local std::pair<const ThreadPool*, Worker*> worker { nullptr, nullptr };
+    return worker;
+}
+
+inline CppADS::ThreadPool::Worker* CppADS::ThreadPool::current_worker() const
+{
+    const std::pair<const ThreadPool*, Worker*>& worker = thread_worker();
+    return (worker.first == this) ? worker.second : nullptr;
+}
+
+inline void CppADS::ThreadPool::schedule(Task* task)
+{
+    Worker* worker = current_worker();
+    if (worker != nullptr)
+    {
+        worker->tasks.push(task);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_injection_mutex);
+        m_injection.enqueue(task);
+        m_injected.fetch_add(1, std::memory_order_relaxed);
+    }
+    notify();
+}
+
+inline CppADS::ThreadPool::Task* CppADS::ThreadPool::find_task(Worker* worker)
+{
+    Task* task = nullptr;
+    if (worker->tasks.pop(task))
+        return task;
+
+    if (m_injected.load(std::memory_order_relaxed) != 0)
+    {
+        std::lock_guard<std::mutex> lock(m_injection_mutex);
+        if (m_injection.size() != 0)
+        {
+            task = m_injection.front();
+            m_injection.dequeue();
+            m_injected.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // Steal from victims starting with random one
+    size_t count = m_workers.size();
+    uint64_t random = worker->random_state;
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+    worker->random_state = random;
+    size_t start = static_cast<size_t>(random % count);
+    for (size_t i = 0; i < count; i++)
+    {
+        Worker* victim = m_workers[(start + i) % count].get();
+        if (victim != worker && victim->tasks.steal(task))
+            return task;
+    }
+    return nullptr;
+}
+
+inline bool CppADS::ThreadPool::has_tasks() const
+{
+    if (m_injected.load(std::memory_order_relaxed) != 0)
+        return true;
+    for (const auto& worker : m_workers)
+        if (!worker->tasks.empty())
+            return true;
+    return false;
+}
+
+inline void CppADS::ThreadPool::execute(Task* task)
+{
+    std::unique_ptr<Task> owned(task);
+    try
+    {
+        owned->function();
+    }
+    catch (...)
+    {
+        // Worker thread must survive and the group must be finished anyway
+        if (owned->group != nullptr)
+            owned->group->fail(std::current_exception());
+    }
+    if (owned->group != nullptr)
+        owned->group->done();
+}
+
+inline void CppADS::ThreadPool::notify()
+{
+    // Pairs with the fence in run(): either sleeper sees the task or we see sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed) == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    m_wake.notify_one();
+}
+
+inline void CppADS::ThreadPool::run(size_t index)
+{
+    Worker* worker = m_workers[index].get();
+    thread_worker() = std::make_pair(this, worker);
+
+    Backoff backoff;
+    while (true)
+    {
+        Task* task = find_task(worker);
+        if (task != nullptr)
+        {
+            execute(task);
+            backoff.reset();
+            continue;
+        }
+
+        if (!backoff.exhausted())
+        {
+            backoff.pause();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!has_tasks() && !m_stop.load(std::memory_order_relaxed))
+            m_wake.wait(lock);
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+        if (m_stop.load(std::memory_order_relaxed) && !has_tasks())
+            break;
+        backoff.reset();
+    }
+
+    thread_worker() = std::make_pair(nullptr, nullptr);
+}
+
+#endif //THREAD_POOL_HPP
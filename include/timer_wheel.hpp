@@ -0,0 +1,433 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include "container.hpp"
+#include "array.hpp"
+
+#include <stdexcept>
+#include <stdint.h>
+
+namespace CppADS
+{
+    /// @brief Hierarchical timing wheel
+    /// @details Time is counted in integer ticks. Level k of the wheel has Slots slots, each
+    /// spanning Slots^k ticks, so Levels levels cover Slots^Levels ticks ahead of now.
+    /// A timer is linked into the slot of the lowest level which covers its delay. When the
+    /// lowest level wraps, the next slot of the upper level is cascaded: its timers are
+    /// linked again to lower levels by their remaining delay. Timers further than the
+    /// horizon wait in the farthest slot and are relinked in the same way.
+    ///
+    /// Timers live in a slab (Array) and slot lists are intrusive doubly linked lists of
+    /// slab indices, so schedule and cancel are O(1) and never allocate once the slab has
+    /// grown. A timer id combines the slab index with a generation number which is bumped
+    /// when the timer fires or is cancelled, so an outdated id is detected.
+    /// @tparam T value type stored in timers
+    template<class T>
+    class TimerWheel : public IContainer
+    {
+    public:
+        using value_type = T;
+        using timer_id = uint64_t;
+
+        static constexpr size_t SlotBits = 8;                       ///< log2 of slots per level
+        static constexpr size_t Slots = size_t(1) << SlotBits;      ///< Slots per level
+        static constexpr size_t Levels = 4;                         ///< Count of levels
+
+        /// @brief Constructor
+        /// @param now initial time in ticks
+        explicit TimerWheel(uint64_t now = 0);
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of pending timers
+        /// @return timers count
+        size_t size() const override;
+
+        /// @return true if there are no pending timers
+        bool empty() const;
+
+        /// @}
+        /// @name Modifiers
+        /// @{
+
+        /// @brief Cancel all timers
+        void clear() override;
+
+        /// @brief Schedule timer, O(1)
+        /// @param delay count of ticks before expiry, 0 is treated as 1
+        /// @param value value passed to expiry callback
+        /// @return id of the timer
+        timer_id schedule(uint64_t delay, const T& value);
+
+        /// @brief Schedule timer, O(1)
+        /// @param delay count of ticks before expiry, 0 is treated as 1
+        /// @param value value passed to expiry callback
+        /// @return id of the timer
+        timer_id schedule(uint64_t delay, T&& value);
+
+        /// @brief Cancel timer, O(1)
+        /// @param id id of the timer
+        /// @return false if timer has already expired or been cancelled
+        bool cancel(timer_id id);
+
+        /// @brief Move time forward and fire expired timers
+        /// @details Timers expiring at the same tick are fired in a batch. Callback may
+        /// schedule and cancel timers.
+        /// @param ticks count of ticks to advance
+        /// @param callback function called as callback(T&) for each expired timer
+        /// @return count of expired timers
+        template<typename Callback>
+        size_t advance(uint64_t ticks, Callback callback);
+
+        /// @brief Move time forward and collect values of expired timers
+        /// @param ticks count of ticks to advance
+        /// @param out output iterator receiving values in expiry order
+        /// @return count of expired timers
+        template<typename OutputIt>
+        size_t expire(uint64_t ticks, OutputIt out);
+
+        /// @}
+        /// @name Accesors
+        /// @{
+
+        /// @return current time in ticks
+        uint64_t now() const;
+
+        /// @brief Check whether timer is pending
+        /// @param id id of the timer
+        bool contains(timer_id id) const;
+
+        /// @brief Get value of pending timer
+        /// @param id id of the timer
+        /// @return reference to the value
+        T& get(timer_id id);
+
+        /// @brief Get expiry time of pending timer
+        /// @param id id of the timer
+        /// @return tick of expiry
+        uint64_t expiry(timer_id id) const;
+
+        /// @}
+
+    private:
+        static constexpr uint32_t npos = 0xFFFFFFFFu;               ///< Invalid index
+        static constexpr uint64_t Horizon = uint64_t(1) << (SlotBits * Levels);
+
+        /// @private
+        struct Timer
+        {
+            T value {};
+            uint64_t expiry { 0 };
+            uint32_t prev { npos };
+            uint32_t next { npos };         ///< Next timer in slot, or next free timer
+            uint32_t slot { npos };         ///< Slot the timer is linked to, npos if free
+            uint32_t generation { 0 };
+        };
+
+        Array<Timer> m_timers;              ///< Slab of timers
+        Array<uint32_t> m_slots;            ///< Heads of slot lists, level by level
+        uint32_t m_free { npos };           ///< List of free timers
+        uint64_t m_now;
+        size_t m_size { 0 };
+
+        /// @private
+        static timer_id make_id(uint32_t index, uint32_t generation);
+
+        /// @private
+        /// @brief Get slab index of pending timer, npos if id is outdated
+        uint32_t find(timer_id id) const;
+
+        /// @private
+        uint32_t acquire();
+
+        /// @private
+        void release(uint32_t index);
+
+        /// @private
+        /// @brief Link timer to the slot matching its expiry
+        void place(uint32_t index);
+
+        /// @private
+        void link(uint32_t slot, uint32_t index);
+
+        /// @private
+        void unlink(uint32_t index);
+
+        /// @private
+        /// @brief Relink timers of upper level slots when lower levels wrap
+        void cascade();
+
+        /// @private
+        /// @brief Advance by one tick and fire timers of the current slot
+        template<typename Callback>
+        size_t tick(Callback& callback);
+    };
+}
+
+template<class T>
+constexpr size_t CppADS::TimerWheel<T>::Slots;
+
+template<class T>
+constexpr size_t CppADS::TimerWheel<T>::Levels;
+
+template<class T>
+constexpr uint32_t CppADS::TimerWheel<T>::npos;
+
+template<class T>
+CppADS::TimerWheel<T>::TimerWheel(uint64_t now) : m_now(now)
+{
+    m_slots.reserve(Slots * Levels);
+    for (size_t slot = 0; slot < Slots * Levels; slot++)
+        m_slots.push_back(npos);
+}
+
+template<class T>
+size_t CppADS::TimerWheel<T>::size() const
+{
+    return m_size;
+}
+
+template<class T>
+bool CppADS::TimerWheel<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::clear()
+{
+    for (uint32_t index = 0; index < m_timers.size(); index++)
+    {
+        if (m_timers[index].slot != npos)
+        {
+            unlink(index);
+            release(index);
+        }
+    }
+}
+
+template<class T>
+typename CppADS::TimerWheel<T>::timer_id CppADS::TimerWheel<T>::schedule(uint64_t delay, const T& value)
+{
+    return schedule(delay, T(value));
+}
+
+template<class T>
+typename CppADS::TimerWheel<T>::timer_id CppADS::TimerWheel<T>::schedule(uint64_t delay, T&& value)
+{
+    uint32_t index = acquire();
+    Timer& timer = m_timers[index];
+    timer.value = std::move(value);
+    timer.expiry = m_now + (delay == 0 ? 1 : delay);
+    place(index);
+    m_size++;
+    return make_id(index, timer.generation);
+}
+
+template<class T>
+bool CppADS::TimerWheel<T>::cancel(timer_id id)
+{
+    uint32_t index = find(id);
+    if (index == npos)
+        return false;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+template<class T>
+template<typename Callback>
+size_t CppADS::TimerWheel<T>::advance(uint64_t ticks, Callback callback)
+{
+    size_t expired = 0;
+    for (; ticks > 0; ticks--)
+    {
+        // Nothing can fire, the wheel is reset to the new time in one step
+        if (m_size == 0)
+        {
+            m_now += ticks;
+            break;
+        }
+        expired += tick(callback);
+    }
+    return expired;
+}
+
+template<class T>
+template<typename OutputIt>
+size_t CppADS::TimerWheel<T>::expire(uint64_t ticks, OutputIt out)
+{
+    return advance(ticks, [&out](T& value) {
+        *out = std::move(value);
+        ++out;
+    });
+}
+
+template<class T>
+uint64_t CppADS::TimerWheel<T>::now() const
+{
+    return m_now;
+}
+
+template<class T>
+bool CppADS::TimerWheel<T>::contains(timer_id id) const
+{
+    return find(id) != npos;
+}
+
+template<class T>
+T& CppADS::TimerWheel<T>::get(timer_id id)
+{
+    uint32_t index = find(id);
+    if (index == npos)
+        throw std::out_of_range("CppADS::TimerWheel<T>::get: timer isn't pending");
+    return m_timers[index].value;
+}
+
+template<class T>
+uint64_t CppADS::TimerWheel<T>::expiry(timer_id id) const
+{
+    uint32_t index = find(id);
+    if (index == npos)
+        throw std::out_of_range("CppADS::TimerWheel<T>::expiry: timer isn't pending");
+    return m_timers[index].expiry;
+}
+
+template<class T>
+typename CppADS::TimerWheel<T>::timer_id CppADS::TimerWheel<T>::make_id(uint32_t index, uint32_t generation)
+{
+    return (uint64_t(generation) << 32) | index;
+}
+
+template<class T>
+uint32_t CppADS::TimerWheel<T>::find(timer_id id) const
+{
+    uint32_t index = static_cast<uint32_t>(id);
+    if (index >= m_timers.size())
+        return npos;
+    const Timer& timer = m_timers[index];
+    if (timer.slot == npos || timer.generation != static_cast<uint32_t>(id >> 32))
+        return npos;
+    return index;
+}
+
+template<class T>
+uint32_t CppADS::TimerWheel<T>::acquire()
+{
+    if (m_free != npos)
+    {
+        uint32_t index = m_free;
+        m_free = m_timers[index].next;
+        return index;
+    }
+    if (m_timers.size() >= npos)
+        throw std::length_error("CppADS::TimerWheel<T>::schedule: too many timers");
+    m_timers.push_back(Timer());
+    return static_cast<uint32_t>(m_timers.size() - 1);
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::release(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    timer.value = T();
+    timer.generation++;
+    timer.next = m_free;
+    m_free = index;
+    m_size--;
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::place(uint32_t index)
+{
+    uint64_t expiry = m_timers[index].expiry;
+    uint64_t delay = expiry - m_now;
+    if (delay >= Horizon)
+    {
+        delay = Horizon - 1;
+        expiry = m_now + delay;
+    }
+
+    size_t level = 0;
+    while (delay >= (uint64_t(1) << (SlotBits * (level + 1))))
+        level++;
+    size_t slot = (expiry >> (SlotBits * level)) & (Slots - 1);
+    link(static_cast<uint32_t>(level * Slots + slot), index);
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::link(uint32_t slot, uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    timer.slot = slot;
+    timer.prev = npos;
+    timer.next = m_slots[slot];
+    if (timer.next != npos)
+        m_timers[timer.next].prev = index;
+    m_slots[slot] = index;
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::unlink(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    if (timer.prev != npos)
+        m_timers[timer.prev].next = timer.next;
+    else
+        m_slots[timer.slot] = timer.next;
+    if (timer.next != npos)
+        m_timers[timer.next].prev = timer.prev;
+    timer.slot = npos;
+    timer.prev = npos;
+    timer.next = npos;
+}
+
+template<class T>
+void CppADS::TimerWheel<T>::cascade()
+{
+    // The highest level whose slot boundary is crossed now goes first, so its timers
+    // may land in lower slots which are cascaded in the same step
+    size_t top = 0;
+    while (top + 1 < Levels && (m_now & ((uint64_t(1) << (SlotBits * (top + 1))) - 1)) == 0)
+        top++;
+
+    for (size_t level = top; level > 0; level--)
+    {
+        size_t slot = level * Slots + ((m_now >> (SlotBits * level)) & (Slots - 1));
+        uint32_t index = m_slots[slot];
+        m_slots[slot] = npos;
+        while (index != npos)
+        {
+            uint32_t next = m_timers[index].next;
+            place(index);
+            index = next;
+        }
+    }
+}
+
+template<class T>
+template<typename Callback>
+size_t CppADS::TimerWheel<T>::tick(Callback& callback)
+{
+    m_now++;
+    if ((m_now & (Slots - 1)) == 0)
+        cascade();
+
+    size_t slot = m_now & (Slots - 1);
+    size_t expired = 0;
+    while (m_slots[slot] != npos)
+    {
+        uint32_t index = m_slots[slot];
+        unlink(index);
+        T value = std::move(m_timers[index].value);
+        release(index);
+        expired++;
+
+        // Slab may grow inside callback, so no references to it are kept
+        callback(value);
+    }
+    return expired;
+}
+
+#endif //TIMER_WHEEL_HPP
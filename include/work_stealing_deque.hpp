@@ -0,0 +1,215 @@
+#ifndef WORK_STEALING_DEQUE_HPP
+#define WORK_STEALING_DEQUE_HPP
+
+#include "concurrency.hpp"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <type_traits>
+
+namespace CppADS
+{
+    /// @brief Chase-Lev work-stealing deque
+    /// @details Owner thread pushes and pops values at the bottom end as a LIFO stack,
+    /// any other thread can steal values from the top end. Owner operations touch
+    /// shared data only when the deque is almost empty, steal costs one CAS.
+    ///
+    /// Values are stored in a circular array which doubles when full. Replaced arrays
+    /// are retained until the deque is destroyed, because a thief may still read from them.
+    /// @tparam T trivially copyable value type (usually pointer to task)
+    template<typename T>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque values must be trivially copyable");
+
+    public:
+        using value_type = T;
+
+        /// @brief Constructor
+        /// @param capacity initial capacity, rounded up to power of two
+        explicit WorkStealingDeque(size_t capacity = 64);
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        ~WorkStealingDeque() = default;                 ///< Destructor
+
+        /// @name Capacity
+        /// @{
+
+        /// @brief Get count of elements
+        /// @details Exact only when there are no concurrent operations
+        /// @return element's count
+        size_t size() const;
+
+        /// @return true if deque looks empty
+        bool empty() const;
+
+        /// @brief Get size of current array
+        /// @return count of elements which fit without growth
+        size_t capacity() const;
+
+        /// @}
+        /// @name Owner
+        /// @{
+
+        /// @brief Add value to the bottom, only owner thread may call it
+        /// @param value added value
+        void push(T value);
+
+        /// @brief Remove value from the bottom, only owner thread may call it
+        /// @param value destination
+        /// @return false if deque is empty
+        bool pop(T& value);
+
+        /// @}
+        /// @name Thieves
+        /// @{
+
+        /// @brief Remove value from the top, any thread may call it
+        /// @param value destination
+        /// @return false if deque is empty or another thread won the race for the value
+        bool steal(T& value);
+
+        /// @}
+
+    private:
+        /// @private
+        /// @brief Circular array of values
+        struct Buffer
+        {
+            explicit Buffer(size_t _capacity)
+                : capacity(_capacity), mask(_capacity - 1), items(std::make_unique<std::atomic<T>[]>(_capacity)) {}
+
+            T get(int64_t index) const {
+                return items[index & mask].load(std::memory_order_relaxed);
+            }
+            void put(int64_t index, T value) {
+                items[index & mask].store(value, std::memory_order_relaxed);
+            }
+
+            size_t capacity;
+            int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> items;
+            std::unique_ptr<Buffer> previous;       ///< Retired array
+        };
+
+        alignas(CacheLineSize) std::atomic<int64_t> m_top { 0 };      ///< Next value to steal
+        alignas(CacheLineSize) std::atomic<int64_t> m_bottom { 0 };   ///< Next free position of owner
+        std::atomic<Buffer*> m_buffer { nullptr };                      ///< Current array
+        std::unique_ptr<Buffer> m_storage;                              ///< Owner of current and retired arrays
+
+        /// @private
+        /// @brief Replace array with twice larger one
+        Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom);
+    };
+}
+
+template<typename T>
+CppADS::WorkStealingDeque<T>::WorkStealingDeque(size_t capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("CppADS::WorkStealingDeque<T>::WorkStealingDeque: capacity must be positive");
+
+    size_t storage_size = 1;
+    while (storage_size < capacity)
+        storage_size <<= 1;
+
+    m_storage = std::make_unique<Buffer>(storage_size);
+    m_buffer.store(m_storage.get(), std::memory_order_relaxed);
+}
+
+template<typename T>
+size_t CppADS::WorkStealingDeque<T>::size() const
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template<typename T>
+bool CppADS::WorkStealingDeque<T>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T>
+size_t CppADS::WorkStealingDeque<T>::capacity() const
+{
+    return m_buffer.load(std::memory_order_relaxed)->capacity;
+}
+
+template<typename T>
+void CppADS::WorkStealingDeque<T>::push(T value)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+    Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+    if (bottom - top > buffer->mask)
+        buffer = grow(buffer, top, bottom);
+
+    buffer->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool CppADS::WorkStealingDeque<T>::pop(T& value)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    value = buffer->get(bottom);
+    if (top == bottom)
+    {
+        // The last value, race with thieves for it
+        bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<typename T>
+bool CppADS::WorkStealingDeque<T>::steal(T& value)
+{
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return false;
+
+    Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+    T stolen = buffer->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    value = stolen;
+    return true;
+}
+
+template<typename T>
+typename CppADS::WorkStealingDeque<T>::Buffer* CppADS::WorkStealingDeque<T>::grow(Buffer* buffer, int64_t top, int64_t bottom)
+{
+    std::unique_ptr<Buffer> grown = std::make_unique<Buffer>(buffer->capacity * 2);
+    for (int64_t i = top; i < bottom; i++)
+        grown->put(i, buffer->get(i));
+
+    grown->previous = std::move(m_storage);
+    m_storage = std::move(grown);
+    m_buffer.store(m_storage.get(), std::memory_order_release);
+    return m_storage.get();
+}
+
+#endif //WORK_STEALING_DEQUE_HPP
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include "array.hpp"
+
+#include <memory>
+
 using CppADS::Array;
 
 TEST(ArrayTest, ConstructTest)
@@ -127,6 +130,16 @@ TEST(ArrayTest, RemoveTest)
     ASSERT_THROW(array.remove(array.begin() - 99), std::out_of_range);
 }
 
+TEST(ArrayTest, RemoveReleaseTest)
+{
+    auto value = std::make_shared<int>(1);
+    Array<std::shared_ptr<int>> array {value, value, value};
+    array.remove(1);
+    ASSERT_EQ(value.use_count(), 3);
+    array.remove(array.begin());
+    ASSERT_EQ(value.use_count(), 2);
+}
+
 TEST(ArrayTest, CapacityTest)
 {
     Array<int> array;
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "cache.hpp"
+using CppADS::Cache;
+using CppADS::LruPolicyCache;
+using CppADS::ClockCache;
+using CppADS::TwoQueueCache;
+using CppADS::ArcCache;
+
+template<typename CacheType>
+void check_modify()
+{
+    CacheType cache(3);
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.capacity(), 3);
+    ASSERT_EQ(cache.get(1), nullptr);
+
+    ASSERT_TRUE(cache.put(1, "one"));
+    ASSERT_TRUE(cache.put(2, "two"));
+    ASSERT_FALSE(cache.put(2, "TWO"));
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(*cache.get(2), "TWO");
+
+    ASSERT_TRUE(cache.erase(1));
+    ASSERT_FALSE(cache.erase(1));
+    ASSERT_FALSE(cache.contains(1));
+
+    for (int i = 0; i < 100; i++)
+        cache.put(i, std::to_string(i));
+    ASSERT_EQ(cache.size(), 3);
+    ASSERT_TRUE(cache.contains(99));
+    ASSERT_EQ(*cache.get(99), "99");
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.evictions(), 97);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_FALSE(cache.contains(99));
+    ASSERT_TRUE(cache.put(99, "99"));
+}
+
+template<typename CacheType>
+size_t hot_keys_after_scan(int cold_per_round)
+{
+    CacheType cache(8);
+    for (int round = 0; round < 4; round++)
+    {
+        for (int key = 0; key < 4; key++)
+        {
+            if (cache.get(key) == nullptr)
+                cache.put(key, std::to_string(key));
+        }
+        for (int key = 100 + round * cold_per_round; key < 100 + (round + 1) * cold_per_round; key++)
+        {
+            if (cache.get(key) == nullptr)
+                cache.put(key, std::to_string(key));
+        }
+    }
+
+    for (int key = 1000; key < 1100; key++)
+    {
+        if (cache.get(key) == nullptr)
+            cache.put(key, std::to_string(key));
+    }
+
+    size_t survived = 0;
+    for (int key = 0; key < 4; key++)
+        survived += cache.contains(key) ? 1 : 0;
+    return survived;
+}
+
+TEST(CacheTest, ModifyTest)
+{
+    check_modify<LruPolicyCache<int, std::string>>();
+    check_modify<ClockCache<int, std::string>>();
+    check_modify<TwoQueueCache<int, std::string>>();
+    check_modify<ArcCache<int, std::string>>();
+
+    ASSERT_THROW((ArcCache<int, int>(0)), std::invalid_argument);
+}
+
+TEST(CacheTest, LruPolicyTest)
+{
+    LruPolicyCache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    cache.get(1);
+    cache.put(4, 4);
+
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_EQ((hot_keys_after_scan<LruPolicyCache<int, std::string>>(2)), 0);
+}
+
+TEST(CacheTest, ClockPolicyTest)
+{
+    ClockCache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    cache.get(1);
+    cache.get(3);
+    cache.put(4, 4);
+
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(3));
+    ASSERT_TRUE(cache.contains(4));
+}
+
+TEST(CacheTest, TwoQueuePolicyTest)
+{
+    ASSERT_EQ((hot_keys_after_scan<TwoQueueCache<int, std::string>>(8)), 4);
+}
+
+TEST(CacheTest, ArcPolicyTest)
+{
+    ASSERT_EQ((hot_keys_after_scan<ArcCache<int, std::string>>(2)), 4);
+
+    ArcCache<int, int> cache(4);
+    for (int round = 0; round < 10; round++)
+    {
+        for (int key = 0; key < 100; key++)
+        {
+            if (cache.get(key % 6) == nullptr)
+                cache.put(key % 6, key);
+            ASSERT_LE(cache.size(), 4);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
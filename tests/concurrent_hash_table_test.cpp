@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "concurrent_hash_table.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using CppADS::ConcurrentHashTable;
+
+namespace
+{
+    /// Hash which counts its calls
+    struct CountingHash
+    {
+        static int calls;
+        size_t operator()(int key) const { calls++; return std::hash<int>()(key); }
+    };
+    int CountingHash::calls = 0;
+}
+
+TEST(ConcurrentHashTableTest, ConstructTest)
+{
+    ConcurrentHashTable<int, int> table;
+    ASSERT_EQ(table.shard_count(), (ConcurrentHashTable<int, int>::DefaultShardCount));
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_TRUE(table.empty());
+
+    ConcurrentHashTable<int, int> single(1);
+    ASSERT_EQ(single.shard_count(), 1);
+    ASSERT_TRUE(single.insert({1, 1}));
+    ASSERT_TRUE(single.contains(1));
+
+    ASSERT_THROW((ConcurrentHashTable<int, int>(0)), std::invalid_argument);
+}
+
+TEST(ConcurrentHashTableTest, ModifyTest)
+{
+    ConcurrentHashTable<std::string, int> table(4);
+    ASSERT_TRUE(table.insert({"a", 1}));
+    ASSERT_FALSE(table.insert({"a", 2}));
+    int value = 0;
+    ASSERT_TRUE(table.find("a", value));
+    ASSERT_EQ(value, 1);
+    ASSERT_FALSE(table.find("b", value));
+    ASSERT_EQ(value, 1);
+
+    ASSERT_FALSE(table.insert_or_assign("a", 3));
+    ASSERT_TRUE(table.insert_or_assign("b", 4));
+    ASSERT_TRUE(table.find("a", value));
+    ASSERT_EQ(value, 3);
+
+    auto increment = [](int& counter) { counter++; };
+    ASSERT_FALSE(table.upsert("b", increment, 0));
+    ASSERT_TRUE(table.upsert("c", increment, 10));
+    ASSERT_TRUE(table.find("b", value));
+    ASSERT_EQ(value, 5);
+    ASSERT_TRUE(table.find("c", value));
+    ASSERT_EQ(value, 10);
+
+    int calls = 0;
+    auto compute = [&calls](const std::string& key) { calls++; return static_cast<int>(key.size()); };
+    ASSERT_EQ(table.compute_if_absent("dddd", compute), 4);
+    ASSERT_EQ(table.compute_if_absent("dddd", compute), 4);
+    ASSERT_EQ(table.compute_if_absent("a", compute), 3);
+    ASSERT_EQ(calls, 1);
+    ASSERT_EQ(table.size(), 4);
+
+    ASSERT_FALSE(table.erase_if("a", [](int counter) { return counter > 3; }));
+    ASSERT_TRUE(table.erase_if("b", [](int counter) { return counter > 3; }));
+    ASSERT_FALSE(table.erase_if("b", [](int) { return true; }));
+    ASSERT_TRUE(table.remove("c"));
+    ASSERT_FALSE(table.remove("c"));
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_TRUE(table.contains("a"));
+    ASSERT_TRUE(table.contains("dddd"));
+}
+
+TEST(ConcurrentHashTableTest, ForEachTest)
+{
+    ConcurrentHashTable<int, int> table(8);
+    for (int i = 0; i < 1000; i++)
+        table.insert({i, i});
+
+    table.for_each([](const int&, int& value) { value *= 2; });
+    long long sum = 0;
+    size_t count = 0;
+    const auto& const_table = table;
+    const_table.for_each([&sum, &count](const std::pair<int, int>& item) {
+        ASSERT_EQ(item.second, item.first * 2);
+        sum += item.second;
+        count++;
+    });
+    ASSERT_EQ(count, 1000);
+    ASSERT_EQ(sum, 999 * 1000);
+
+    ASSERT_EQ(table.erase_if([](const std::pair<int, int>& item) { return item.first % 3 == 0; }), 334);
+    ASSERT_EQ(table.size(), 666);
+    ASSERT_FALSE(table.contains(999));
+    ASSERT_TRUE(table.contains(998));
+
+    table.clear();
+    ASSERT_TRUE(table.empty());
+    ASSERT_TRUE(table.insert({1, 1}));
+}
+
+TEST(ConcurrentHashTableTest, SingleHashTest)
+{
+    // A single item never triggers rehashing, every call is of the operation itself
+    ConcurrentHashTable<int, int, CountingHash> table(4);
+    CountingHash::calls = 0;
+    ASSERT_TRUE(table.insert({1, 1}));
+    ASSERT_FALSE(table.insert_or_assign(1, 2));
+    ASSERT_FALSE(table.upsert(1, [](int& value) { value++; }, 0));
+    ASSERT_EQ(table.compute_if_absent(1, [](int) { return 0; }), 3);
+    int value = 0;
+    ASSERT_TRUE(table.find(1, value));
+    ASSERT_TRUE(table.contains(1));
+    ASSERT_FALSE(table.erase_if(1, [](int) { return false; }));
+    ASSERT_TRUE(table.remove(1));
+    ASSERT_EQ(CountingHash::calls, 8);
+}
+
+TEST(ConcurrentHashTableTest, ConcurrentTest)
+{
+    const int threads_count = 8;
+    const int keys = 500;
+    const int rounds = 20;
+    ConcurrentHashTable<int, int> table(16);
+    std::atomic<int> computed { 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; t++)
+    {
+        threads.emplace_back([&table, &computed, t]() {
+            for (int round = 0; round < rounds; round++)
+            {
+                for (int key = 0; key < keys; key++)
+                {
+                    table.upsert(key, [](int& counter) { counter++; }, 1);
+                    table.compute_if_absent(keys + key, [&computed](int k) { computed++; return k; });
+                    int value = 0;
+                    ASSERT_TRUE(table.find(key, value));
+                    ASSERT_GT(value, 0);
+                }
+                // Whole-table passes run next to single-key operations
+                if (t == 0)
+                {
+                    table.for_each([](const int&, int& value) { ASSERT_GT(value, 0); });
+                    ASSERT_EQ(table.erase_if([](const std::pair<int, int>& item) { return item.first < 0; }), 0);
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // Every key was computed once and counted by every upsert
+    ASSERT_EQ(computed.load(), keys);
+    ASSERT_EQ(table.size(), 2 * keys);
+    for (int key = 0; key < keys; key++)
+    {
+        int value = 0;
+        ASSERT_TRUE(table.find(key, value));
+        ASSERT_EQ(value, threads_count * rounds);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
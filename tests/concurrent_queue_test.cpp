@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include "concurrent_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+using CppADS::ConcurrentQueue;
+
+TEST(ConcurrentQueueTest, ConstructTest)
+{
+    ConcurrentQueue<int> queue;
+    ASSERT_EQ(queue.size(), 0);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(queue.capacity(), 0);
+
+    int value;
+    ASSERT_FALSE(queue.try_dequeue(value));
+
+    auto producer = queue.make_producer();
+    ASSERT_GT(queue.capacity(), 0);
+    ASSERT_FALSE(queue.try_dequeue(value));
+}
+
+TEST(ConcurrentQueueTest, ModifyTest)
+{
+    ConcurrentQueue<std::string> queue;
+    auto producer = queue.make_producer();
+    producer.enqueue("a");
+    std::string value = "b";
+    producer.enqueue(value);
+    producer.emplace(2, 'c');
+    ASSERT_EQ(queue.size(), 3);
+
+    const char* expected[] = {"a", "b", "cc"};
+    for (const char* item : expected)
+    {
+        ASSERT_TRUE(queue.try_dequeue(value));
+        ASSERT_EQ(value, item);
+    }
+    ASSERT_FALSE(queue.try_dequeue(value));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, BulkTest)
+{
+    ConcurrentQueue<int> queue;
+    auto producer = queue.make_producer();
+
+    // Crosses several segment boundaries
+    std::vector<int> input(5000);
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = static_cast<int>(i);
+    producer.enqueue_bulk(input.begin(), input.end());
+    ASSERT_EQ(queue.size(), input.size());
+
+    std::vector<int> output;
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 1234), 1234);
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 10000), input.size() - 1234);
+    ASSERT_EQ(output, input);
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 1), 0);
+}
+
+TEST(ConcurrentQueueTest, ProducersTest)
+{
+    ConcurrentQueue<int> queue;
+    {
+        auto first = queue.make_producer();
+        auto second = queue.make_producer();
+        first.enqueue(1);
+        second.enqueue(2);
+        first.enqueue(3);
+    }
+
+    // Sub-queue of destroyed producer is reused and keeps its values
+    auto reused = queue.make_producer();
+    reused.enqueue(4);
+
+    std::vector<int> output;
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 10), 4);
+    std::vector<int> first_order;
+    for (int value : output)
+        if (value == 1 || value == 3)
+            first_order.push_back(value);
+    ASSERT_EQ(first_order, (std::vector<int> {1, 3}));
+    std::sort(output.begin(), output.end());
+    ASSERT_EQ(output, (std::vector<int> {1, 2, 3, 4}));
+}
+
+TEST(ConcurrentQueueTest, RecycleTest)
+{
+    ConcurrentQueue<int> queue;
+    auto producer = queue.make_producer();
+
+    int batch[100];
+    for (int i = 0; i < 100; i++)
+        batch[i] = i;
+    // Drained segment is recycled once consumer moves past it, so warm-up spans several segments
+    for (int round = 0; round < 100; round++)
+    {
+        producer.enqueue_bulk(batch, batch + 100);
+        ASSERT_EQ(queue.try_dequeue_bulk(batch, 100), 100);
+    }
+    size_t capacity = queue.capacity();
+
+    for (int round = 0; round < 10000; round++)
+    {
+        producer.enqueue_bulk(batch, batch + 100);
+        ASSERT_EQ(queue.try_dequeue_bulk(batch, 100), 100);
+    }
+    ASSERT_EQ(queue.capacity(), capacity);
+}
+
+TEST(ConcurrentQueueTest, ConcurrentTest)
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 50000;
+    ConcurrentQueue<int> queue;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue, p]() {
+            auto producer = queue.make_producer();
+            int batch[5];
+            int next = 0;
+            while (next < per_producer)
+            {
+                if (next % 2 == 0)
+                {
+                    producer.enqueue(p * per_producer + next);
+                    next++;
+                    continue;
+                }
+                int batch_size = std::min(5, per_producer - next);
+                for (int i = 0; i < batch_size; i++)
+                    batch[i] = p * per_producer + next + i;
+                producer.enqueue_bulk(batch, batch + batch_size);
+                next += batch_size;
+            }
+        });
+    }
+
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<int> order_errors { 0 };
+    std::atomic<int> remaining { producers * per_producer };
+    for (int c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&, c]() {
+            std::vector<int> last(producers, -1);
+            int batch[3];
+            while (remaining.load() > 0)
+            {
+                size_t popped = 0;
+                if (c % 2 == 0)
+                    popped = queue.try_dequeue_bulk(batch, 3);
+                else if (queue.try_dequeue(batch[0]))
+                    popped = 1;
+                if (popped == 0)
+                    std::this_thread::yield();
+                for (size_t i = 0; i < popped; i++)
+                {
+                    int producer = batch[i] / per_producer;
+                    if (batch[i] <= last[producer])
+                        order_errors++;
+                    last[producer] = batch[i];
+                    seen[batch[i]]++;
+                }
+                remaining -= static_cast<int>(popped);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(order_errors.load(), 0);
+    for (auto& count : seen)
+        ASSERT_EQ(count.load(), 1);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(ConcurrentQueueTest, RegisterWhileDequeueTest)
+{
+    // Consumers move the hint to sub-queues registered after other consumers took their
+    // snapshot of the list, and every walk must still end on an empty queue
+    const int registrations = 2000;
+    const int consumers = 4;
+    ConcurrentQueue<int> queue;
+
+    std::atomic<bool> done { false };
+    std::atomic<int> received { 0 };
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&]() {
+            int value;
+            while (!done.load() || received.load() < registrations)
+            {
+                if (queue.try_dequeue(value))
+                    received++;
+            }
+        });
+    }
+
+    std::vector<ConcurrentQueue<int>::Producer> producers;
+    for (int i = 0; i < registrations; i++)
+    {
+        producers.push_back(queue.make_producer());
+        producers.back().enqueue(i);
+    }
+    done = true;
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(received.load(), registrations);
+    int value;
+    ASSERT_FALSE(queue.try_dequeue(value));
+}
+
+TEST(ConcurrentQueueTest, AlignedNewTest)
+{
+    // Sub-queues are allocated this way to keep their cache line alignment
+    struct alignas(CppADS::CacheLineSize) Line
+    {
+        int value { 7 };
+    };
+    for (size_t count = 1; count <= 3; count++)
+    {
+        Line* lines = CppADS::aligned_new<Line>(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(lines + i) % CppADS::CacheLineSize, 0);
+            ASSERT_EQ(lines[i].value, 7);
+        }
+        CppADS::aligned_delete(lines);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "concurrent_stack.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using CppADS::ConcurrentStack;
+
+TEST(ConcurrentStackTest, ConstructTest)
+{
+    ConcurrentStack<int> stack;
+    ASSERT_TRUE(stack.empty());
+    ASSERT_EQ(stack.capacity(), 0);
+
+    int value;
+    ASSERT_FALSE(stack.try_pop(value));
+}
+
+TEST(ConcurrentStackTest, ModifyTest)
+{
+    ConcurrentStack<std::string> stack;
+    stack.push("a");
+    std::string value = "b";
+    stack.push(value);
+    stack.emplace(2, 'c');
+    ASSERT_FALSE(stack.empty());
+
+    const char* expected[] = {"cc", "b", "a"};
+    for (const char* item : expected)
+    {
+        ASSERT_TRUE(stack.try_pop(value));
+        ASSERT_EQ(value, item);
+    }
+    ASSERT_FALSE(stack.try_pop(value));
+    ASSERT_TRUE(stack.empty());
+}
+
+TEST(ConcurrentStackTest, PopAllTest)
+{
+    ConcurrentStack<int> stack;
+    std::vector<int> output;
+    ASSERT_EQ(stack.pop_all(std::back_inserter(output)), 0);
+
+    for (int i = 0; i < 1000; i++)
+        stack.push(i);
+    ASSERT_EQ(stack.pop_all(std::back_inserter(output)), 1000);
+    ASSERT_TRUE(stack.empty());
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(output[i], 999 - i);
+
+    // Nodes of detached chain are reused
+    for (int i = 0; i < 1000; i++)
+        stack.push(i);
+    ASSERT_EQ(stack.capacity(), 1000);
+}
+
+TEST(ConcurrentStackTest, RecycleTest)
+{
+    ConcurrentStack<int> stack;
+    int value;
+    for (int round = 0; round < 10000; round++)
+    {
+        stack.push(round);
+        stack.push(round);
+        ASSERT_TRUE(stack.try_pop(value));
+        ASSERT_TRUE(stack.try_pop(value));
+    }
+    ASSERT_EQ(stack.capacity(), 2);
+}
+
+TEST(ConcurrentStackTest, ConcurrentTest)
+{
+    const int threads_count = 4;
+    const int per_thread = 50000;
+    ConcurrentStack<int> stack;
+
+    std::vector<std::atomic<int>> popped(threads_count * per_thread);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            std::vector<int> drained;
+            int value;
+            for (int i = 0; i < per_thread; i++)
+            {
+                stack.push(t * per_thread + i);
+                if (i % 2 == 0 && stack.try_pop(value))
+                    popped[value]++;
+                if (i % 1000 == 999)
+                {
+                    drained.clear();
+                    stack.pop_all(std::back_inserter(drained));
+                    for (int item : drained)
+                        popped[item]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    int value;
+    while (stack.try_pop(value))
+        popped[value]++;
+    for (auto& count : popped)
+        ASSERT_EQ(count.load(), 1);
+    ASSERT_LE(stack.capacity(), static_cast<size_t>(threads_count * per_thread));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -59,6 +59,125 @@ TEST(DequeTest, ModifyTest)
     ASSERT_EQ(deque.back(), 76);
 }
 
+TEST(DequeTest, AccessTest)
+{
+    Deque<int> deque;
+    for (int i = 0; i < 5000; i++)
+    {
+        deque.push_back(i);
+        deque.push_front(-i - 1);
+    }
+
+    ASSERT_EQ(deque.size(), 10000);
+    for (size_t i = 0; i < deque.size(); i++)
+        ASSERT_EQ(deque[i], static_cast<int>(i) - 5000);
+
+    deque[42] = 42;
+    ASSERT_EQ(deque[42], 42);
+    ASSERT_THROW(deque[10000], std::out_of_range);
+
+    const Deque<int>& const_deque = deque;
+    ASSERT_EQ(const_deque.front(), -5000);
+    ASSERT_EQ(const_deque.back(), 4999);
+}
+
+TEST(DequeTest, IteratorsTest)
+{
+    Deque<int> deque;
+    for (int i = 0; i < 1000; i++)
+        deque.push_back(i);
+
+    int value = 0;
+    for (auto it = deque.begin(); it != deque.end(); ++it, value++)
+        ASSERT_EQ(*it, value);
+
+    value = 999;
+    for (auto it = deque.crbegin(); it != deque.crend(); ++it, value--)
+        ASSERT_EQ(*it, value);
+
+    auto it = deque.begin() + 500;
+    ASSERT_EQ(*it, 500);
+    ASSERT_EQ(it[10], 510);
+    ASSERT_EQ(deque.end() - it, 500);
+    it -= 100;
+    ASSERT_EQ(*it, 400);
+    ASSERT_TRUE(deque.begin() < it);
+}
+
+TEST(DequeTest, CapacityTest)
+{
+    Deque<int> deque;
+    for (int i = 0; i < 10000; i++)
+        deque.push_back(i);
+    ASSERT_GE(deque.capacity(), 10000);
+
+    size_t capacity = 0;
+    for (int round = 0; round < 100000; round++)
+    {
+        deque.push_back(round);
+        deque.pop_front();
+        if (round == 50000)
+            capacity = deque.capacity();
+    }
+    ASSERT_EQ(deque.size(), 10000);
+    ASSERT_EQ(deque.capacity(), capacity);
+
+    while (deque.size() != 0)
+        deque.pop_back();
+    ASSERT_THROW(deque.pop_front(), std::out_of_range);
+
+    deque.shrink_to_fit();
+    ASSERT_EQ(deque.capacity(), 0);
+
+    deque.clear();
+    deque.push_front(1);
+    ASSERT_EQ(deque.front(), 1);
+}
+
+TEST(DequeTest, NoDefaultTest)
+{
+    // Values without default constructor, every constructed one must be destroyed
+    struct Item
+    {
+        explicit Item(int value, int& alive) : value(value), alive(&alive) { alive++; }
+        Item(const Item& copy) : value(copy.value), alive(copy.alive) { (*alive)++; }
+        ~Item() { (*alive)--; }
+        Item& operator=(const Item&) = default;
+
+        int value;
+        int* alive;
+    };
+
+    int alive = 0;
+    {
+        // Spans several blocks in both directions
+        Deque<Item> deque;
+        for (int i = 0; i < 300; i++)
+        {
+            deque.push_back(Item(i, alive));
+            deque.push_front(Item(-i, alive));
+        }
+        ASSERT_EQ(alive, 600);
+        ASSERT_EQ(deque.front().value, -299);
+        ASSERT_EQ(deque.back().value, 299);
+
+        for (int i = 0; i < 150; i++)
+        {
+            deque.pop_back();
+            deque.pop_front();
+        }
+        ASSERT_EQ(alive, 300);
+
+        Deque<Item> copy(deque);
+        ASSERT_EQ(alive, 600);
+        copy = std::move(deque);
+        ASSERT_EQ(alive, 300);
+        ASSERT_EQ(copy.size(), 300);
+        ASSERT_EQ(copy[0].value, -149);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
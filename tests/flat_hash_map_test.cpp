@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "flat_hash_map.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using CppADS::FlatHashMap;
+
+/// Hash with many collisions, all keys share few probe sequences and H2 values
+struct CollidingHash
+{
+    size_t operator()(int key) const {
+        return static_cast<size_t>(key % 5);
+    }
+};
+
+TEST (FlatHashMapTest, ContructTest)
+{
+    FlatHashMap<int, int> empty;
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_EQ(empty.begin(), empty.end());
+    ASSERT_EQ(empty.find(1), empty.end());
+    ASSERT_FALSE(empty.remove(1));
+
+    std::initializer_list<std::pair<std::string, int>> init_list {
+        {"111", 1}, {"222", 2}, {"333", 3}, {"444", 4}, {"555", 5}, {"666", 6}, {"777", 7}, {"888", 8}, {"999", 9}, {"000", 0}};
+
+    FlatHashMap<std::string, int> hash_init (init_list);
+    ASSERT_EQ(hash_init.size(), init_list.size());
+
+    FlatHashMap<std::string, int> hash_copy(hash_init);
+    ASSERT_EQ(hash_init, hash_copy);
+
+    FlatHashMap<std::string, int> hash_move(std::move(hash_init));
+    ASSERT_EQ(hash_copy, hash_move);
+    ASSERT_EQ(hash_init.size(), 0);
+}
+
+TEST (FlatHashMapTest, AssignTest)
+{
+    FlatHashMap<std::string, int> hash_init {{"aaa", 101}, {"bbb", 202}, {"ccc", 303}, {"ddd", 404},
+                                             {"eee", 505}, {"fff", 606}, {"ggg", 707}, {"hhh", 808}};
+
+    FlatHashMap<std::string, int> hash_copy;
+    hash_copy = hash_init;
+    ASSERT_EQ(hash_init, hash_copy);
+
+    FlatHashMap<std::string, int> hash_move;
+    hash_move = std::move(hash_init);
+    ASSERT_EQ(hash_copy, hash_move);
+    ASSERT_EQ(hash_init.size(), 0);
+}
+
+TEST (FlatHashMapTest, IteratorTest)
+{
+    FlatHashMap<int, int> hash;
+    for (int i = 0; i < 100; i++)
+        hash.insert({i, i * i});
+
+    int count = 0;
+    long long sum = 0;
+    for (auto it = hash.begin(); it != hash.end(); it++)
+    {
+        ASSERT_EQ(it->second, it->first * it->first);
+        (*it).second = 0;
+        sum += it->first;
+        count++;
+    }
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 4950);
+
+    const auto& const_hash = hash;
+    for (auto it = const_hash.cbegin(); it != const_hash.cend(); ++it)
+        ASSERT_EQ(it->second, 0);
+}
+
+TEST (FlatHashMapTest, AccessTest)
+{
+    FlatHashMap<char, int> hash {{'a', 101}, {'b', 202}, {'c', 303}};
+
+    ASSERT_EQ(hash['a'], 101);
+    ASSERT_EQ(hash['n'], int());
+    ASSERT_EQ(hash.size(), 4);
+
+    hash['i'] = 111;
+    ASSERT_EQ(hash['i'], 111);
+    ASSERT_EQ(*(hash.find('c')), decltype(hash)::value_type({'c', 303}));
+
+    // Const access doesn't insert
+    const auto& const_hash = hash;
+    ASSERT_EQ(const_hash['b'], 202);
+    ASSERT_THROW(const_hash['z'], std::out_of_range);
+    ASSERT_EQ(const_hash.find('z'), const_hash.end());
+}
+
+TEST (FlatHashMapTest, InsertTest)
+{
+    FlatHashMap<char, int> hash {{'a', 1}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}};
+
+    hash.insert({'R', 501});
+    std::pair<char, int> pair {'a', 10000};
+    hash.insert(pair);
+    pair = std::make_pair('v', 5);
+    hash.insert(std::move(pair));
+
+    ASSERT_EQ(hash, decltype(hash)({{'a', 10000}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}, {'R', 501}, {'v', 5}}));
+    ASSERT_EQ(hash.size(), 8);
+}
+
+TEST (FlatHashMapTest, RemoveTest)
+{
+    FlatHashMap<char, int> hash {{'a', 1}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}, {'R', 501}, {'j', 10000}, {'v', 5}};
+    ASSERT_TRUE(hash.remove('y'));
+    ASSERT_TRUE(hash.remove('b'));
+    ASSERT_TRUE(hash.remove('j'));
+    ASSERT_FALSE(hash.remove('j'));
+
+    ASSERT_EQ(hash, decltype(hash)({{'a', 1}, {'c', 3}, {'x', 100}, {'z', 300}, {'R', 501}, {'v', 5}}));
+    ASSERT_EQ(hash.size(), 6);
+
+    hash.clear();
+    ASSERT_EQ(hash.size(), 0);
+    ASSERT_EQ(hash.begin(), hash.end());
+}
+
+TEST (FlatHashMapTest, CapacityTest)
+{
+    FlatHashMap<int, int> hash;
+    ASSERT_THROW(hash.set_load_factor(1.0f), std::invalid_argument);
+    hash.set_load_factor(0.5f);
+    hash.reserve(1000);
+    size_t buckets = hash.bucket_count();
+    ASSERT_GE(buckets * 0.5f, 1000);
+
+    for (int i = 0; i < 1000; i++)
+        hash.insert({i, i});
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    ASSERT_LE(hash.load_factor(), 0.5f);
+
+    // Raising the limit doesn't shrink the table, lowering it grows the table
+    hash.set_load_factor(0.9f);
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    hash.set_load_factor(0.25f);
+    ASSERT_GT(hash.bucket_count(), buckets);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(hash[i], i);
+}
+
+TEST (FlatHashMapTest, SmallLoadFactorTest)
+{
+    // Smallest table has no room at this load factor, growth takes several doublings
+    FlatHashMap<int, int> hash;
+    hash.set_load_factor(0.02f);
+    for (int i = 0; i < 100; i++)
+        hash.insert({i, i});
+    ASSERT_EQ(hash.size(), 100);
+    ASSERT_LE(hash.load_factor(), 0.02f);
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(hash.find(i)->second, i);
+}
+
+TEST (FlatHashMapTest, TombstoneTest)
+{
+    // Insert and remove cycles leave tombstones, the table is cleaned without growing
+    FlatHashMap<int, int> hash;
+    hash.reserve(100);
+    size_t buckets = hash.bucket_count();
+    for (int i = 0; i < 100000; i++)
+    {
+        hash.insert({i, i});
+        if (i >= 50)
+        {
+            ASSERT_TRUE(hash.remove(i - 50));
+        }
+    }
+    ASSERT_EQ(hash.size(), 50);
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    for (int i = 100000 - 50; i < 100000; i++)
+        ASSERT_EQ(hash.find(i)->second, i);
+}
+
+TEST (FlatHashMapTest, CollisionTest)
+{
+    FlatHashMap<int, int, CollidingHash> hash;
+    std::unordered_map<int, int> expected;
+    std::mt19937 random(13);
+    for (int step = 0; step < 20000; step++)
+    {
+        int key = random() % 300;
+        if (random() % 3 == 0)
+        {
+            ASSERT_EQ(hash.remove(key), expected.erase(key) == 1);
+        }
+        else
+        {
+            hash.insert({key, step});
+            expected[key] = step;
+        }
+    }
+
+    ASSERT_EQ(hash.size(), expected.size());
+    for (const auto& item : expected)
+        ASSERT_EQ(hash.find(item.first)->second, item.second);
+    for (int key = 300; key < 400; key++)
+        ASSERT_EQ(hash.find(key), hash.end());
+}
+
+TEST (FlatHashMapTest, StringKeyTest)
+{
+    FlatHashMap<std::string, size_t> hash;
+    std::unordered_map<std::string, size_t> expected;
+    std::mt19937 random(29);
+    for (size_t step = 0; step < 50000; step++)
+    {
+        std::string key = "session/" + std::to_string(random() % 20000);
+        if (random() % 4 == 0)
+        {
+            ASSERT_EQ(hash.remove(key), expected.erase(key) == 1);
+        }
+        else
+        {
+            hash[key] = step;
+            expected[key] = step;
+        }
+    }
+
+    ASSERT_EQ(hash.size(), expected.size());
+    size_t count = 0;
+    for (const auto& item : hash)
+    {
+        ASSERT_EQ(expected.at(item.first), item.second);
+        count++;
+    }
+    ASSERT_EQ(count, expected.size());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
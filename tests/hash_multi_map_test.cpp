@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "hash_multi_map.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using CppADS::HashMultiMap;
+
+/// Values of the key in ascending order
+template<typename Map>
+static std::vector<typename Map::mapped_type> values_of(const Map& map, const typename Map::key_type& key)
+{
+    std::vector<typename Map::mapped_type> values;
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        EXPECT_EQ(it->first, key);
+        values.push_back(it->second);
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+TEST (HashMultiMapTest, ContructTest)
+{
+    HashMultiMap<int, int> empty;
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_EQ(empty.begin(), empty.end());
+    ASSERT_EQ(empty.count(1), 0);
+
+    HashMultiMap<int, int> map { {1, 10}, {2, 20}, {1, 11} };
+    ASSERT_EQ(map.size(), 3);
+    ASSERT_EQ(map.count(1), 2);
+
+    HashMultiMap<int, int> copy(map);
+    ASSERT_EQ(copy, map);
+    HashMultiMap<int, int> moved(std::move(copy));
+    ASSERT_EQ(moved, map);
+    copy.insert({3, 30});
+    ASSERT_EQ(copy.size(), 1);
+}
+
+TEST (HashMultiMapTest, ModifyTest)
+{
+    HashMultiMap<std::string, int> map;
+    auto first = map.insert({"a", 1});
+    ASSERT_EQ(first->first, "a");
+    ASSERT_EQ(first->second, 1);
+    map.insert(std::make_pair(std::string("a"), 2));
+    map.emplace("b", 3);
+    map.emplace("a", 1);
+    ASSERT_EQ(map.size(), 4);
+    ASSERT_EQ(values_of(map, "a"), (std::vector<int> { 1, 1, 2 }));
+    ASSERT_EQ(values_of(map, "b"), (std::vector<int> { 3 }));
+    ASSERT_TRUE(values_of(map, "c").empty());
+
+    auto range = map.equal_range("b");
+    range.first->second = 4;
+    ASSERT_EQ(map.find("b")->second, 4);
+    ASSERT_EQ(map.find("c"), map.end());
+
+    ASSERT_EQ(map.remove("a"), 3);
+    ASSERT_EQ(map.remove("a"), 0);
+    ASSERT_FALSE(map.contains("a"));
+    ASSERT_TRUE(map.contains("b"));
+    ASSERT_EQ(map.size(), 1);
+
+    map.clear();
+    ASSERT_EQ(map.begin(), map.end());
+    ASSERT_THROW(map.set_load_factor(-1.0f), std::invalid_argument);
+}
+
+TEST (HashMultiMapTest, GrowthTest)
+{
+    // Equal keys stay adjacent through every rehash
+    HashMultiMap<int, int> map;
+    for (int value = 0; value < 8; value++)
+    {
+        for (int key = 0; key < 1000; key++)
+            map.insert({key, value});
+    }
+    ASSERT_EQ(map.size(), 8000);
+    std::vector<int> expected { 0, 1, 2, 3, 4, 5, 6, 7 };
+    for (int key = 0; key < 1000; key++)
+        ASSERT_EQ(values_of(map, key), expected);
+
+    for (int key = 0; key < 1000; key += 2)
+        ASSERT_EQ(map.remove(key), 8);
+    ASSERT_EQ(map.size(), 4000);
+    ASSERT_EQ(static_cast<size_t>(std::distance(map.cbegin(), map.cend())), map.size());
+}
+
+TEST (HashMultiMapTest, IncrementalRehashTest)
+{
+    HashMultiMap<int, int, std::hash<int>, std::equal_to<int>, CppADS::MaskReduction, true> map;
+    map.set_rehash_step(1);
+    for (int i = 0; i < 4000; i++)
+    {
+        map.insert({i % 500, i});
+        if (i % 500 == 0)
+        {
+            ASSERT_EQ(map.count(i % 500), static_cast<size_t>(i / 500 + 1));
+        }
+    }
+    for (int key = 0; key < 500; key++)
+    {
+        std::vector<int> values = values_of(map, key);
+        ASSERT_EQ(values.size(), 8);
+        for (size_t i = 0; i < values.size(); i++)
+            ASSERT_EQ(values[i], key + static_cast<int>(i) * 500);
+    }
+}
+
+TEST (HashMultiMapTest, CompareTest)
+{
+    HashMultiMap<int, int> lhs { {1, 1}, {1, 2}, {2, 3} };
+    HashMultiMap<int, int> rhs { {2, 3}, {1, 2}, {1, 1} };
+    ASSERT_EQ(lhs, rhs);
+    rhs.insert({1, 1});
+    ASSERT_NE(lhs, rhs);
+    lhs.insert({1, 2});
+    ASSERT_NE(lhs, rhs);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
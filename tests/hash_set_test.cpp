@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "hash_set.hpp"
+#include "string_hash.hpp"
+
+#include <set>
+#include <string>
+#include <vector>
+
+using CppADS::HashSet;
+
+TEST (HashSetTest, ContructTest)
+{
+    HashSet<int> empty;
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_EQ(empty.begin(), empty.end());
+    ASSERT_FALSE(empty.contains(1));
+
+    HashSet<int> set { 1, 2, 3, 2, 1 };
+    ASSERT_EQ(set.size(), 3);
+
+    HashSet<int> copy(set);
+    ASSERT_EQ(copy, set);
+
+    HashSet<int> moved(std::move(copy));
+    ASSERT_EQ(moved, set);
+    ASSERT_TRUE(copy.insert(4).second);
+    ASSERT_EQ(copy.size(), 1);
+}
+
+TEST (HashSetTest, ModifyTest)
+{
+    HashSet<std::string> set;
+    auto inserted = set.insert("a");
+    ASSERT_TRUE(inserted.second);
+    ASSERT_EQ(*inserted.first, "a");
+    inserted = set.insert(std::string("a"));
+    ASSERT_FALSE(inserted.second);
+    ASSERT_EQ(*inserted.first, "a");
+    ASSERT_TRUE(set.emplace(3, 'b').second);
+    ASSERT_FALSE(set.emplace("bbb").second);
+    ASSERT_EQ(set.size(), 2);
+
+    ASSERT_EQ(*set.find("bbb"), "bbb");
+    ASSERT_EQ(set.find("c"), set.end());
+
+    ASSERT_TRUE(set.remove("a"));
+    ASSERT_FALSE(set.remove("a"));
+    ASSERT_FALSE(set.contains("a"));
+    ASSERT_EQ(set.size(), 1);
+
+    set.clear();
+    ASSERT_EQ(set.size(), 0);
+    ASSERT_TRUE(set.insert("a").second);
+    ASSERT_THROW(set.set_load_factor(0.0f), std::invalid_argument);
+}
+
+TEST (HashSetTest, GrowthTest)
+{
+    HashSet<int> set;
+    std::vector<int> keys;
+    for (int i = 0; i < 10000; i++)
+        keys.push_back(i * 7);
+    set.insert(keys.begin(), keys.end());
+    ASSERT_EQ(set.size(), 10000);
+    ASSERT_GE(set.bucket_count(), 10000);
+    ASSERT_LE(set.load_factor(), set.max_load_factor());
+
+    for (int i = 0; i < 10000; i += 2)
+        ASSERT_TRUE(set.remove(i * 7));
+    std::set<int> visited(set.begin(), set.end());
+    ASSERT_EQ(visited.size(), 5000);
+    for (int i = 0; i < 10000; i++)
+        ASSERT_EQ(set.contains(i * 7), i % 2 == 1);
+}
+
+TEST (HashSetTest, IncrementalRehashTest)
+{
+    HashSet<int, std::hash<int>, std::equal_to<int>, CppADS::MaskReduction, true> set;
+    set.set_rehash_step(1);
+    bool rehashed = false;
+    for (int i = 0; i < 3000; i++)
+    {
+        ASSERT_TRUE(set.insert(i).second);
+        rehashed = rehashed || set.rehashing();
+        if (i % 3 == 0)
+        {
+            ASSERT_TRUE(set.remove(i / 3));
+        }
+    }
+    ASSERT_TRUE(rehashed);
+    for (int i = 0; i < 3000; i++)
+        ASSERT_EQ(set.contains(i), i >= 1000);
+    ASSERT_EQ(static_cast<size_t>(std::distance(set.begin(), set.end())), set.size());
+}
+
+TEST (HashSetTest, TransparentTest)
+{
+    HashSet<std::string, CppADS::StringHash, CppADS::StringEqual> set { "alpha", "beta" };
+    ASSERT_TRUE(set.contains("alpha"));
+    ASSERT_EQ(*set.find("beta"), "beta");
+    ASSERT_TRUE(set.remove("alpha"));
+    ASSERT_FALSE(set.contains("alpha"));
+}
+
+TEST (HashSetTest, SetOperationsTest)
+{
+    HashSet<int> small { 1, 2, 3, 4 };
+    HashSet<int> large;
+    for (int i = 3; i < 100; i++)
+        large.insert(i);
+
+    HashSet<int> both = CppADS::unite(small, large);
+    ASSERT_EQ(both.size(), 99);
+    ASSERT_EQ(both, CppADS::unite(large, small));
+    for (int i = 1; i < 100; i++)
+        ASSERT_TRUE(both.contains(i));
+
+    HashSet<int> common = CppADS::intersect(small, large);
+    ASSERT_EQ(common, (HashSet<int> { 3, 4 }));
+    ASSERT_EQ(common, CppADS::intersect(large, small));
+
+    ASSERT_EQ(CppADS::difference(small, large), (HashSet<int> { 1, 2 }));
+    HashSet<int> rest = CppADS::difference(large, small);
+    ASSERT_EQ(rest.size(), 95);
+    ASSERT_FALSE(rest.contains(3));
+    ASSERT_FALSE(rest.contains(4));
+    ASSERT_TRUE(rest.contains(5));
+
+    HashSet<int> empty;
+    ASSERT_EQ(CppADS::unite(small, empty), small);
+    ASSERT_EQ(CppADS::intersect(small, empty).size(), 0);
+    ASSERT_EQ(CppADS::difference(small, empty), small);
+    ASSERT_EQ(CppADS::difference(empty, small).size(), 0);
+}
+
+TEST (HashSetTest, CompareTest)
+{
+    HashSet<int> lhs { 1, 2, 3 };
+    HashSet<int> rhs { 3, 2, 1 };
+    ASSERT_EQ(lhs, rhs);
+    rhs.remove(3);
+    ASSERT_NE(lhs, rhs);
+    rhs.insert(4);
+    ASSERT_NE(lhs, rhs);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,11 +1,57 @@
 #include <gtest/gtest.h>
 #include "hash_table.hpp"
+#include "string_hash.hpp"
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 using CppADS::HashTable;
 
 enum class TestEnum : uint8_t {
     A = 0x1, B = 0x2, C = 0x4, D = 0x8, E = 0x10, F = 0x20, G = 0x40, H = 0x80, I, J, None = 0x0, Last = 0xFF
 };
 
+/// Case-insensitive hash and equality of ASCII strings
+struct NoCaseHash
+{
+    size_t operator()(const std::string& key) const {
+        std::string lower(key);
+        for (auto& symbol : lower)
+            symbol = static_cast<char>(std::tolower(symbol));
+        return std::hash<std::string>{}(lower);
+    }
+};
+
+/// Hash which counts its calls
+struct CountingHash
+{
+    static size_t calls;
+
+    size_t operator()(int key) const {
+        calls++;
+        return std::hash<int>{}(key);
+    }
+};
+
+size_t CountingHash::calls = 0;
+
+struct NoCaseEqual
+{
+    bool operator()(const std::string& lhs, const std::string& rhs) const {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (size_t i = 0; i < lhs.size(); i++)
+        {
+            if (std::tolower(lhs[i]) != std::tolower(rhs[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
 TEST (HashTableTest, ContructTest)
 {
     HashTable<int, int> empty;
@@ -42,11 +88,28 @@ TEST (HashTableTest, AssignTest)
 
 }
 
-/*
-/// \todo Implement this test case
 TEST (HashTableTest, IteratorTest)
-{}
-*/
+{
+    HashTable<int, int> hash;
+    for (int i = 0; i < 100; i++)
+        hash.insert({i, i * i});
+
+    int count = 0;
+    long long sum = 0;
+    for (auto it = hash.begin(); it != hash.end(); it++)
+    {
+        ASSERT_EQ(it->second, it->first * it->first);
+        (*it).second = 0;
+        sum += it->first;
+        count++;
+    }
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 4950);
+
+    const auto& const_hash = hash;
+    for (auto it = const_hash.cbegin(); it != const_hash.cend(); ++it)
+        ASSERT_EQ(it->second, 0);
+}
 
 TEST (HashTableTest, FindTest)
 {
@@ -65,6 +128,10 @@ TEST (HashTableTest, AccessTest)
     ASSERT_EQ(hash[TestEnum::A], 101);
     ASSERT_EQ(hash[TestEnum::None], int());
 
+    const auto& const_hash = hash;
+    ASSERT_EQ(const_hash[TestEnum::B], 202);
+    ASSERT_THROW(const_hash[TestEnum::J], std::out_of_range);
+
     hash[TestEnum::I] = 111;
     ASSERT_EQ(hash[TestEnum::I], 111);
     hash[TestEnum::F] = 0xFFFF;
@@ -90,12 +157,60 @@ TEST (HashTableTest, InsertTest)
     ASSERT_EQ(hash.size(), 8);
 }
 
+TEST (HashTableTest, EmplaceTest)
+{
+    HashTable<std::string, std::string> hash;
+    auto inserted = hash.insert({"a", "first"});
+    ASSERT_TRUE(inserted.second);
+    ASSERT_EQ(inserted.first->second, "first");
+    auto replaced = hash.insert({"a", "second"});
+    ASSERT_FALSE(replaced.second);
+    ASSERT_EQ(replaced.first, inserted.first);
+    ASSERT_EQ(hash["a"], "second");
+
+    auto emplaced = hash.emplace("b", "value");
+    ASSERT_TRUE(emplaced.second);
+    ASSERT_FALSE(hash.emplace("b", "other").second);
+    ASSERT_EQ(hash["b"], "value");
+
+    // Arguments of try_emplace are untouched when the key exists
+    std::string value = "moved";
+    ASSERT_FALSE(hash.try_emplace("b", std::move(value)).second);
+    ASSERT_EQ(value, "moved");
+    auto tried = hash.try_emplace("c", 3, 'x');
+    ASSERT_TRUE(tried.second);
+    ASSERT_EQ(tried.first->second, "xxx");
+
+    ASSERT_TRUE(hash.insert_or_assign("d", "new").second);
+    auto assigned = hash.insert_or_assign("d", std::string("assigned"));
+    ASSERT_FALSE(assigned.second);
+    ASSERT_EQ(assigned.first->second, "assigned");
+
+    std::string key = "e";
+    hash[std::move(key)] = "by rvalue key";
+    ASSERT_EQ(hash.find("e")->second, "by rvalue key");
+    ASSERT_EQ(hash.size(), 5);
+}
+
+TEST (HashTableTest, SingleHashTest)
+{
+    // Access to present and missing keys hashes the key once
+    HashTable<int, int, CountingHash> hash;
+    hash.reserve(100);
+    CountingHash::calls = 0;
+    for (int i = 0; i < 1000; i++)
+        hash[i % 100] += i;
+    ASSERT_EQ(CountingHash::calls, 1000);
+    ASSERT_EQ(hash[7], 7 + 107 + 207 + 307 + 407 + 507 + 607 + 707 + 807 + 907);
+}
+
 TEST (HashTableTest, RemoveTest)
 {
     HashTable<char, int> hash {{'a', 1}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}, {'R', 501}, {'j', 10000}, {'v', 5}};
     hash.remove('y');
     hash.remove('b');
     hash.remove('j');
+    hash.remove('j');
 
     ASSERT_EQ(hash, decltype(hash)({{'a', 1}, {'c', 3}, {'x', 100}, {'z', 300}, {'R', 501}, {'v', 5}}));
     ASSERT_EQ(hash.size(), 6);
@@ -106,11 +221,210 @@ TEST (HashTableTest, RemoveTest)
     ASSERT_EQ(hash.begin(), hash.end());
 }
 
-/*
-/// \todo Implement this test case
 TEST (HashTableTest, CapacityTest)
-{}
-*/
+{
+    HashTable<int, int> hash;
+    ASSERT_THROW(hash.set_load_factor(0.0f), std::invalid_argument);
+    hash.set_load_factor(0.5f);
+    hash.reserve(1000);
+    size_t buckets = hash.bucket_count();
+    ASSERT_EQ(buckets, 2048);
+
+    for (int i = 0; i < 1000; i++)
+        hash.insert({i, i});
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    ASSERT_LE(hash.load_factor(), 0.5f);
+
+    // Rehash rounds up to a power of two and never below the load factor limit
+    hash.rehash(5000);
+    ASSERT_EQ(hash.bucket_count(), 8192);
+    hash.rehash(1);
+    ASSERT_EQ(hash.bucket_count(), 2048);
+    hash.set_load_factor(2.0f);
+    hash.rehash(0);
+    ASSERT_EQ(hash.bucket_count(), 512);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(hash[i], i);
+
+    // Bulk insert sizes the table once
+    std::vector<std::pair<int, int>> items;
+    for (int i = 0; i < 10000; i++)
+        items.push_back({i, -i});
+    HashTable<int, int> bulk;
+    bulk.insert(items.begin(), items.end());
+    ASSERT_EQ(bulk.size(), items.size());
+    ASSERT_EQ(bulk.bucket_count(), 16384);
+    for (const auto& item : items)
+        ASSERT_EQ(bulk[item.first], item.second);
+}
+
+TEST (HashTableTest, HashPolicyTest)
+{
+    HashTable<std::string, int, NoCaseHash, NoCaseEqual> hash {{"Alpha", 1}, {"BETA", 2}};
+    hash.insert({"ALPHA", 10});
+    hash["gamma"] = 3;
+    ASSERT_EQ(hash.size(), 3);
+    ASSERT_EQ(hash["alpha"], 10);
+    ASSERT_EQ(hash.find("Beta")->second, 2);
+    hash.remove("GAMMA");
+    ASSERT_EQ(hash.find("gamma"), hash.end());
+
+    // Sequential keys spread over the whole power-of-two table
+    HashTable<int, int> sequential;
+    for (int i = 0; i < 4096; i++)
+        sequential.insert({i, i});
+    ASSERT_EQ(sequential.bucket_count(), 4096);
+}
+
+TEST (HashTableTest, FastRangeTest)
+{
+    HashTable<int, int, std::hash<int>, std::equal_to<int>, CppADS::FastRangeReduction> hash;
+    std::unordered_map<int, int> expected;
+    std::mt19937 random(7);
+    for (int step = 0; step < 20000; step++)
+    {
+        int key = random() % 500;
+        if (random() % 3 == 0)
+        {
+            hash.remove(key);
+            expected.erase(key);
+        }
+        else
+        {
+            hash.insert({key, step});
+            expected[key] = step;
+        }
+    }
+
+    ASSERT_EQ(hash.size(), expected.size());
+    for (const auto& item : expected)
+        ASSERT_EQ(hash.find(item.first)->second, item.second);
+    for (int key = 500; key < 600; key++)
+        ASSERT_EQ(hash.find(key), hash.end());
+}
+
+TEST (HashTableTest, IncrementalRehashTest)
+{
+    HashTable<int, int> hash;
+    hash.set_load_factor(2);
+    hash.set_rehash_step(1);
+    std::unordered_map<int, int> expected;
+    std::mt19937 random(19);
+    bool seen_rehashing = false;
+    for (int step = 0; step < 30000; step++)
+    {
+        int key = random() % 5000;
+        switch (random() % 4)
+        {
+        case 0:
+            hash.remove(key);
+            expected.erase(key);
+            break;
+        case 1:
+            ASSERT_EQ(hash.find(key) != hash.end(), expected.count(key) == 1);
+            break;
+        default:
+            hash[key] = step;
+            expected[key] = step;
+        }
+        seen_rehashing |= hash.rehashing();
+
+        if (step % 1000 == 0)
+        {
+            // Iteration and const lookup see items of both bucket arrays
+            const auto& const_hash = hash;
+            size_t count = 0;
+            for (auto it = const_hash.begin(); it != const_hash.end(); ++it, count++)
+                ASSERT_EQ(expected.at(it->first), it->second);
+            ASSERT_EQ(count, expected.size());
+            for (const auto& item : expected)
+                ASSERT_EQ(const_hash[item.first], item.second);
+
+            HashTable<int, int> copy(hash);
+            ASSERT_EQ(copy, hash);
+        }
+    }
+    ASSERT_TRUE(seen_rehashing);
+    ASSERT_EQ(hash.size(), expected.size());
+
+    // Switching to stop-the-world mode finishes rehashing
+    hash.set_rehash_step(0);
+    ASSERT_FALSE(hash.rehashing());
+    for (const auto& item : expected)
+        ASSERT_EQ(hash.find(item.first)->second, item.second);
+}
+
+TEST (HashTableTest, TransparentLookupTest)
+{
+    static_assert(CppADS::TransparentLookup<CppADS::StringHash, CppADS::StringEqual, const char*>::value, "transparent");
+    static_assert(!CppADS::TransparentLookup<std::hash<std::string>, std::equal_to<std::string>, const char*>::value, "not transparent");
+    ASSERT_EQ(CppADS::StringHash{}("some key"), CppADS::StringHash{}(std::string("some key")));
+
+    // C strings are used without temporary std::string
+    HashTable<std::string, int, CppADS::StringHash, CppADS::StringEqual> hash;
+    hash["one"] = 1;
+    hash["two"] = 2;
+    hash[std::string("a key longer than eight bytes")] = 3;
+    ASSERT_EQ(hash.size(), 3);
+    ASSERT_TRUE(hash.contains("one"));
+    ASSERT_TRUE(hash.contains(std::string("two")));
+    ASSERT_FALSE(hash.contains("three"));
+    ASSERT_EQ(hash.find("a key longer than eight bytes")->second, 3);
+    ASSERT_EQ(hash.find("a key longer than eight bytez"), hash.end());
+
+    const auto& const_hash = hash;
+    ASSERT_EQ(const_hash["two"], 2);
+    ASSERT_EQ(const_hash.find("one")->first, "one");
+    ASSERT_THROW(const_hash["three"], std::out_of_range);
+
+    hash["three"] += 3;
+    ASSERT_EQ(hash[std::string("three")], 3);
+    hash.remove("one");
+    hash.remove("missing");
+    ASSERT_EQ(hash.size(), 3);
+    ASSERT_FALSE(hash.contains("one"));
+}
+
+TEST (HashTableTest, StoredHashTest)
+{
+    // Growing the table reuses stored hashes
+    HashTable<int, int, CountingHash, std::equal_to<int>, CppADS::MaskReduction, true> hash;
+    CountingHash::calls = 0;
+    for (int i = 0; i < 1000; i++)
+        hash.insert({i, i});
+    ASSERT_EQ(CountingHash::calls, 1000);
+    hash.rehash(8192);
+    ASSERT_EQ(CountingHash::calls, 1000);
+
+    HashTable<int, int, CountingHash, std::equal_to<int>, CppADS::MaskReduction, true> copy(hash);
+    copy.rehash(16);
+    ASSERT_EQ(CountingHash::calls, 1000);
+    ASSERT_EQ(copy, hash);
+
+    // Stored hashes follow nodes through incremental rehashing and removal
+    HashTable<std::string, int, std::hash<std::string>, std::equal_to<std::string>, CppADS::FastRangeReduction, true> strings;
+    strings.set_rehash_step(2);
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 random(23);
+    for (int step = 0; step < 20000; step++)
+    {
+        std::string key = std::to_string(random() % 3000);
+        if (random() % 3 == 0)
+        {
+            strings.remove(key);
+            expected.erase(key);
+        }
+        else
+        {
+            strings[key] = step;
+            expected[key] = step;
+        }
+    }
+    ASSERT_EQ(strings.size(), expected.size());
+    for (const auto& item : expected)
+        ASSERT_EQ(strings.find(item.first)->second, item.second);
+    ASSERT_FALSE(strings.contains("3000"));
+}
 
 int main(int argc, char** argv)
 {
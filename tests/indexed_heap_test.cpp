@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "indexed_heap.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using CppADS::IndexedHeap;
+
+template<typename Heap>
+static std::vector<int> drain(Heap& heap)
+{
+    std::vector<int> result;
+    while (!heap.empty())
+    {
+        result.push_back(heap.top());
+        heap.pop();
+    }
+    return result;
+}
+
+TEST(IndexedHeapTest, ConstructTest)
+{
+    IndexedHeap<int> heap;
+    ASSERT_EQ(heap.size(), 0);
+    ASSERT_TRUE(heap.empty());
+    ASSERT_THROW(heap.top(), std::out_of_range);
+    ASSERT_THROW(heap.pop(), std::out_of_range);
+    ASSERT_FALSE(heap.contains(IndexedHeap<int>::handle_type()));
+
+    IndexedHeap<int, std::greater<int>> max_heap;
+    for (int value : {3, 7, 5})
+        max_heap.push(value);
+    ASSERT_EQ(max_heap.top(), 7);
+}
+
+TEST(IndexedHeapTest, ModifyTest)
+{
+    IndexedHeap<std::string> heap;
+    auto b = heap.push("b");
+    std::string value = "d";
+    auto d = heap.push(value);
+    auto a = heap.emplace(1, 'a');
+    ASSERT_EQ(heap.top(), "a");
+    ASSERT_EQ(heap.top_handle(), a);
+    ASSERT_EQ(heap.get(b), "b");
+    ASSERT_EQ(heap.get(d), "d");
+
+    heap.pop();
+    ASSERT_FALSE(heap.contains(a));
+    ASSERT_THROW(heap.get(a), std::out_of_range);
+
+    // Slot of removed item is reused, its old handle doesn't refer to the new item
+    auto c = heap.push("c");
+    ASSERT_NE(c, a);
+    ASSERT_FALSE(heap.contains(a));
+    ASSERT_THROW(heap.erase(a), std::out_of_range);
+    ASSERT_EQ(heap.get(c), "c");
+    ASSERT_EQ(heap.size(), 3);
+
+    heap.clear();
+    ASSERT_TRUE(heap.empty());
+    ASSERT_FALSE(heap.contains(b));
+    auto e = heap.push("e");
+    ASSERT_FALSE(heap.contains(b));
+    ASSERT_FALSE(heap.contains(c));
+    ASSERT_TRUE(heap.contains(e));
+}
+
+TEST(IndexedHeapTest, KeyTest)
+{
+    IndexedHeap<int> heap;
+    std::vector<IndexedHeap<int>::handle_type> handles;
+    for (int value : {50, 40, 30, 20, 10})
+        handles.push_back(heap.push(value));
+
+    heap.decrease_key(handles[0], 5);
+    ASSERT_EQ(heap.top_handle(), handles[0]);
+    heap.increase_key(handles[0], 45);
+    ASSERT_EQ(heap.top(), 10);
+    heap.update(handles[1], 1);
+    ASSERT_EQ(heap.top_handle(), handles[1]);
+    heap.update(handles[1], 100);
+    ASSERT_EQ(heap.get(handles[1]), 100);
+
+    ASSERT_THROW(heap.decrease_key(handles[2], 31), std::invalid_argument);
+    ASSERT_THROW(heap.increase_key(handles[2], 29), std::invalid_argument);
+
+    heap.erase(handles[3]);
+    ASSERT_THROW(heap.erase(handles[3]), std::out_of_range);
+    ASSERT_EQ(drain(heap), (std::vector<int> {10, 30, 45, 100}));
+}
+
+TEST(IndexedHeapTest, RandomTest)
+{
+    std::mt19937 random(7);
+    IndexedHeap<int, std::less<int>, 4> heap;
+    std::vector<decltype(heap)::handle_type> handles;
+    std::vector<int> values;
+    for (int i = 0; i < 2000; i++)
+    {
+        values.push_back(random() % 10000);
+        handles.push_back(heap.push(values.back()));
+    }
+    for (int i = 0; i < 3000; i++)
+    {
+        size_t index = random() % values.size();
+        if (i % 3 == 0)
+        {
+            heap.erase(handles[index]);
+            handles.erase(handles.begin() + index);
+            values.erase(values.begin() + index);
+        }
+        else
+        {
+            values[index] = random() % 10000;
+            heap.update(handles[index], values[index]);
+        }
+        ASSERT_EQ(heap.top(), *std::min_element(values.begin(), values.end()));
+    }
+    for (size_t i = 0; i < handles.size(); i++)
+        ASSERT_EQ(heap.get(handles[i]), values[i]);
+
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(drain(heap), values);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
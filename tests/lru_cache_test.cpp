@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include "lru_cache.hpp"
+using CppADS::LruCache;
+
+TEST(LruCacheTest, ConstructTest)
+{
+    LruCache<int, int> cache(4);
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.capacity(), 4);
+    ASSERT_EQ(cache.max_weight(), 4);
+    ASSERT_EQ(cache.get(1), nullptr);
+
+    ASSERT_THROW((LruCache<int, int>(0)), std::invalid_argument);
+
+    cache.put(1, 10);
+    cache.put(2, 20);
+
+    LruCache<int, int> cache_copy(cache);
+    ASSERT_EQ(cache_copy.size(), 2);
+    ASSERT_EQ(*cache_copy.get(1), 10);
+    ASSERT_EQ(*cache_copy.get(2), 20);
+}
+
+TEST(LruCacheTest, MoveTest)
+{
+    LruCache<int, int> cache(4);
+    cache.put(1, 10);
+    cache.put(2, 20);
+
+    LruCache<int, int> moved(std::move(cache));
+    ASSERT_EQ(moved.size(), 2);
+    ASSERT_EQ(*moved.get(1), 10);
+
+    // Moved-from cache is empty and has no room for entries
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.capacity(), 0);
+    ASSERT_EQ(cache.get(1), nullptr);
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_FALSE(cache.put(3, 30));
+    ASSERT_FALSE(cache.erase(1));
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+
+    cache = std::move(moved);
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(*cache.get(2), 20);
+    ASSERT_EQ(moved.size(), 0);
+    ASSERT_EQ(moved.peek(2), nullptr);
+}
+
+TEST(LruCacheTest, ModifyTest)
+{
+    LruCache<int, std::string> cache(3);
+
+    ASSERT_TRUE(cache.put(1, "one"));
+    ASSERT_TRUE(cache.put(2, "two"));
+    ASSERT_TRUE(cache.put(3, "three"));
+    ASSERT_FALSE(cache.put(2, "TWO"));
+    ASSERT_EQ(cache.size(), 3);
+    ASSERT_EQ(*cache.get(2), "TWO");
+
+    ASSERT_TRUE(cache.erase(2));
+    ASSERT_FALSE(cache.erase(2));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_EQ(cache.size(), 2);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_FALSE(cache.contains(1));
+    ASSERT_TRUE(cache.put(1, "one"));
+}
+
+TEST(LruCacheTest, EvictionTest)
+{
+    LruCache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+
+    ASSERT_NE(cache.get(1), nullptr);
+    cache.put(4, 4);
+
+    ASSERT_TRUE(cache.contains(1));
+    ASSERT_FALSE(cache.contains(2));
+    ASSERT_TRUE(cache.contains(3));
+    ASSERT_TRUE(cache.contains(4));
+    ASSERT_EQ(cache.evictions(), 1);
+
+    for (int i = 0; i < 1000; i++)
+        cache.put(i, i * 2);
+    ASSERT_EQ(cache.size(), 3);
+    ASSERT_EQ(*cache.peek(999), 1998);
+    ASSERT_EQ(*cache.peek(998), 1996);
+    ASSERT_EQ(*cache.peek(997), 1994);
+}
+
+TEST(LruCacheTest, WeightTest)
+{
+    LruCache<int, std::string> cache(16, 10, [](const int&, const std::string& value) { return value.size(); });
+
+    cache.put(1, "aaaa");
+    cache.put(2, "bbbb");
+    ASSERT_EQ(cache.weight(), 8);
+
+    cache.put(3, "cccc");
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.weight(), 8);
+    ASSERT_FALSE(cache.contains(1));
+
+    ASSERT_FALSE(cache.put(4, "this value is too heavy"));
+    ASSERT_FALSE(cache.contains(4));
+
+    cache.put(2, "b");
+    ASSERT_EQ(cache.weight(), 5);
+}
+
+namespace
+{
+    /// Value whose assignment throws on demand
+    struct ThrowingValue
+    {
+        static bool fail;
+        int value { 0 };
+
+        ThrowingValue() = default;
+        ThrowingValue(int init) : value(init) {}
+        ThrowingValue(const ThrowingValue&) = default;
+        ThrowingValue& operator=(const ThrowingValue& rhs) {
+            if (fail)
+                throw std::runtime_error("assignment failed");
+            value = rhs.value;
+            return *this;
+        }
+    };
+    bool ThrowingValue::fail = false;
+}
+
+TEST(LruCacheTest, ExceptionSafetyTest)
+{
+    LruCache<int, ThrowingValue> cache(3);
+    cache.put(1, ThrowingValue(1));
+    cache.put(2, ThrowingValue(2));
+
+    ThrowingValue::fail = true;
+    ASSERT_THROW(cache.put(1, ThrowingValue(10)), std::runtime_error);
+    ASSERT_THROW(cache.put(3, ThrowingValue(3)), std::runtime_error);
+    ThrowingValue::fail = false;
+
+    ASSERT_EQ(cache.size(), 2);
+    ASSERT_EQ(cache.weight(), 2);
+    ASSERT_FALSE(cache.contains(3));
+
+    // Recency list is intact: 1 is the oldest and goes first
+    cache.put(3, ThrowingValue(3));
+    cache.put(4, ThrowingValue(4));
+    ASSERT_FALSE(cache.contains(1));
+    ASSERT_EQ(cache.peek(2)->value, 2);
+    ASSERT_EQ(cache.peek(3)->value, 3);
+    ASSERT_EQ(cache.peek(4)->value, 4);
+    for (int i = 5; i < 100; i++)
+        cache.put(i, ThrowingValue(i));
+    ASSERT_EQ(cache.size(), 3);
+    ASSERT_EQ(cache.weight(), 3);
+}
+
+TEST(LruCacheTest, StatisticsTest)
+{
+    LruCache<int, int> cache(2);
+    cache.put(1, 1);
+    cache.get(1);
+    cache.get(1);
+    cache.get(2);
+    cache.put(2, 2);
+    cache.put(3, 3);
+
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.evictions(), 1);
+
+    cache.reset_stats();
+    ASSERT_EQ(cache.hits(), 0);
+    ASSERT_EQ(cache.misses(), 0);
+    ASSERT_EQ(cache.evictions(), 0);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
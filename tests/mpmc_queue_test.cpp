@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include "mpmc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using CppADS::MpmcQueue;
+
+TEST(MpmcQueueTest, ConstructTest)
+{
+    MpmcQueue<int> queue(5);
+    ASSERT_EQ(queue.capacity(), 8);
+    ASSERT_EQ(queue.size(), 0);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_THROW(MpmcQueue<int>(1), std::invalid_argument);
+}
+
+TEST(MpmcQueueTest, ModifyTest)
+{
+    MpmcQueue<std::string> queue(4);
+    ASSERT_TRUE(queue.try_enqueue("a"));
+    std::string value = "b";
+    ASSERT_TRUE(queue.try_enqueue(value));
+    queue.enqueue("c");
+    queue.enqueue(value);
+    ASSERT_FALSE(queue.try_enqueue("e"));
+    ASSERT_EQ(queue.size(), 4);
+
+    queue.dequeue(value);
+    ASSERT_EQ(value, "a");
+    ASSERT_TRUE(queue.try_enqueue("e"));
+
+    const char* expected[] = {"b", "c", "b", "e"};
+    for (const char* item : expected)
+    {
+        ASSERT_TRUE(queue.try_dequeue(value));
+        ASSERT_EQ(value, item);
+    }
+    ASSERT_FALSE(queue.try_dequeue(value));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, BulkTest)
+{
+    MpmcQueue<int> queue(8);
+    std::vector<int> input {0,1,2,3,4,5,6,7,8,9,10,11};
+    std::vector<int> output;
+
+    ASSERT_EQ(queue.try_enqueue_bulk(input.begin(), 5), 5);
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 3), 3);
+    ASSERT_EQ(output, (std::vector<int> {0, 1, 2}));
+
+    ASSERT_EQ(queue.try_enqueue_bulk(input.begin() + 5, 7), 6);
+    ASSERT_EQ(queue.size(), 8);
+    ASSERT_EQ(queue.try_enqueue_bulk(input.begin(), 1), 0);
+
+    output.clear();
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 12), 8);
+    ASSERT_EQ(output, (std::vector<int> {3, 4, 5, 6, 7, 8, 9, 10}));
+    ASSERT_EQ(queue.try_dequeue_bulk(std::back_inserter(output), 1), 0);
+}
+
+TEST(MpmcQueueTest, ConcurrentTest)
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 50000;
+    MpmcQueue<int> queue(64);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue, p]() {
+            int batch[4];
+            int next = 0;
+            while (next < per_producer)
+            {
+                if (next % 2 == 0)
+                {
+                    queue.enqueue(p * per_producer + next);
+                    next++;
+                    continue;
+                }
+                int batch_size = std::min(4, per_producer - next);
+                for (int i = 0; i < batch_size; i++)
+                    batch[i] = p * per_producer + next + i;
+                size_t pushed = queue.try_enqueue_bulk(batch, batch_size);
+                if (pushed == 0)
+                    std::this_thread::yield();
+                next += static_cast<int>(pushed);
+            }
+        });
+    }
+
+    // Every consumer checks that values of each producer come in order
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<int> order_errors { 0 };
+    std::atomic<int> remaining { producers * per_producer };
+    for (int c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&, c]() {
+            std::vector<int> last(producers, -1);
+            int batch[3];
+            while (remaining.load() > 0)
+            {
+                size_t popped = 0;
+                if (c % 2 == 0)
+                {
+                    popped = queue.try_dequeue_bulk(batch, 3);
+                }
+                else if (queue.try_dequeue(batch[0]))
+                {
+                    popped = 1;
+                }
+                if (popped == 0)
+                    std::this_thread::yield();
+                for (size_t i = 0; i < popped; i++)
+                {
+                    int producer = batch[i] / per_producer;
+                    if (batch[i] <= last[producer])
+                        order_errors++;
+                    last[producer] = batch[i];
+                    seen[batch[i]]++;
+                }
+                remaining -= static_cast<int>(popped);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(order_errors.load(), 0);
+    for (auto& count : seen)
+        ASSERT_EQ(count.load(), 1);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, BlockingTest)
+{
+    const int count = 20000;
+    MpmcQueue<int> queue(2);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; i++)
+            queue.enqueue(i);
+    });
+
+    long long sum = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int value;
+        queue.dequeue(value);
+        ASSERT_EQ(value, i);
+        sum += value;
+    }
+    producer.join();
+    ASSERT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
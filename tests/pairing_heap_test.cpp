@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "pairing_heap.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using CppADS::PairingHeap;
+
+template<typename Heap>
+static std::vector<int> drain(Heap& heap)
+{
+    std::vector<int> result;
+    while (!heap.empty())
+    {
+        result.push_back(heap.top());
+        heap.pop();
+    }
+    return result;
+}
+
+TEST(PairingHeapTest, ConstructTest)
+{
+    PairingHeap<int> heap;
+    ASSERT_EQ(heap.size(), 0);
+    ASSERT_TRUE(heap.empty());
+    ASSERT_THROW(heap.top(), std::out_of_range);
+    ASSERT_THROW(heap.pop(), std::out_of_range);
+    ASSERT_THROW(heap.get(PairingHeap<int>::handle_type()), std::out_of_range);
+
+    PairingHeap<int, std::greater<int>> max_heap;
+    for (int value : {3, 7, 5})
+        max_heap.push(value);
+    ASSERT_EQ(max_heap.top(), 7);
+}
+
+TEST(PairingHeapTest, ModifyTest)
+{
+    PairingHeap<std::string> heap;
+    auto b = heap.push("b");
+    std::string value = "d";
+    auto d = heap.push(value);
+    auto a = heap.emplace(1, 'a');
+    ASSERT_EQ(heap.top(), "a");
+    ASSERT_TRUE(heap.top_handle() == a);
+    ASSERT_EQ(heap.get(b), "b");
+    ASSERT_EQ(heap.get(d), "d");
+
+    heap.pop();
+
+    // Node of removed item is reused, but the old handle stays stale
+    auto c = heap.push("c");
+    ASSERT_TRUE(c != a);
+    ASSERT_THROW(heap.get(a), std::out_of_range);
+    ASSERT_EQ(heap.get(c), "c");
+    ASSERT_EQ(heap.size(), 3);
+
+    heap.clear();
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(PairingHeapTest, KeyTest)
+{
+    PairingHeap<int> heap;
+    std::vector<PairingHeap<int>::handle_type> handles;
+    for (int value : {50, 40, 30, 20, 10})
+        handles.push_back(heap.push(value));
+
+    heap.decrease_key(handles[0], 5);
+    ASSERT_TRUE(heap.top_handle() == handles[0]);
+    heap.increase_key(handles[0], 45);
+    ASSERT_EQ(heap.top(), 10);
+    heap.update(handles[1], 1);
+    ASSERT_TRUE(heap.top_handle() == handles[1]);
+    heap.update(handles[1], 100);
+    ASSERT_EQ(heap.get(handles[1]), 100);
+
+    ASSERT_THROW(heap.decrease_key(handles[2], 31), std::invalid_argument);
+    ASSERT_THROW(heap.increase_key(handles[2], 29), std::invalid_argument);
+
+    heap.erase(handles[3]);
+    ASSERT_EQ(drain(heap), (std::vector<int> {10, 30, 45, 100}));
+}
+
+TEST(PairingHeapTest, RandomTest)
+{
+    std::mt19937 random(7);
+    PairingHeap<int> heap;
+    std::vector<PairingHeap<int>::handle_type> handles;
+    std::vector<int> values;
+    for (int i = 0; i < 2000; i++)
+    {
+        values.push_back(random() % 10000);
+        handles.push_back(heap.push(values.back()));
+    }
+    for (int i = 0; i < 3000; i++)
+    {
+        size_t index = random() % values.size();
+        if (i % 3 == 0)
+        {
+            heap.erase(handles[index]);
+            handles.erase(handles.begin() + index);
+            values.erase(values.begin() + index);
+        }
+        else
+        {
+            values[index] = random() % 10000;
+            heap.update(handles[index], values[index]);
+        }
+        ASSERT_EQ(heap.top(), *std::min_element(values.begin(), values.end()));
+    }
+    for (size_t i = 0; i < handles.size(); i++)
+        ASSERT_EQ(heap.get(handles[i]), values[i]);
+
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(drain(heap), values);
+}
+
+TEST(PairingHeapTest, MergeTest)
+{
+    PairingHeap<int> first;
+    PairingHeap<int> second;
+    for (int value : {5, 1, 9})
+        first.push(value);
+    auto handle = second.push(7);
+    second.push(3);
+
+    first.merge(second);
+    ASSERT_TRUE(second.empty());
+    ASSERT_EQ(first.size(), 5);
+
+    // Handles of merged items stay valid
+    first.decrease_key(handle, 0);
+    ASSERT_TRUE(first.top_handle() == handle);
+
+    PairingHeap<int> moved(std::move(first));
+    ASSERT_EQ(drain(moved), (std::vector<int> {0, 1, 3, 5, 9}));
+}
+
+TEST(PairingHeapTest, StaleHandleTest)
+{
+    PairingHeap<int> heap;
+    auto popped = heap.push(1);
+    auto erased = heap.push(2);
+    auto kept = heap.push(3);
+    heap.pop();
+    heap.erase(erased);
+
+    ASSERT_THROW(heap.get(popped), std::out_of_range);
+    ASSERT_THROW(heap.erase(erased), std::out_of_range);
+    ASSERT_THROW(heap.decrease_key(popped, 0), std::out_of_range);
+    ASSERT_THROW(heap.increase_key(erased, 10), std::out_of_range);
+    ASSERT_THROW(heap.update(popped, 5), std::out_of_range);
+
+    // Nodes of removed items are reused, their old handles still don't match
+    auto reused = heap.push(4);
+    auto reused_too = heap.push(5);
+    ASSERT_NE(reused, popped);
+    ASSERT_NE(reused, erased);
+    ASSERT_NE(reused_too, popped);
+    ASSERT_NE(reused_too, erased);
+    ASSERT_THROW(heap.get(popped), std::out_of_range);
+    ASSERT_THROW(heap.get(erased), std::out_of_range);
+    ASSERT_EQ(heap.get(reused), 4);
+    ASSERT_EQ(heap.size(), 3);
+    ASSERT_EQ(heap.top(), 3);
+
+    heap.clear();
+    ASSERT_THROW(heap.get(kept), std::out_of_range);
+    ASSERT_THROW(heap.erase(reused), std::out_of_range);
+    heap.push(7);
+    ASSERT_EQ(heap.top(), 7);
+    ASSERT_EQ(heap.size(), 1);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "priority_queue.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using CppADS::PriorityQueue;
+
+template<typename Queue>
+static std::vector<int> drain(Queue& queue)
+{
+    std::vector<int> result;
+    while (!queue.empty())
+    {
+        result.push_back(queue.top());
+        queue.pop();
+    }
+    return result;
+}
+
+TEST(PriorityQueueTest, ConstructTest)
+{
+    PriorityQueue<int> queue_empty;
+    ASSERT_EQ(queue_empty.size(), 0);
+    ASSERT_TRUE(queue_empty.empty());
+    ASSERT_THROW(queue_empty.top(), std::out_of_range);
+    ASSERT_THROW(queue_empty.pop(), std::out_of_range);
+
+    PriorityQueue<int> queue_init {3, 1, 4, 1, 5, 9, 2, 6};
+    ASSERT_EQ(queue_init.size(), 8);
+    ASSERT_EQ(queue_init.top(), 9);
+
+    PriorityQueue<int> queue_copy(queue_init);
+    PriorityQueue<int> queue_move(std::move(queue_init));
+    ASSERT_EQ(drain(queue_copy), drain(queue_move));
+
+    std::vector<int> values {5, 3, 8, 1};
+    PriorityQueue<int, std::greater<int>> queue_range(values.begin(), values.end());
+    ASSERT_EQ(drain(queue_range), (std::vector<int> {1, 3, 5, 8}));
+}
+
+TEST(PriorityQueueTest, AssignTest)
+{
+    PriorityQueue<int> queue_init {0, 1, 2, 3, 4, 5, 6};
+
+    PriorityQueue<int> queue_copy;
+    queue_copy = queue_init;
+    ASSERT_EQ(queue_copy.size(), 7);
+
+    PriorityQueue<int> queue_move;
+    queue_move = std::move(queue_init);
+    ASSERT_EQ(queue_move.size(), 7);
+    ASSERT_EQ(drain(queue_copy), drain(queue_move));
+}
+
+TEST(PriorityQueueTest, ModifyTest)
+{
+    PriorityQueue<std::string> queue;
+    queue.push("b");
+    std::string value = "d";
+    queue.push(value);
+    queue.emplace(3, 'a');
+    queue.push(std::string("c"));
+    ASSERT_EQ(queue.top(), "d");
+    queue.pop();
+    ASSERT_EQ(queue.top(), "c");
+    queue.pop();
+    ASSERT_EQ(queue.top(), "b");
+
+    queue.clear();
+    ASSERT_TRUE(queue.empty());
+    queue.reserve(100);
+    ASSERT_GE(queue.capacity(), 100);
+}
+
+TEST(PriorityQueueTest, PushPopTest)
+{
+    PriorityQueue<int> queue {5, 3, 1};
+
+    // Value greater than top is returned back
+    ASSERT_EQ(queue.push_pop(7), 7);
+    ASSERT_EQ(queue.size(), 3);
+    ASSERT_EQ(queue.push_pop(4), 5);
+    ASSERT_EQ(queue.top(), 4);
+
+    // Top is removed before value is added
+    ASSERT_EQ(queue.replace_top(10), 4);
+    ASSERT_EQ(drain(queue), (std::vector<int> {10, 3, 1}));
+
+    ASSERT_EQ(queue.push_pop(2), 2);
+    ASSERT_THROW(queue.replace_top(1), std::out_of_range);
+}
+
+TEST(PriorityQueueTest, PushRangeTest)
+{
+    PriorityQueue<int> queue {50, 40};
+    std::vector<int> large {1, 60, 2, 30, 45};
+    queue.push_range(large.begin(), large.end());
+    std::vector<int> small {55};
+    queue.push_range(small.begin(), small.end());
+    ASSERT_EQ(drain(queue), (std::vector<int> {60, 55, 50, 45, 40, 30, 2, 1}));
+}
+
+template<size_t Arity>
+static void check_random_order()
+{
+    std::mt19937 random(Arity);
+    std::vector<int> values(5000);
+    for (auto& value : values)
+        value = random() % 1000;
+
+    PriorityQueue<int, std::less<int>, Arity> heapified(values.begin(), values.end());
+    PriorityQueue<int, std::less<int>, Arity> pushed;
+    for (int value : values)
+        pushed.push(value);
+
+    std::sort(values.begin(), values.end(), std::greater<int>());
+    ASSERT_EQ(drain(heapified), values);
+    ASSERT_EQ(drain(pushed), values);
+}
+
+TEST(PriorityQueueTest, ArityTest)
+{
+    check_random_order<2>();
+    check_random_order<3>();
+    check_random_order<4>();
+    check_random_order<8>();
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
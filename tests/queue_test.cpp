@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include "queue.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
 using CppADS::Queue;
 
 TEST(QueueTest, ConstructTest)
@@ -50,6 +55,123 @@ TEST(QueueTest, ModifyTest)
     ASSERT_EQ(queue.front(), 50);
 }
 
+TEST(QueueTest, GrowTest)
+{
+    Queue<int> queue;
+    for (int i = 0; i < 6; i++)
+        queue.enqueue(i);
+    for (int i = 0; i < 4; i++)
+        queue.dequeue();
+    ASSERT_EQ(queue.capacity(), 8);
+
+    // Buffer is wrapped around when it grows
+    for (int i = 6; i < 20; i++)
+        queue.emplace(i);
+    ASSERT_EQ(queue.size(), 16);
+    ASSERT_EQ(queue.capacity(), 16);
+
+    for (int i = 4; i < 20; i++)
+    {
+        ASSERT_EQ(queue.front(), i);
+        queue.dequeue();
+    }
+    ASSERT_THROW(queue.dequeue(), std::out_of_range);
+    ASSERT_THROW(queue.front(), std::out_of_range);
+
+    queue.reserve(100);
+    ASSERT_EQ(queue.capacity(), 128);
+    queue.clear();
+    ASSERT_EQ(queue.capacity(), 0);
+}
+
+TEST(QueueTest, BulkTest)
+{
+    std::vector<std::string> input {"a", "b", "c", "d", "e"};
+
+    Queue<std::string> queue;
+    queue.emplace(3, 'x');
+    queue.enqueue_bulk(input.begin(), input.end());
+    ASSERT_EQ(queue.size(), 6);
+    ASSERT_EQ(queue.front(), "xxx");
+
+    std::vector<std::string> output;
+    ASSERT_EQ(queue.dequeue_bulk(std::back_inserter(output), 4), 4);
+    ASSERT_EQ(output, std::vector<std::string>({"xxx", "a", "b", "c"}));
+    ASSERT_EQ(queue.front(), "d");
+
+    ASSERT_EQ(queue.dequeue_bulk(std::back_inserter(output), 10), 2);
+    ASSERT_EQ(queue.size(), 0);
+    ASSERT_EQ(output.back(), "e");
+}
+
+TEST(QueueTest, BulkReleaseTest)
+{
+    auto value = std::make_shared<int>(1);
+    Queue<std::shared_ptr<int>> queue;
+    queue.enqueue(value);
+    queue.enqueue(value);
+    std::vector<std::shared_ptr<int>> output;
+    ASSERT_EQ(queue.dequeue_bulk(std::back_inserter(output), 2), 2);
+    output.clear();
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(QueueTest, SelfEnqueueTest)
+{
+    Queue<std::string> queue;
+    for (int i = 0; i < 8; i++)
+        queue.enqueue(std::string(20, static_cast<char>('a' + i)));
+    ASSERT_EQ(queue.size(), queue.capacity());
+
+    // Referenced element lives in the buffer released by growth
+    queue.enqueue(queue.front());
+    ASSERT_EQ(queue.capacity(), 16);
+    for (int i = 9; i < 16; i++)
+        queue.enqueue(std::string(20, static_cast<char>('a' + i)));
+    queue.enqueue(std::move(queue.front()));
+    ASSERT_EQ(queue.capacity(), 32);
+
+    std::vector<std::string> output;
+    ASSERT_EQ(queue.dequeue_bulk(std::back_inserter(output), 20), 17);
+    ASSERT_EQ(output[8], std::string(20, 'a'));
+    ASSERT_EQ(output[16], std::string(20, 'a'));
+}
+
+TEST(QueueTest, NoDefaultTest)
+{
+    // Values without default constructor, every constructed one must be destroyed
+    struct Item
+    {
+        explicit Item(int value, int& alive) : value(value), alive(&alive) { alive++; }
+        Item(const Item& copy) : value(copy.value), alive(copy.alive) { (*alive)++; }
+        ~Item() { (*alive)--; }
+        Item& operator=(const Item&) = default;
+
+        int value;
+        int* alive;
+    };
+
+    int alive = 0;
+    {
+        Queue<Item> queue;
+        for (int i = 0; i < 10; i++)
+            queue.emplace(i, alive);
+        queue.enqueue(queue.front());
+        ASSERT_EQ(alive, 11);
+
+        queue.dequeue();
+        ASSERT_EQ(queue.front().value, 1);
+        ASSERT_EQ(alive, 10);
+
+        Queue<Item> copy(queue);
+        ASSERT_EQ(alive, 20);
+        copy = std::move(queue);
+        ASSERT_EQ(alive, 10);
+        ASSERT_EQ(copy.size(), 10);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "read_mostly_hash_map.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using CppADS::ReadMostlyHashMap;
+
+TEST(ReadMostlyHashMapTest, ConstructTest)
+{
+    ReadMostlyHashMap<int, int> map;
+    ASSERT_EQ(map.size(), 0);
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.bucket_count(), 1);
+    ASSERT_FALSE(map.contains(1));
+}
+
+TEST(ReadMostlyHashMapTest, ModifyTest)
+{
+    ReadMostlyHashMap<std::string, std::string> map;
+    ASSERT_TRUE(map.insert({"a", "1"}));
+    ASSERT_FALSE(map.insert({"a", "2"}));
+    std::string value;
+    ASSERT_TRUE(map.find("a", value));
+    ASSERT_EQ(value, "1");
+    ASSERT_FALSE(map.find("b", value));
+    ASSERT_EQ(value, "1");
+
+    ASSERT_FALSE(map.insert_or_assign("a", "3"));
+    ASSERT_TRUE(map.insert_or_assign("b", std::string("4")));
+    ASSERT_EQ(map.size(), 2);
+    size_t length = 0;
+    ASSERT_TRUE(map.visit("a", [&length](const std::string& found) { length = found.size(); ASSERT_EQ(found, "3"); }));
+    ASSERT_EQ(length, 1);
+    ASSERT_FALSE(map.visit("c", [](const std::string&) { FAIL(); }));
+
+    ASSERT_TRUE(map.remove("a"));
+    ASSERT_FALSE(map.remove("a"));
+    ASSERT_FALSE(map.contains("a"));
+    ASSERT_TRUE(map.contains("b"));
+    ASSERT_EQ(map.size(), 1);
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains("b"));
+    ASSERT_TRUE(map.insert({"b", "5"}));
+}
+
+TEST(ReadMostlyHashMapTest, GrowthTest)
+{
+    ReadMostlyHashMap<int, int> map;
+    for (int i = 0; i < 5000; i++)
+        ASSERT_TRUE(map.insert({i, i}));
+    ASSERT_EQ(map.size(), 5000);
+    ASSERT_EQ(map.bucket_count(), 8192);
+
+    for (int i = 0; i < 5000; i += 2)
+        ASSERT_FALSE(map.insert_or_assign(i, -i));
+    for (int i = 1; i < 5000; i += 4)
+        ASSERT_TRUE(map.remove(i));
+
+    long long sum = 0;
+    size_t count = 0;
+    map.for_each([&sum, &count](const std::pair<int, int>& item) { sum += item.second; count++; });
+    ASSERT_EQ(count, map.size());
+    ASSERT_EQ(count, 5000 - 1250);
+    for (int i = 0; i < 5000; i++)
+    {
+        int value = 0;
+        bool present = i % 4 != 1;
+        ASSERT_EQ(map.find(i, value), present);
+        if (present)
+        {
+            ASSERT_EQ(value, i % 2 == 0 ? -i : i);
+        }
+    }
+}
+
+TEST(ReadMostlyHashMapTest, ConcurrentTest)
+{
+    // Values encode their key, so torn or stale-node reads are detected
+    const int keys = 1000;
+    const int readers = 4;
+    ReadMostlyHashMap<int, long long> map;
+    for (int key = 0; key < keys; key++)
+        map.insert({key, key});
+
+    std::atomic<bool> stop { false };
+    std::atomic<size_t> lookups { 0 };
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++)
+    {
+        threads.emplace_back([&map, &stop, &lookups, r]() {
+            size_t count = 0;
+            for (int key = r; !stop.load(std::memory_order_relaxed); key = (key + 7) % keys)
+            {
+                long long value = -1;
+                // Even keys are never removed
+                bool found = map.find(key, value);
+                if (key % 2 == 0)
+                {
+                    ASSERT_TRUE(found);
+                }
+                if (found)
+                {
+                    ASSERT_EQ(value % keys, key);
+                }
+                count++;
+                if (count % 256 == 0)
+                    std::this_thread::yield();
+            }
+            lookups += count;
+        });
+    }
+
+    for (long long round = 1; round <= 200; round++)
+    {
+        for (int key = 0; key < keys; key += 5)
+            map.insert_or_assign(key, round * keys + key);
+        for (int key = 1; key < keys; key += 2)
+        {
+            if ((key + round) % 3 == 0)
+                map.remove(key);
+            else
+                map.insert({key, round * keys + key});
+        }
+        if (round == 100)
+        {
+            // Growth while readers walk the old bucket array
+            for (int key = keys; key < 4 * keys; key += 2)
+                map.insert({key, key});
+        }
+        std::this_thread::yield();
+    }
+    stop = true;
+    for (auto& thread : threads)
+        thread.join();
+    ASSERT_GT(lookups.load(), 0);
+    ASSERT_TRUE(map.contains(2 * keys));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+
+#include "reclamation.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using CppADS::EpochDomain;
+using CppADS::HazardDomain;
+
+/// Object of shared structure. Deleter only marks it as reclaimed and the memory
+/// is kept by NodePool, so access to reclaimed node is detected instead of being UB.
+struct Node
+{
+    std::atomic<bool> reclaimed { false };
+    int value { 0 };
+};
+
+class NodePool
+{
+public:
+    Node* make(int value)
+    {
+        std::unique_ptr<Node> node(new Node());
+        node->value = value;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_nodes.push_back(std::move(node));
+        return m_nodes.back().get();
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_nodes.size();
+    }
+
+    static void reclaim(void* pointer)
+    {
+        if (static_cast<Node*>(pointer)->reclaimed.exchange(true))
+            double_reclaims()++;
+        reclaims()++;
+    }
+
+    static std::atomic<size_t>& reclaims()
+    {
+        static std::atomic<size_t> count { 0 };
+        return count;
+    }
+
+    static std::atomic<size_t>& double_reclaims()
+    {
+        static std::atomic<size_t> count { 0 };
+        return count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Node>> m_nodes;
+};
+
+/// Reads shared pointer inside a guard of EpochDomain
+class EpochReader
+{
+public:
+    explicit EpochReader(EpochDomain& domain) : m_guard(domain) {}
+
+    Node* read(const std::atomic<Node*>& source) {
+        return source.load(std::memory_order_acquire);
+    }
+
+private:
+    EpochDomain::Guard m_guard;
+};
+
+/// Reads shared pointer protected by hazard pointer
+class HazardReader
+{
+public:
+    explicit HazardReader(HazardDomain& domain) : m_guard(domain) {}
+
+    Node* read(const std::atomic<Node*>& source) {
+        return m_guard.protect(source);
+    }
+
+private:
+    HazardDomain::Guard m_guard;
+};
+
+/// Stress harness: writers replace nodes in shared cells and retire old ones, readers
+/// check that nodes they hold aren't reclaimed, also after yielding inside the guard.
+/// @return count of reads which saw reclaimed node
+template<typename Domain, typename Reader>
+static size_t stress(int readers_count, int writers_count, int updates)
+{
+    const int cells_count = 8;
+    const size_t reclaims_before = NodePool::reclaims().load();
+    NodePool pool;
+    std::atomic<size_t> violations { 0 };
+    {
+        Domain domain(16);
+        std::atomic<Node*> cells[cells_count];
+        for (auto& cell : cells)
+            cell.store(pool.make(-1));
+
+        std::atomic<int> writers_left { writers_count };
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers_count; r++)
+        {
+            threads.emplace_back([&, r]() {
+                for (unsigned i = r; writers_left.load() > 0; i++)
+                {
+                    Reader reader(domain);
+                    Node* node = reader.read(cells[i % cells_count]);
+                    if (node->reclaimed.load())
+                        violations++;
+                    if (i % 16 == 0)
+                    {
+                        std::this_thread::yield();
+                        if (node->reclaimed.load())
+                            violations++;
+                    }
+                }
+            });
+        }
+        for (int w = 0; w < writers_count; w++)
+        {
+            threads.emplace_back([&, w]() {
+                for (int i = 0; i < updates; i++)
+                {
+                    Node* node = pool.make(i);
+                    Node* old = cells[(w + i) % cells_count].exchange(node);
+                    domain.retire(old, &NodePool::reclaim);
+                    if (i % 64 == 0)
+                        std::this_thread::yield();
+                }
+                writers_left--;
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        for (auto& cell : cells)
+            domain.retire(cell.load(), &NodePool::reclaim);
+    }
+
+    // Every node is reclaimed exactly once when domain is destroyed
+    EXPECT_EQ(NodePool::reclaims().load() - reclaims_before, pool.size());
+    EXPECT_EQ(NodePool::double_reclaims().load(), 0);
+    return violations.load();
+}
+
+TEST(ReclamationTest, EpochRetireTest)
+{
+    NodePool pool;
+    size_t reclaims_before = NodePool::reclaims().load();
+    {
+        EpochDomain domain(8);
+        for (int i = 0; i < 100; i++)
+        {
+            EpochDomain::Guard guard(domain);
+            EpochDomain::Guard nested(domain);
+            domain.retire(pool.make(i), &NodePool::reclaim);
+        }
+        ASSERT_LT(domain.pending(), 100);
+
+        // Without active guards two advances make everything reclaimable
+        for (int i = 0; i < 3; i++)
+            domain.collect();
+        ASSERT_EQ(domain.pending(), 0);
+
+        int* value = new int(1);
+        domain.retire(value);
+        ASSERT_EQ(domain.pending(), 1);
+    }
+    ASSERT_EQ(NodePool::reclaims().load() - reclaims_before, 100);
+}
+
+TEST(ReclamationTest, EpochStalledReaderTest)
+{
+    NodePool pool;
+    EpochDomain domain(8);
+    std::atomic<int> state { 0 };
+    std::thread reader([&]() {
+        EpochDomain::Guard guard(domain);
+        state = 1;
+        while (state.load() != 2)
+            std::this_thread::yield();
+    });
+    while (state.load() != 1)
+        std::this_thread::yield();
+
+    // Reader inside a guard blocks reclamation of everything retired meanwhile
+    for (int i = 0; i < 1000; i++)
+        domain.retire(pool.make(i), &NodePool::reclaim);
+    ASSERT_EQ(domain.pending(), 1000);
+
+    state = 2;
+    reader.join();
+    for (int i = 0; i < 3; i++)
+        domain.collect();
+    ASSERT_EQ(domain.pending(), 0);
+}
+
+TEST(ReclamationTest, HazardProtectTest)
+{
+    NodePool pool;
+    HazardDomain domain(8);
+    std::atomic<Node*> shared { pool.make(0) };
+
+    HazardDomain::Guard guard(domain);
+    Node* protected_node = guard.protect(shared);
+    ASSERT_EQ(protected_node, shared.load());
+
+    for (int i = 1; i <= 100; i++)
+        domain.retire(shared.exchange(pool.make(i)), &NodePool::reclaim);
+    domain.collect();
+
+    // Only protected node survives
+    ASSERT_EQ(domain.pending(), 1);
+    ASSERT_FALSE(protected_node->reclaimed.load());
+
+    guard.reset();
+    domain.collect();
+    ASSERT_EQ(domain.pending(), 0);
+    ASSERT_TRUE(protected_node->reclaimed.load());
+    domain.retire(shared.load(), &NodePool::reclaim);
+}
+
+TEST(ReclamationTest, HazardSlotsTest)
+{
+    HazardDomain domain;
+    std::vector<std::unique_ptr<HazardDomain::Guard>> guards;
+    for (size_t i = 0; i < HazardDomain::SlotsPerThread; i++)
+        guards.emplace_back(new HazardDomain::Guard(domain));
+    ASSERT_THROW(HazardDomain::Guard guard(domain), std::length_error);
+
+    // Released slot is given to the next guard
+    guards.pop_back();
+    ASSERT_NO_THROW(HazardDomain::Guard guard(domain));
+}
+
+TEST(ReclamationTest, HazardBoundedTest)
+{
+    NodePool pool;
+    HazardDomain domain(16);
+    std::atomic<Node*> shared { pool.make(0) };
+    std::atomic<int> state { 0 };
+    std::thread reader([&]() {
+        HazardDomain::Guard guard(domain);
+        guard.protect(shared);
+        state = 1;
+        while (state.load() != 2)
+            std::this_thread::yield();
+    });
+    while (state.load() != 1)
+        std::this_thread::yield();
+
+    // Stalled reader holds one node only, count of pending nodes stays bounded
+    size_t max_pending = 0;
+    for (int i = 1; i <= 10000; i++)
+    {
+        domain.retire(shared.exchange(pool.make(i)), &NodePool::reclaim);
+        max_pending = std::max(max_pending, domain.pending());
+    }
+    ASSERT_LE(max_pending, 2 * 2 * HazardDomain::SlotsPerThread + 1);
+
+    state = 2;
+    reader.join();
+    domain.retire(shared.load(), &NodePool::reclaim);
+}
+
+TEST(ReclamationTest, RecordReuseTest)
+{
+    NodePool pool;
+    EpochDomain domain(4);
+    for (int round = 0; round < 50; round++)
+    {
+        std::thread thread([&]() {
+            EpochDomain::Guard guard(domain);
+            domain.retire(pool.make(round), &NodePool::reclaim);
+        });
+        thread.join();
+    }
+
+    // Record of exited thread keeps its retired objects for the next thread
+    ASSERT_LT(domain.pending(), 50);
+}
+
+TEST(ReclamationTest, EpochStressTest)
+{
+    ASSERT_EQ((stress<EpochDomain, EpochReader>(3, 2, 20000)), 0);
+}
+
+TEST(ReclamationTest, HazardStressTest)
+{
+    ASSERT_EQ((stress<HazardDomain, HazardReader>(3, 2, 20000)), 0);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
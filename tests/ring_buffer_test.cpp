@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "ring_buffer.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using CppADS::RingBuffer;
+using CppADS::StaticRingBuffer;
+using CppADS::OverflowPolicy;
+
+TEST(RingBufferTest, ConstructTest)
+{
+    RingBuffer<int> buffer(5);
+    ASSERT_EQ(buffer.size(), 0);
+    ASSERT_EQ(buffer.capacity(), 5);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_THROW(RingBuffer<int>(0), std::invalid_argument);
+
+    for (int i = 0; i < 5; i++)
+        buffer.push_back(i);
+
+    RingBuffer<int> buffer_copy(buffer);
+    ASSERT_EQ(buffer_copy.size(), 5);
+    for (size_t i = 0; i < buffer_copy.size(); i++)
+        ASSERT_EQ(buffer_copy[i], buffer[i]);
+
+    RingBuffer<int> buffer_move(std::move(buffer));
+    ASSERT_EQ(buffer_move.size(), 5);
+    ASSERT_EQ(buffer.size(), 0);
+
+    // Moved-from buffer stays copyable
+    RingBuffer<int> moved_copy(buffer);
+    ASSERT_EQ(moved_copy.size(), 0);
+    ASSERT_EQ(moved_copy.capacity(), 0);
+    buffer_copy = buffer;
+    ASSERT_EQ(buffer_copy.size(), 0);
+    ASSERT_EQ(buffer_copy.capacity(), 0);
+    buffer = buffer_move;
+    ASSERT_EQ(buffer.size(), 5);
+    ASSERT_EQ(buffer.capacity(), 5);
+
+    StaticRingBuffer<int, 8> static_buffer;
+    ASSERT_EQ(static_buffer.capacity(), 8);
+    static_buffer.push_back(1);
+    static_buffer.push_back(2);
+
+    StaticRingBuffer<int, 8> static_copy(static_buffer);
+    static_buffer.pop_front();
+    ASSERT_EQ(static_copy.size(), 2);
+    ASSERT_EQ(static_copy.front(), 1);
+    ASSERT_EQ(static_copy.back(), 2);
+}
+
+TEST(RingBufferTest, RejectTest)
+{
+    RingBuffer<int> buffer(3);
+    ASSERT_TRUE(buffer.push_back(1));
+    ASSERT_TRUE(buffer.push_back(2));
+    ASSERT_TRUE(buffer.push_front(0));
+    ASSERT_TRUE(buffer.full());
+    ASSERT_FALSE(buffer.push_back(3));
+    ASSERT_FALSE(buffer.push_front(-1));
+
+    ASSERT_EQ(buffer.front(), 0);
+    ASSERT_EQ(buffer.back(), 2);
+
+    buffer.pop_back();
+    ASSERT_EQ(buffer.back(), 1);
+    buffer.pop_front();
+    ASSERT_EQ(buffer.front(), 1);
+    buffer.pop_front();
+    ASSERT_THROW(buffer.pop_front(), std::out_of_range);
+    ASSERT_THROW(buffer.pop_back(), std::out_of_range);
+}
+
+TEST(RingBufferTest, OverwriteTest)
+{
+    RingBuffer<int, OverflowPolicy::Overwrite> buffer(3);
+    for (int i = 0; i < 10; i++)
+        ASSERT_TRUE(buffer.push_back(i));
+
+    ASSERT_EQ(buffer.size(), 3);
+    ASSERT_EQ(buffer[0], 7);
+    ASSERT_EQ(buffer[1], 8);
+    ASSERT_EQ(buffer[2], 9);
+    ASSERT_THROW(buffer[3], std::out_of_range);
+
+    buffer.push_front(6);
+    ASSERT_EQ(buffer.front(), 6);
+    ASSERT_EQ(buffer.back(), 8);
+}
+
+TEST(RingBufferTest, OverwriteSelfTest)
+{
+    // Pushed value refers to the element dropped from full buffer
+    RingBuffer<std::string, OverflowPolicy::Overwrite> buffer(2);
+    buffer.push_back("a");
+    buffer.push_back("b");
+    ASSERT_TRUE(buffer.push_back(buffer.front()));
+    ASSERT_EQ(buffer.front(), "b");
+    ASSERT_EQ(buffer.back(), "a");
+    ASSERT_TRUE(buffer.push_front(buffer.back()));
+    ASSERT_EQ(buffer.front(), "a");
+    ASSERT_EQ(buffer.back(), "b");
+    ASSERT_TRUE(buffer.push_back(std::move(buffer.front())));
+    ASSERT_EQ(buffer.back(), "a");
+    ASSERT_TRUE(buffer.push_front(std::move(buffer.back())));
+    ASSERT_EQ(buffer.front(), "a");
+}
+
+TEST(RingBufferTest, MovedFromOverwriteTest)
+{
+    RingBuffer<int, OverflowPolicy::Overwrite> buffer(3);
+    buffer.push_back(1);
+    RingBuffer<int, OverflowPolicy::Overwrite> moved(std::move(buffer));
+
+    // Moved-from buffer has no storage, so values are rejected
+    int values[2] = {2, 3};
+    ASSERT_FALSE(buffer.push_back(2));
+    ASSERT_FALSE(buffer.push_front(2));
+    ASSERT_EQ(buffer.push_n(values, 2), 0);
+    ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST(RingBufferTest, BulkTest)
+{
+    int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int output[10] = {};
+
+    StaticRingBuffer<int, 8> buffer;
+    ASSERT_EQ(buffer.push_n(values, 5), 5);
+    ASSERT_EQ(buffer.pop_n(output, 3), 3);
+    ASSERT_EQ(output[2], 2);
+
+    // Wraps around the end of storage
+    ASSERT_EQ(buffer.push_n(values, 10), 6);
+    ASSERT_TRUE(buffer.full());
+    ASSERT_EQ(buffer.pop_n(output, 10), 8);
+    int expected[8] = {3, 4, 0, 1, 2, 3, 4, 5};
+    for (int i = 0; i < 8; i++)
+        ASSERT_EQ(output[i], expected[i]);
+    ASSERT_TRUE(buffer.empty());
+
+    RingBuffer<int, OverflowPolicy::Overwrite> overwrite(6);
+    overwrite.push_n(values, 4);
+    ASSERT_EQ(overwrite.push_n(values, 4), 4);
+    ASSERT_EQ(overwrite.size(), 6);
+    ASSERT_EQ(overwrite.front(), 2);
+    ASSERT_EQ(overwrite.push_n(values, 10), 10);
+    ASSERT_EQ(overwrite.front(), 4);
+    ASSERT_EQ(overwrite.back(), 9);
+}
+
+TEST(RingBufferTest, ReleaseTest)
+{
+    // Moved-from slots must not keep resources alive
+    auto value = std::make_shared<int>(1);
+    std::shared_ptr<int> output[2];
+
+    RingBuffer<std::shared_ptr<int>> buffer(4);
+    buffer.push_back(value);
+    buffer.push_back(value);
+    ASSERT_EQ(value.use_count(), 3);
+    ASSERT_EQ(buffer.pop_n(output, 2), 2);
+    output[0].reset();
+    output[1].reset();
+    ASSERT_EQ(value.use_count(), 1);
+
+    buffer.push_back(value);
+    buffer.pop_front();
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(RingBufferTest, OverwriteReleaseTest)
+{
+    // Storage of capacity 3 has 4 slots, so dropped slot isn't reused by new value
+    auto value = std::make_shared<int>(1);
+    std::shared_ptr<int> values[2] = {std::make_shared<int>(2), std::make_shared<int>(3)};
+
+    RingBuffer<std::shared_ptr<int>, OverflowPolicy::Overwrite> buffer(3);
+    buffer.push_back(value);
+    buffer.push_back(values[0]);
+    buffer.push_back(values[1]);
+    ASSERT_EQ(value.use_count(), 2);
+    ASSERT_EQ(buffer.push_n(values, 1), 1);
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(RingBufferTest, StaticStorageTest)
+{
+    // Moving through the base would take a pointer into inline storage
+    static_assert(!std::is_convertible<StaticRingBuffer<int, 8>*, RingBuffer<int>*>::value,
+                  "StaticRingBuffer must not be usable as RingBuffer");
+
+    StaticRingBuffer<int, 8> buffer;
+    buffer.push_back(1);
+    StaticRingBuffer<int, 8> moved(std::move(buffer));
+    buffer.push_back(2);
+    ASSERT_EQ(moved.size(), 1);
+    ASSERT_EQ(moved.front(), 1);
+    ASSERT_EQ(buffer.back(), 2);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
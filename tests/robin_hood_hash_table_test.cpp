@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "robin_hood_hash_table.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using CppADS::RobinHoodHashTable;
+
+/// Hash with many collisions, keeps long clusters in the table
+struct CollidingHash
+{
+    size_t operator()(int key) const {
+        return static_cast<size_t>(key % 7);
+    }
+};
+
+TEST (RobinHoodHashTableTest, ContructTest)
+{
+    RobinHoodHashTable<int, int> empty;
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_EQ(empty.begin(), empty.end());
+    ASSERT_EQ(empty.find(1), empty.end());
+
+    std::initializer_list<std::pair<std::string, int>> init_list {
+        {"111", 1}, {"222", 2}, {"333", 3}, {"444", 4}, {"555", 5}, {"666", 6}, {"777", 7}, {"888", 8}, {"999", 9}, {"000", 0}};
+
+    RobinHoodHashTable<std::string, int> hash_init (init_list);
+    ASSERT_EQ(hash_init.size(), init_list.size());
+
+    RobinHoodHashTable<std::string, int> hash_copy(hash_init);
+    ASSERT_EQ(hash_init, hash_copy);
+
+    RobinHoodHashTable<std::string, int> hash_move(std::move(hash_init));
+    ASSERT_EQ(hash_copy, hash_move);
+    ASSERT_EQ(hash_init.size(), 0);
+}
+
+TEST (RobinHoodHashTableTest, AssignTest)
+{
+    RobinHoodHashTable<std::string, int> hash_init {{"aaa", 101}, {"bbb", 202}, {"ccc", 303}, {"ddd", 404},
+                                                    {"eee", 505}, {"fff", 606}, {"ggg", 707}, {"hhh", 808}};
+
+    RobinHoodHashTable<std::string, int> hash_copy;
+    hash_copy = hash_init;
+    ASSERT_EQ(hash_init, hash_copy);
+
+    RobinHoodHashTable<std::string, int> hash_move;
+    hash_move = std::move(hash_init);
+    ASSERT_EQ(hash_copy, hash_move);
+    ASSERT_EQ(hash_init.size(), 0);
+}
+
+TEST (RobinHoodHashTableTest, IteratorTest)
+{
+    RobinHoodHashTable<int, int> hash;
+    for (int i = 0; i < 100; i++)
+        hash.insert({i, i * i});
+
+    int count = 0;
+    long long sum = 0;
+    for (auto it = hash.begin(); it != hash.end(); it++)
+    {
+        ASSERT_EQ(it->second, it->first * it->first);
+        (*it).second = 0;
+        sum += it->first;
+        count++;
+    }
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 4950);
+
+    const auto& const_hash = hash;
+    for (auto it = const_hash.cbegin(); it != const_hash.cend(); ++it)
+        ASSERT_EQ(it->second, 0);
+}
+
+TEST (RobinHoodHashTableTest, AccessTest)
+{
+    RobinHoodHashTable<char, int> hash {{'a', 101}, {'b', 202}, {'c', 303}};
+
+    ASSERT_EQ(hash['a'], 101);
+    ASSERT_EQ(hash['n'], int());
+    ASSERT_EQ(hash.size(), 4);
+
+    hash['i'] = 111;
+    ASSERT_EQ(hash['i'], 111);
+    ASSERT_EQ(*(hash.find('c')), decltype(hash)::value_type({'c', 303}));
+
+    // Const access doesn't insert
+    const auto& const_hash = hash;
+    ASSERT_EQ(const_hash['b'], 202);
+    ASSERT_THROW(const_hash['z'], std::out_of_range);
+    ASSERT_EQ(const_hash.find('z'), const_hash.end());
+}
+
+TEST (RobinHoodHashTableTest, InsertTest)
+{
+    RobinHoodHashTable<char, int> hash {{'a', 1}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}};
+
+    hash.insert({'R', 501});
+    std::pair<char, int> pair {'a', 10000};
+    hash.insert(pair);
+    pair = std::make_pair('v', 5);
+    hash.insert(std::move(pair));
+
+    ASSERT_EQ(hash, decltype(hash)({{'a', 10000}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}, {'R', 501}, {'v', 5}}));
+    ASSERT_EQ(hash.size(), 8);
+}
+
+TEST (RobinHoodHashTableTest, RemoveTest)
+{
+    RobinHoodHashTable<char, int> hash {{'a', 1}, {'b', 2}, {'c', 3}, {'x', 100}, {'y', 200}, {'z', 300}, {'R', 501}, {'j', 10000}, {'v', 5}};
+    ASSERT_TRUE(hash.remove('y'));
+    ASSERT_TRUE(hash.remove('b'));
+    ASSERT_TRUE(hash.remove('j'));
+    ASSERT_FALSE(hash.remove('j'));
+
+    ASSERT_EQ(hash, decltype(hash)({{'a', 1}, {'c', 3}, {'x', 100}, {'z', 300}, {'R', 501}, {'v', 5}}));
+    ASSERT_EQ(hash.size(), 6);
+
+    hash.clear();
+    ASSERT_EQ(hash.size(), 0);
+    ASSERT_EQ(hash.begin(), hash.end());
+}
+
+TEST (RobinHoodHashTableTest, CapacityTest)
+{
+    RobinHoodHashTable<int, int> hash;
+    ASSERT_THROW(hash.set_load_factor(1.5f), std::invalid_argument);
+    hash.set_load_factor(0.5f);
+    hash.reserve(1000);
+    size_t buckets = hash.bucket_count();
+    ASSERT_GE(buckets * 0.5f, 1000);
+
+    for (int i = 0; i < 1000; i++)
+        hash.insert({i, i});
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    ASSERT_LE(hash.load_factor(), 0.5f);
+
+    // Raising the limit doesn't shrink the table, lowering it grows the table
+    hash.set_load_factor(0.9f);
+    ASSERT_EQ(hash.bucket_count(), buckets);
+    hash.set_load_factor(0.25f);
+    ASSERT_GT(hash.bucket_count(), buckets);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(hash[i], i);
+}
+
+TEST (RobinHoodHashTableTest, CollisionTest)
+{
+    // Removal from the middle of long clusters shifts the rest back
+    RobinHoodHashTable<int, int, CollidingHash> hash;
+    std::unordered_map<int, int> expected;
+    std::mt19937 random(11);
+    for (int step = 0; step < 20000; step++)
+    {
+        int key = random() % 300;
+        if (random() % 3 == 0)
+        {
+            ASSERT_EQ(hash.remove(key), expected.erase(key) == 1);
+        }
+        else
+        {
+            hash.insert({key, step});
+            expected[key] = step;
+        }
+    }
+
+    ASSERT_EQ(hash.size(), expected.size());
+    for (const auto& item : expected)
+        ASSERT_EQ(hash.find(item.first)->second, item.second);
+    for (int key = 300; key < 400; key++)
+        ASSERT_EQ(hash.find(key), hash.end());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
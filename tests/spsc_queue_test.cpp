@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "spsc_queue.hpp"
+
+#include <string>
+#include <thread>
+
+using CppADS::SpscQueue;
+
+TEST(SpscQueueTest, ConstructTest)
+{
+    SpscQueue<int> queue(5);
+    ASSERT_EQ(queue.capacity(), 8);
+    ASSERT_EQ(queue.size(), 0);
+    ASSERT_TRUE(queue.empty());
+    ASSERT_THROW(SpscQueue<int>(0), std::invalid_argument);
+
+    SpscQueue<int> queue_exact(16);
+    ASSERT_EQ(queue_exact.capacity(), 16);
+}
+
+TEST(SpscQueueTest, ModifyTest)
+{
+    SpscQueue<std::string> queue(4);
+    ASSERT_TRUE(queue.try_push("a"));
+    std::string value = "b";
+    ASSERT_TRUE(queue.try_push(value));
+    ASSERT_TRUE(queue.try_emplace(2, 'c'));
+    ASSERT_TRUE(queue.try_push("d"));
+    ASSERT_FALSE(queue.try_push("e"));
+    ASSERT_EQ(queue.size(), 4);
+
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_EQ(value, "a");
+    ASSERT_TRUE(queue.try_push("e"));
+
+    const char* expected[] = {"b", "cc", "d", "e"};
+    for (const char* item : expected)
+    {
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(value, item);
+    }
+    ASSERT_FALSE(queue.try_pop(value));
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, BulkTest)
+{
+    SpscQueue<int> queue(8);
+    int input[12] = {0,1,2,3,4,5,6,7,8,9,10,11};
+    int output[12] = {};
+
+    ASSERT_EQ(queue.try_push_n(input, 5), 5);
+    ASSERT_EQ(queue.try_pop_n(output, 3), 3);
+    ASSERT_EQ(output[0], 0);
+    ASSERT_EQ(output[2], 2);
+
+    // Wraps around the end of buffer
+    ASSERT_EQ(queue.try_push_n(input + 5, 7), 6);
+    ASSERT_EQ(queue.size(), 8);
+    ASSERT_EQ(queue.try_push_n(input, 1), 0);
+
+    ASSERT_EQ(queue.try_pop_n(output, 12), 8);
+    for (int i = 0; i < 8; i++)
+        ASSERT_EQ(output[i], i + 3);
+    ASSERT_EQ(queue.try_pop_n(output, 1), 0);
+}
+
+TEST(SpscQueueTest, ConcurrentTest)
+{
+    const int count = 1000000;
+    SpscQueue<int> queue(64);
+
+    std::thread producer([&queue, count]() {
+        int batch[7];
+        int next = 0;
+        while (next < count)
+        {
+            if (next % 3 == 0)
+            {
+                if (queue.try_push(next))
+                    next++;
+                else
+                    std::this_thread::yield();
+                continue;
+            }
+            int batch_size = std::min(7, count - next);
+            for (int i = 0; i < batch_size; i++)
+                batch[i] = next + i;
+            size_t pushed = queue.try_push_n(batch, batch_size);
+            if (pushed == 0)
+                std::this_thread::yield();
+            next += static_cast<int>(pushed);
+        }
+    });
+
+    int expected = 0;
+    int batch[5];
+    while (expected < count)
+    {
+        int value;
+        if (expected % 2 == 0 && queue.try_pop(value))
+        {
+            ASSERT_EQ(value, expected);
+            expected++;
+            continue;
+        }
+        size_t popped = queue.try_pop_n(batch, 5);
+        if (popped == 0)
+            std::this_thread::yield();
+        for (size_t i = 0; i < popped; i++, expected++)
+            ASSERT_EQ(batch[i], expected);
+    }
+
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include "stack.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
 using CppADS::Stack;
 
 TEST(StackTest, ConstructTest)
@@ -70,6 +75,111 @@ TEST(StackTest, ModifyTest)
     ASSERT_EQ(stack.top(), 49);
 }
 
+TEST(StackTest, AccessTest)
+{
+    Stack<int> stack;
+    ASSERT_THROW(stack.top(), std::out_of_range);
+    ASSERT_THROW(stack.pop(), std::out_of_range);
+
+    stack.push(1);
+    stack.top() = 2;
+    const Stack<int>& const_stack = stack;
+    ASSERT_EQ(const_stack.top(), 2);
+}
+
+TEST(StackTest, BulkTest)
+{
+    Stack<std::string> stack;
+    stack.reserve(64);
+    ASSERT_GE(stack.capacity(), 64);
+    ASSERT_EQ(stack.size(), 0);
+
+    stack.emplace(3, 'a');
+    ASSERT_EQ(stack.top(), "aaa");
+
+    std::vector<std::string> values {"b", "c", "d", "e"};
+    stack.push_range(values.begin(), values.end());
+    ASSERT_EQ(stack.size(), 5);
+    ASSERT_EQ(stack.top(), "e");
+
+    std::vector<std::string> popped;
+    ASSERT_EQ(stack.pop_n(std::back_inserter(popped), 3), 3);
+    ASSERT_EQ(popped, (std::vector<std::string> {"e", "d", "c"}));
+    ASSERT_EQ(stack.top(), "b");
+
+    ASSERT_EQ(stack.pop_n(10), 2);
+    ASSERT_EQ(stack.size(), 0);
+    ASSERT_EQ(stack.pop_n(1), 0);
+}
+
+TEST(StackTest, ReleaseTest)
+{
+    auto value = std::make_shared<int>(1);
+    Stack<std::shared_ptr<int>> stack;
+    stack.push(value);
+    stack.push(value);
+    stack.push(value);
+    ASSERT_EQ(value.use_count(), 4);
+    stack.pop();
+    ASSERT_EQ(value.use_count(), 3);
+    ASSERT_EQ(stack.pop_n(2), 2);
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(StackTest, SelfPushTest)
+{
+    Stack<std::string> stack;
+    for (int i = 0; i < 4; i++)
+        stack.push(std::string(20, static_cast<char>('a' + i)));
+    ASSERT_EQ(stack.size(), stack.capacity());
+
+    // Referenced element lives in the buffer released by growth
+    stack.push(stack.top());
+    ASSERT_EQ(stack.top(), std::string(20, 'd'));
+    for (int i = 5; i < 8; i++)
+        stack.push(std::string(20, static_cast<char>('a' + i)));
+    ASSERT_EQ(stack.size(), stack.capacity());
+    stack.push(std::move(stack.top()));
+    ASSERT_EQ(stack.size(), 9);
+    ASSERT_EQ(stack.top(), std::string(20, 'h'));
+}
+
+TEST(StackTest, NoDefaultTest)
+{
+    // Values without default constructor, every constructed one must be destroyed
+    struct Item
+    {
+        explicit Item(int value, int& alive) : value(value), alive(&alive) { alive++; }
+        Item(const Item& copy) : value(copy.value), alive(copy.alive) { (*alive)++; }
+        ~Item() { (*alive)--; }
+        Item& operator=(const Item&) = default;
+
+        int value;
+        int* alive;
+    };
+
+    int alive = 0;
+    {
+        Stack<Item> stack;
+        for (int i = 0; i < 10; i++)
+            stack.emplace(i, alive);
+        stack.push(stack.top());
+        ASSERT_EQ(alive, 11);
+
+        stack.pop();
+        ASSERT_EQ(stack.pop_n(2), 2);
+        ASSERT_EQ(stack.top().value, 7);
+        ASSERT_EQ(alive, 8);
+
+        Stack<Item> copy(stack);
+        ASSERT_EQ(alive, 16);
+        copy = std::move(stack);
+        ASSERT_EQ(alive, 8);
+        ASSERT_EQ(copy.size(), 8);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using CppADS::Array;
+using CppADS::ThreadPool;
+using CppADS::WaitGroup;
+
+static long long fib(ThreadPool& pool, int n)
+{
+    if (n < 12)
+        return (n < 2) ? n : fib(pool, n - 1) + fib(pool, n - 2);
+
+    long long left = 0;
+    WaitGroup group;
+    pool.submit(group, [&pool, &left, n]() { left = fib(pool, n - 1); });
+    long long right = fib(pool, n - 2);
+    pool.wait(group);
+    return left + right;
+}
+
+TEST(ThreadPoolTest, ConstructTest)
+{
+    ThreadPool pool(3);
+    ASSERT_EQ(pool.size(), 3);
+
+    ThreadPool default_pool;
+    ASSERT_GE(default_pool.size(), 1);
+}
+
+TEST(ThreadPoolTest, SubmitTest)
+{
+    std::atomic<int> counter { 0 };
+    {
+        ThreadPool pool(4);
+        WaitGroup group;
+        for (int i = 0; i < 1000; i++)
+            pool.submit(group, [&counter]() { counter++; });
+        pool.wait(group);
+        ASSERT_EQ(counter.load(), 1000);
+
+        // Tasks without group are finished before pool is destroyed
+        for (int i = 0; i < 1000; i++)
+            pool.submit([&counter]() { counter++; });
+    }
+    ASSERT_EQ(counter.load(), 2000);
+}
+
+TEST(ThreadPoolTest, ForkJoinTest)
+{
+    ThreadPool pool(4);
+    long long result = 0;
+    WaitGroup group;
+    pool.submit(group, [&pool, &result]() { result = fib(pool, 25); });
+    pool.wait(group);
+    ASSERT_EQ(result, 75025);
+
+    // Waiting from thread outside the pool
+    ASSERT_EQ(fib(pool, 20), 6765);
+}
+
+TEST(ThreadPoolTest, ParallelForTest)
+{
+    ThreadPool pool(4);
+
+    std::vector<std::atomic<int>> visits(10000);
+    pool.parallel_for(0, visits.size(), [&visits](size_t i) { visits[i]++; });
+    for (auto& count : visits)
+        ASSERT_EQ(count.load(), 1);
+
+    Array<int> array;
+    for (int i = 0; i < 1000; i++)
+        array.push_back(i);
+    pool.parallel_for(array, 100, 900, [](int& value) { value *= 2; }, 16);
+    for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(array[i], (i >= 100 && i < 900) ? 2 * i : i);
+
+    ASSERT_THROW(pool.parallel_for(array, 0, 1001, [](int&) {}), std::out_of_range);
+}
+
+TEST(ThreadPoolTest, ExceptionTest)
+{
+    ThreadPool pool(2);
+    std::atomic<int> counter { 0 };
+
+    WaitGroup group;
+    for (int i = 0; i < 10; i++)
+    {
+        pool.submit(group, [&counter, i]() {
+            counter++;
+            if (i % 3 == 0)
+                throw std::runtime_error("task failed");
+        });
+    }
+    ASSERT_THROW(pool.wait(group), std::runtime_error);
+    ASSERT_EQ(counter.load(), 10);
+    // Exception is reported once
+    pool.wait(group);
+
+    // Exceptions of tasks without group don't stop workers
+    pool.submit([]() { throw std::runtime_error("ignored"); });
+    ASSERT_THROW(pool.parallel_for(0, 100, [&counter](size_t index) {
+        if (index == 42)
+            throw std::out_of_range("index");
+        counter++;
+    }, 10), std::out_of_range);
+    // Only the rest of the failed chunk [40, 50) is skipped
+    ASSERT_EQ(counter.load(), 10 + 100 - 8);
+
+    // Nested wait inside a worker rethrows too
+    WaitGroup outer;
+    std::atomic<bool> caught { false };
+    pool.submit(outer, [&pool, &caught]() {
+        WaitGroup inner;
+        pool.submit(inner, []() { throw std::logic_error("inner"); });
+        try
+        {
+            pool.wait(inner);
+        }
+        catch (const std::logic_error&)
+        {
+            caught = true;
+        }
+    });
+    pool.wait(outer);
+    ASSERT_TRUE(caught.load());
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
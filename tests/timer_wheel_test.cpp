@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "timer_wheel.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using CppADS::TimerWheel;
+
+TEST(TimerWheelTest, ConstructTest)
+{
+    TimerWheel<int> wheel;
+    ASSERT_EQ(wheel.size(), 0);
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(wheel.now(), 0);
+
+    TimerWheel<int> started(1000);
+    ASSERT_EQ(started.now(), 1000);
+    ASSERT_FALSE(started.contains(0));
+    ASSERT_FALSE(started.cancel(0));
+}
+
+TEST(TimerWheelTest, ScheduleTest)
+{
+    TimerWheel<std::string> wheel;
+    auto first = wheel.schedule(10, "first");
+    std::string value = "second";
+    auto second = wheel.schedule(3, value);
+    wheel.schedule(0, "next");
+    ASSERT_EQ(wheel.size(), 3);
+    ASSERT_EQ(wheel.get(first), "first");
+    ASSERT_EQ(wheel.expiry(second), 3);
+
+    std::vector<std::string> fired;
+    ASSERT_EQ(wheel.expire(2, std::back_inserter(fired)), 1);
+    ASSERT_EQ(fired, (std::vector<std::string> {"next"}));
+    ASSERT_EQ(wheel.expire(8, std::back_inserter(fired)), 2);
+    ASSERT_EQ(fired, (std::vector<std::string> {"next", "second", "first"}));
+    ASSERT_EQ(wheel.now(), 10);
+    ASSERT_TRUE(wheel.empty());
+
+    // Ids of fired timers are outdated
+    ASSERT_FALSE(wheel.contains(first));
+    ASSERT_THROW(wheel.get(first), std::out_of_range);
+}
+
+TEST(TimerWheelTest, CancelTest)
+{
+    TimerWheel<int> wheel;
+    auto kept = wheel.schedule(300, 1);
+    auto cancelled = wheel.schedule(300, 2);
+    ASSERT_TRUE(wheel.cancel(cancelled));
+    ASSERT_FALSE(wheel.cancel(cancelled));
+
+    // Slot of cancelled timer is reused with a new generation
+    auto reused = wheel.schedule(5, 3);
+    ASSERT_NE(reused, cancelled);
+    ASSERT_FALSE(wheel.contains(cancelled));
+    ASSERT_TRUE(wheel.contains(reused));
+
+    std::vector<int> fired;
+    wheel.advance(400, [&fired](int value) { fired.push_back(value); });
+    ASSERT_EQ(fired, (std::vector<int> {3, 1}));
+    ASSERT_FALSE(wheel.contains(kept));
+    wheel.clear();
+}
+
+TEST(TimerWheelTest, CallbackTest)
+{
+    TimerWheel<int> wheel;
+    std::vector<uint64_t> fired_at;
+    TimerWheel<int>::timer_id victim = wheel.schedule(20, -1);
+    wheel.schedule(10, 0);
+
+    // Callback reschedules periodic timer and cancels another one
+    size_t expired = wheel.advance(100, [&](int round) {
+        fired_at.push_back(wheel.now());
+        wheel.cancel(victim);
+        if (round < 4)
+            wheel.schedule(10, round + 1);
+    });
+    ASSERT_EQ(expired, 5);
+    ASSERT_EQ(fired_at, (std::vector<uint64_t> {10, 20, 30, 40, 50}));
+}
+
+TEST(TimerWheelTest, LevelsTest)
+{
+    TimerWheel<uint64_t> wheel(123);
+    std::vector<uint64_t> delays {1, 255, 256, 257, 65535, 65536, 65537, 1u << 24, (1u << 24) + 1, 70000000};
+    for (uint64_t delay : delays)
+        wheel.schedule(delay, wheel.now() + delay);
+
+    std::vector<uint64_t> fired_at;
+    wheel.advance(80000000, [&](uint64_t expected) {
+        ASSERT_EQ(wheel.now(), expected);
+        fired_at.push_back(expected);
+    });
+    ASSERT_EQ(fired_at.size(), delays.size());
+
+    // Timers beyond the horizon wait in the farthest slot
+    wheel.schedule((uint64_t(1) << 33) + 5, 7);
+    wheel.clear();
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, RandomTest)
+{
+    std::mt19937 random(3);
+    TimerWheel<int> wheel;
+    std::map<TimerWheel<int>::timer_id, uint64_t> pending;
+    std::vector<TimerWheel<int>::timer_id> ids;
+
+    for (int round = 0; round < 2000; round++)
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            uint64_t delay = random() % ((round % 10 == 0) ? 200000 : 1000);
+            auto id = wheel.schedule(delay, 0);
+            pending[id] = wheel.now() + (delay == 0 ? 1 : delay);
+            ids.push_back(id);
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            auto id = ids[random() % ids.size()];
+            ASSERT_EQ(wheel.cancel(id), pending.erase(id) == 1);
+        }
+
+        uint64_t step = random() % 300;
+        uint64_t until = wheel.now() + step;
+        size_t due = 0;
+        for (const auto& item : pending)
+            due += item.second <= until;
+        ASSERT_EQ(wheel.advance(step, [](int) {}), due);
+        for (auto it = pending.begin(); it != pending.end();)
+            it = (it->second <= until) ? pending.erase(it) : std::next(it);
+        ASSERT_EQ(wheel.size(), pending.size());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "work_stealing_deque.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using CppADS::WorkStealingDeque;
+
+TEST(WorkStealingDequeTest, ConstructTest)
+{
+    WorkStealingDeque<int> deque(5);
+    ASSERT_EQ(deque.capacity(), 8);
+    ASSERT_EQ(deque.size(), 0);
+    ASSERT_TRUE(deque.empty());
+    ASSERT_THROW(WorkStealingDeque<int>(0), std::invalid_argument);
+}
+
+TEST(WorkStealingDequeTest, ModifyTest)
+{
+    WorkStealingDeque<int> deque(4);
+    for (int i = 0; i < 4; i++)
+        deque.push(i);
+    ASSERT_EQ(deque.size(), 4);
+
+    int value;
+    ASSERT_TRUE(deque.pop(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_TRUE(deque.steal(value));
+    ASSERT_EQ(value, 0);
+    ASSERT_TRUE(deque.steal(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(deque.pop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_FALSE(deque.pop(value));
+    ASSERT_FALSE(deque.steal(value));
+    ASSERT_TRUE(deque.empty());
+}
+
+TEST(WorkStealingDequeTest, GrowTest)
+{
+    WorkStealingDeque<int> deque(2);
+    int value;
+    deque.push(-1);
+    ASSERT_TRUE(deque.steal(value));
+
+    // Wrapped content is kept in order after growth
+    for (int i = 0; i < 100; i++)
+        deque.push(i);
+    ASSERT_GE(deque.capacity(), 100);
+    ASSERT_EQ(deque.size(), 100);
+
+    for (int i = 0; i < 50; i++)
+    {
+        ASSERT_TRUE(deque.steal(value));
+        ASSERT_EQ(value, i);
+    }
+    for (int i = 99; i >= 50; i--)
+    {
+        ASSERT_TRUE(deque.pop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(deque.pop(value));
+}
+
+TEST(WorkStealingDequeTest, ConcurrentTest)
+{
+    const int count = 200000;
+    const int thieves = 3;
+    WorkStealingDeque<int> deque(8);
+
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<bool> done { false };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; t++)
+    {
+        threads.emplace_back([&]() {
+            int value;
+            while (!done.load())
+            {
+                if (deque.steal(value))
+                    taken[value]++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    int value;
+    for (int i = 0; i < count; i++)
+    {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value))
+            taken[value]++;
+    }
+    while (deque.pop(value))
+        taken[value]++;
+    done.store(true);
+
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& counter : taken)
+        ASSERT_EQ(counter.load(), 1);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}